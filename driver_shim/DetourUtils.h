@@ -26,8 +26,74 @@
     ReturnType (*original_##FunctionName)(##__VA_ARGS__) = nullptr;                                                    \
     ReturnType hooked_##FunctionName(##__VA_ARGS__)
 
+// Groups any number of DetourMethodAttach()/DetourMethodDetach() calls into a single Detours transaction, so that
+// threads are only suspended and the trampolines only written once, no matter how many hooks are (un)installed.
+class DetourTransactionScope {
+  public:
+    DetourTransactionScope() : m_startTime(std::chrono::steady_clock::now()) {
+        DetourTransactionBegin();
+        DetourUpdateThread(GetCurrentThread());
+    }
+
+    ~DetourTransactionScope() {
+        Commit();
+    }
+
+    DetourTransactionScope(const DetourTransactionScope&) = delete;
+    DetourTransactionScope& operator=(const DetourTransactionScope&) = delete;
+
+    LONG Commit() {
+        if (!m_committed) {
+            m_committed = true;
+            m_result = DetourTransactionCommit();
+
+            // Detours restores the original pointers to the target functions upon detaching. Reset them so that a
+            // later attach (eg: after the driver is reloaded) is not mistaken for an already installed hook.
+            if (m_result == NO_ERROR) {
+                for (PVOID* original : m_detached) {
+                    *original = nullptr;
+                }
+            }
+            m_detached.clear();
+
+            m_duration = std::chrono::steady_clock::now() - m_startTime;
+        }
+        return m_result;
+    }
+
+    void RecordAttach() {
+        m_operations++;
+    }
+
+    void RecordDetach(PVOID* original) {
+        m_operations++;
+        m_detached.push_back(original);
+    }
+
+    uint32_t GetOperationCount() const {
+        return m_operations;
+    }
+
+    // Time spent between the beginning of the transaction and its commit, including the thread suspension.
+    std::chrono::microseconds GetDuration() const {
+        return std::chrono::duration_cast<std::chrono::microseconds>(m_duration);
+    }
+
+  private:
+    const std::chrono::steady_clock::time_point m_startTime;
+    std::chrono::steady_clock::duration m_duration{};
+    bool m_committed = false;
+    LONG m_result = NO_ERROR;
+    uint32_t m_operations = 0;
+    std::vector<PVOID*> m_detached;
+};
+
 template <class T, typename TMethod>
-void DetourMethodAttach(T* instance, unsigned int methodOffset, TMethod hooked, TMethod& original) {
+void DetourMethodAttach(DetourTransactionScope& transaction,
+                        T* instance,
+                        unsigned int methodOffset,
+                        TMethod hooked,
+                        TMethod& original) {
     if (original) {
         // Already hooked.
         return;
@@ -36,11 +102,18 @@ void DetourMethodAttach(T* instance, unsigned int methodOffset, TMethod hooked,
     LPVOID* vtable = *((LPVOID**)instance);
     LPVOID target = vtable[methodOffset];
 
-    DetourTransactionBegin();
-    DetourUpdateThread(GetCurrentThread());
-
     original = (TMethod)target;
     DetourAttach((PVOID*)&original, hooked);
+    transaction.RecordAttach();
+}
+
+template <typename TMethod>
+void DetourMethodDetach(DetourTransactionScope& transaction, TMethod hooked, TMethod& original) {
+    if (!original) {
+        // Not hooked.
+        return;
+    }
 
-    DetourTransactionCommit();
+    DetourDetach((PVOID*)&original, hooked);
+    transaction.RecordDetach((PVOID*)&original);
 }
@@ -0,0 +1,145 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "DeviceRegistry.h"
+#include "StartupTimeline.h"
+#include "Tracing.h"
+
+namespace driver_shim {
+
+    PvrSession::PvrSession(pvrEnvHandle pvr, pvrSessionHandle pvrSession) : m_pvr(pvr), m_pvrSession(pvrSession) {
+    }
+
+    PvrSession::~PvrSession() {
+        TraceLoggingWrite(TraceProvider, "PvrSession_Destroy", TLPArg(m_pvrSession, "Session"));
+
+        pvr_destroySession(m_pvrSession);
+        pvr_shutdown(m_pvr);
+    }
+
+    std::shared_ptr<PvrSession> DeviceRegistry::AcquireSession(pvrResult* result) {
+        TraceLocalActivity(local);
+        TraceLoggingWriteStart(local, "DeviceRegistry_AcquireSession");
+
+        std::unique_lock lock(m_writeMutex);
+
+        std::shared_ptr<PvrSession> session = m_session.lock();
+        if (!session) {
+            pvrEnvHandle pvr = nullptr;
+            pvrResult status;
+            {
+                StartupStep step("pvr_initialise");
+                status = pvr_initialise(&pvr);
+            }
+            if (status != pvr_success) {
+                TraceLoggingWriteTagged(
+                    local, "DeviceRegistry_AcquireSession_PvrInitError", TLArg((int)status, "Error"));
+            } else {
+                pvrSessionHandle pvrSession = nullptr;
+                {
+                    StartupStep step("pvr_createSession");
+                    status = pvr_createSession(pvr, &pvrSession);
+                }
+                if (status != pvr_success) {
+                    TraceLoggingWriteTagged(
+                        local, "DeviceRegistry_AcquireSession_PvrCreateError", TLArg((int)status, "Error"));
+                    pvr_shutdown(pvr);
+                } else {
+                    session = std::make_shared<PvrSession>(pvr, pvrSession);
+                    m_session = session;
+                }
+            }
+
+            if (result) {
+                *result = status;
+            }
+        } else if (result) {
+            *result = pvr_success;
+        }
+
+        TraceLoggingWriteStop(local,
+                              "DeviceRegistry_AcquireSession",
+                              TLPArg(session ? session->GetSession() : nullptr, "Session"),
+                              TLArg(session.use_count(), "References"));
+
+        return session;
+    }
+
+    void DeviceRegistry::Register(const DeviceEntry& entry) {
+        TraceLoggingWrite(TraceProvider,
+                          "DeviceRegistry_Register",
+                          TLArg(entry.serialNumber.c_str(), "DeviceSerialNumber"),
+                          TLArg((int)entry.deviceClass, "DeviceClass"),
+                          TLPArg(entry.driver, "Driver"));
+
+        std::unique_lock lock(m_writeMutex);
+
+        auto snapshot = std::make_shared<DeviceMap>(*GetSnapshot());
+        (*snapshot)[entry.serialNumber] = std::make_shared<const DeviceEntry>(entry);
+        PublishSnapshot(std::move(snapshot));
+    }
+
+    void DeviceRegistry::Unregister(const std::string& serialNumber) {
+        TraceLoggingWrite(
+            TraceProvider, "DeviceRegistry_Unregister", TLArg(serialNumber.c_str(), "DeviceSerialNumber"));
+
+        std::unique_lock lock(m_writeMutex);
+
+        auto snapshot = std::make_shared<DeviceMap>(*GetSnapshot());
+        snapshot->erase(serialNumber);
+        PublishSnapshot(std::move(snapshot));
+    }
+
+    void DeviceRegistry::Clear() {
+        TraceLoggingWrite(TraceProvider, "DeviceRegistry_Clear");
+
+        std::unique_lock lock(m_writeMutex);
+
+        PublishSnapshot(std::make_shared<DeviceMap>());
+    }
+
+    std::vector<std::shared_ptr<const DeviceEntry>> DeviceRegistry::GetDevices() const {
+        const auto snapshot = GetSnapshot();
+        std::vector<std::shared_ptr<const DeviceEntry>> devices;
+        devices.reserve(snapshot->size());
+        for (const auto& [serialNumber, entry] : *snapshot) {
+            devices.push_back(entry);
+        }
+        return devices;
+    }
+
+    std::shared_ptr<const DeviceRegistry::DeviceMap> DeviceRegistry::GetSnapshot() const {
+        return std::atomic_load(&m_snapshot);
+    }
+
+    void DeviceRegistry::PublishSnapshot(std::shared_ptr<const DeviceMap> snapshot) {
+        std::atomic_store(&m_snapshot, std::move(snapshot));
+    }
+
+    DeviceRegistry& GetDeviceRegistry() {
+        static DeviceRegistry registry;
+        return registry;
+    }
+
+} // namespace driver_shim
@@ -0,0 +1,100 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "EyeTrackerSource.h"
+
+namespace driver_shim {
+
+    // A PVR environment and session, shared by reference counting between the driver and every device using it. The
+    // session is torn down when the last reference is released.
+    class PvrSession {
+      public:
+        PvrSession(pvrEnvHandle pvr, pvrSessionHandle pvrSession);
+        ~PvrSession();
+
+        PvrSession(const PvrSession&) = delete;
+        PvrSession& operator=(const PvrSession&) = delete;
+
+        pvrEnvHandle GetEnv() const {
+            return m_pvr;
+        }
+
+        pvrSessionHandle GetSession() const {
+            return m_pvrSession;
+        }
+
+      private:
+        const pvrEnvHandle m_pvr;
+        const pvrSessionHandle m_pvrSession;
+    };
+
+    std::shared_ptr<EyeTrackerSource> CreatePvrEyeTrackerSource(std::shared_ptr<PvrSession> pvrSession);
+
+    // Create the source selected in the settings. Returns nullptr if it cannot be created.
+    std::shared_ptr<EyeTrackerSource> CreateEyeTrackerSource();
+
+    // What the registry knows about a device that was shimmed.
+    struct DeviceEntry {
+        std::string serialNumber;
+        vr::ETrackedDeviceClass deviceClass = vr::TrackedDeviceClass_Invalid;
+        vr::ITrackedDeviceServerDriver* driver = nullptr;
+        std::shared_ptr<EyeTrackerSource> trackerSource;
+    };
+
+    // The DeviceRegistry maps each shimmed device to the eye tracker source feeding it.
+    //
+    // Registration and lookups may happen from any thread. Writers are serialized and publish an immutable snapshot of
+    // the whole map, so that readers never take a lock. The per-sample path does not even go through the registry: each
+    // device holds its own reference on its source.
+    class DeviceRegistry {
+      public:
+        // Return the PVR session currently in use, or create one if there is none. Returns nullptr on failure, with
+        // the PVR error in result.
+        std::shared_ptr<PvrSession> AcquireSession(pvrResult* result = nullptr);
+
+        void Register(const DeviceEntry& entry);
+        void Unregister(const std::string& serialNumber);
+        void Clear();
+
+        std::vector<std::shared_ptr<const DeviceEntry>> GetDevices() const;
+
+      private:
+        using DeviceMap = std::map<std::string, std::shared_ptr<const DeviceEntry>>;
+
+        std::shared_ptr<const DeviceMap> GetSnapshot() const;
+        void PublishSnapshot(std::shared_ptr<const DeviceMap> snapshot);
+
+        mutable std::mutex m_writeMutex;
+        std::shared_ptr<const DeviceMap> m_snapshot = std::make_shared<DeviceMap>();
+        std::weak_ptr<PvrSession> m_session;
+    };
+
+    DeviceRegistry& GetDeviceRegistry();
+
+} // namespace driver_shim
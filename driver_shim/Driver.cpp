@@ -22,7 +22,14 @@
 
 #include "pch.h"
 
+#include "Clock.h"
+#include "DeviceRegistry.h"
+#include "DriverSettings.h"
+#include "HealthMonitor.h"
+#include "Platform.h"
+#include "PrewarmedThread.h"
 #include "ShimDriverManager.h"
+#include "StartupTimeline.h"
 #include "DetourUtils.h"
 #include "Tracing.h"
 
@@ -49,27 +56,32 @@ namespace {
         vr::EVRInitError Init(vr::IVRDriverContext* pDriverContext) override {
             TraceLocalActivity(local);
             TraceLoggingWriteStart(local, "Driver_Init");
+            StartupStep step("Driver::Init");
 
             VR_INIT_SERVER_DRIVER_CONTEXT(pDriverContext);
+            SetLogSink([](const char* message) { DriverLog("%s", message); });
+
+            LoadDriverSettings();
+            if (!m_isLoaded) {
+                SetVirtualTime(GetDriverSettings().virtualTime);
+            }
 
             // Detect whether we should attempt to shim the target driver.
             if (!m_isLoaded) {
                 bool loadDriver = false;
                 try {
-                    pvrResult result = pvr_initialise(&m_pvr);
-                    if (result != pvr_success) {
-                        TraceLoggingWriteTagged(local, "Driver_Init_PvrInitError", TLArg((int)result, "Error"));
-                        throw EyeTrackerNotSupportedException();
-                    }
-
-                    result = pvr_createSession(m_pvr, &m_pvrSession);
-                    if (result != pvr_success) {
-                        TraceLoggingWriteTagged(local, "Driver_Init_PvrCreateError", TLArg((int)result, "Error"));
+                    pvrResult result = pvr_success;
+                    m_pvrSession = GetDeviceRegistry().AcquireSession(&result);
+                    if (!m_pvrSession) {
+                        TraceLoggingWriteTagged(local, "Driver_Init_PvrSessionError", TLArg((int)result, "Error"));
                         throw EyeTrackerNotSupportedException();
                     }
 
                     pvrHmdInfo info{};
-                    result = pvr_getHmdInfo(m_pvrSession, &info);
+                    {
+                        StartupStep step("pvr_getHmdInfo");
+                        result = pvr_getHmdInfo(m_pvrSession->GetSession(), &info);
+                    }
                     if (result != pvr_success) {
                         TraceLoggingWriteTagged(local, "Driver_Init_HmdInfoError", TLArg((int)result, "Error"));
                         throw EyeTrackerNotSupportedException();
@@ -92,7 +104,18 @@ namespace {
 
                 if (loadDriver) {
                     DriverLog("Installing IVRServerDriverHost::TrackedDeviceAdded hook");
-                    InstallShimDriverHook(m_pvr, m_pvrSession);
+                    InstallShimDriverHook();
+
+                    // Have the update thread ready before the HMD is even registered.
+                    {
+                        StartupStep step("PrewarmThreads");
+                        PrewarmThreads(1);
+                    }
+
+                    if (GetDriverSettings().healthMonitorInterval > 0) {
+                        GetHealthMonitor().Start(GetDriverSettings().healthMonitorInterval);
+                    }
+
                     m_isLoaded = true;
                 }
             }
@@ -103,10 +126,31 @@ namespace {
         }
 
         void Cleanup() override {
+            TraceLocalActivity(local);
+            TraceLoggingWriteStart(local, "Driver_Cleanup");
+
+            if (m_isLoaded) {
+                DriverLog("Uninstalling IVRServerDriverHost::TrackedDeviceAdded hook");
+                UninstallShimDriverHook();
+
+                // vrserver deactivated the devices already. Destroying ours releases their eye tracker sources, and
+                // with them the last references on the PVR session.
+                for (const auto& device : GetDeviceRegistry().GetDevices()) {
+                    GetDeviceRegistry().Unregister(device->serialNumber);
+                    DestroyHmdShimDriver(device->driver);
+                }
+                ReleasePrewarmedThreads();
+                GetHealthMonitor().Stop();
+                m_isLoaded = false;
+            }
+
+            SetLogSink(nullptr);
             VR_CLEANUP_SERVER_DRIVER_CONTEXT();
 
-            pvr_destroySession(m_pvrSession);
-            pvr_shutdown(m_pvr);
+            GetDeviceRegistry().Clear();
+            m_pvrSession.reset();
+
+            TraceLoggingWriteStop(local, "Driver_Cleanup");
         }
 
         const char* const* GetInterfaceVersions() override {
@@ -124,13 +168,13 @@ namespace {
         void LeaveStandby() override {};
 
         bool m_isLoaded = false;
-        pvrEnvHandle m_pvr = nullptr;
-        pvrSessionHandle m_pvrSession = nullptr;
+        std::shared_ptr<PvrSession> m_pvrSession;
     };
 } // namespace
 
 // Entry point for vrserver.
 extern "C" __declspec(dllexport) void* HmdDriverFactory(const char* pInterfaceName, int* pReturnCode) {
+    StartupStep step("HmdDriverFactory");
     if (strcmp(vr::IServerTrackedDeviceProvider_Version, pInterfaceName) == 0) {
         if (!thisDriver) {
             thisDriver = std::make_unique<Driver>();
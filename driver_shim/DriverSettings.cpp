@@ -0,0 +1,131 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "DriverSettings.h"
+#include "Tracing.h"
+
+namespace {
+    using namespace driver_shim;
+
+    DriverSettings g_settings;
+
+    std::string GetString(const char* key, const std::string& defaultValue) {
+        char buffer[MAX_PATH]{};
+        vr::EVRSettingsError error = vr::VRSettingsError_None;
+        vr::VRSettings()->GetString(k_SettingsSection, key, buffer, sizeof(buffer), &error);
+        return error == vr::VRSettingsError_None ? buffer : defaultValue;
+    }
+
+    bool GetBool(const char* key, bool defaultValue) {
+        vr::EVRSettingsError error = vr::VRSettingsError_None;
+        const bool value = vr::VRSettings()->GetBool(k_SettingsSection, key, &error);
+        return error == vr::VRSettingsError_None ? value : defaultValue;
+    }
+
+    int32_t GetInt32(const char* key, int32_t defaultValue) {
+        vr::EVRSettingsError error = vr::VRSettingsError_None;
+        const int32_t value = vr::VRSettings()->GetInt32(k_SettingsSection, key, &error);
+        return error == vr::VRSettingsError_None ? value : defaultValue;
+    }
+
+    float GetFloat(const char* key, float defaultValue) {
+        vr::EVRSettingsError error = vr::VRSettingsError_None;
+        const float value = vr::VRSettings()->GetFloat(k_SettingsSection, key, &error);
+        return error == vr::VRSettingsError_None ? value : defaultValue;
+    }
+
+} // namespace
+
+namespace driver_shim {
+
+    void LoadDriverSettings() {
+        TraceLocalActivity(local);
+        TraceLoggingWriteStart(local, "LoadDriverSettings");
+
+        DriverSettings settings;
+        settings.trackerSource = GetString("trackerSource", settings.trackerSource);
+        settings.replayFile = GetString("replayFile", settings.replayFile);
+        settings.replayLoop = GetBool("replayLoop", settings.replayLoop);
+        settings.recordFile = GetString("recordFile", settings.recordFile);
+        settings.deadbandAngle = GetFloat("deadbandAngle", settings.deadbandAngle);
+        settings.deadbandKeepAliveMs = GetInt32("deadbandKeepAliveMs", settings.deadbandKeepAliveMs);
+        settings.medianFilterWindow = GetInt32("medianFilterWindow", settings.medianFilterWindow);
+        settings.gazeDerivatives = GetBool("gazeDerivatives", settings.gazeDerivatives);
+        settings.gazeEvents = GetBool("gazeEvents", settings.gazeEvents);
+        settings.fixationDetector = GetBool("fixationDetector", settings.fixationDetector);
+        settings.fixationDispersion = GetFloat("fixationDispersion", settings.fixationDispersion);
+        settings.fixationMinDurationMs = GetInt32("fixationMinDurationMs", settings.fixationMinDurationMs);
+        settings.heatmapFile = GetString("heatmapFile", settings.heatmapFile);
+        settings.heatmapHalfLife = GetFloat("heatmapHalfLife", settings.heatmapHalfLife);
+        settings.gazeRegionsFile = GetString("gazeRegionsFile", settings.gazeRegionsFile);
+        settings.sceneProxy = GetBool("sceneProxy", settings.sceneProxy);
+        settings.plugins = GetString("plugins", settings.plugins);
+        settings.pluginBudgetUs = GetInt32("pluginBudgetUs", settings.pluginBudgetUs);
+        settings.healthMonitorInterval = GetInt32("healthMonitorInterval", settings.healthMonitorInterval);
+        settings.virtualTime = GetBool("virtualTime", settings.virtualTime);
+        settings.largePages = GetBool("largePages", settings.largePages);
+        settings.sessionStoreMinutes = GetInt32("sessionStoreMinutes", settings.sessionStoreMinutes);
+        settings.shadowPipeline = GetString("shadowPipeline", settings.shadowPipeline);
+        settings.shadowRecordFile = GetString("shadowRecordFile", settings.shadowRecordFile);
+        settings.gazeExport = GetBool("gazeExport", settings.gazeExport);
+        settings.demandDrivenRate = GetBool("demandDrivenRate", settings.demandDrivenRate);
+        settings.idlePollPeriodMs = GetInt32("idlePollPeriodMs", settings.idlePollPeriodMs);
+        g_settings = settings;
+
+        TraceLoggingWriteStop(local,
+                              "LoadDriverSettings",
+                              TLArg(g_settings.trackerSource.c_str(), "TrackerSource"),
+                              TLArg(g_settings.replayFile.c_str(), "ReplayFile"),
+                              TLArg(g_settings.replayLoop, "ReplayLoop"),
+                              TLArg(g_settings.recordFile.c_str(), "RecordFile"),
+                              TLArg(g_settings.deadbandAngle, "DeadbandAngle"),
+                              TLArg(g_settings.deadbandKeepAliveMs, "DeadbandKeepAliveMs"),
+                              TLArg(g_settings.medianFilterWindow, "MedianFilterWindow"),
+                              TLArg(g_settings.gazeDerivatives, "GazeDerivatives"),
+                              TLArg(g_settings.gazeEvents, "GazeEvents"),
+                              TLArg(g_settings.fixationDetector, "FixationDetector"),
+                              TLArg(g_settings.fixationDispersion, "FixationDispersion"),
+                              TLArg(g_settings.fixationMinDurationMs, "FixationMinDurationMs"),
+                              TLArg(g_settings.heatmapFile.c_str(), "HeatmapFile"),
+                              TLArg(g_settings.heatmapHalfLife, "HeatmapHalfLife"),
+                              TLArg(g_settings.gazeRegionsFile.c_str(), "GazeRegionsFile"),
+                              TLArg(g_settings.sceneProxy, "SceneProxy"),
+                              TLArg(g_settings.plugins.c_str(), "Plugins"),
+                              TLArg(g_settings.pluginBudgetUs, "PluginBudgetUs"),
+                              TLArg(g_settings.healthMonitorInterval, "HealthMonitorInterval"),
+                              TLArg(g_settings.virtualTime, "VirtualTime"),
+                              TLArg(g_settings.largePages, "LargePages"),
+                              TLArg(g_settings.sessionStoreMinutes, "SessionStoreMinutes"),
+                              TLArg(g_settings.shadowPipeline.c_str(), "ShadowPipeline"),
+                              TLArg(g_settings.shadowRecordFile.c_str(), "ShadowRecordFile"),
+                              TLArg(g_settings.gazeExport, "GazeExport"),
+                              TLArg(g_settings.demandDrivenRate, "DemandDrivenRate"),
+                              TLArg(g_settings.idlePollPeriodMs, "IdlePollPeriodMs"));
+    }
+
+    const DriverSettings& GetDriverSettings() {
+        return g_settings;
+    }
+
+} // namespace driver_shim
@@ -0,0 +1,60 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <string>
+
+#include "GazeSettings.h"
+
+namespace driver_shim {
+
+    // The section of steamvr.vrsettings holding our settings. Defaults are in resources/settings/default.vrsettings.
+    constexpr const char* k_SettingsSection = "driver_PimaxEyeTracking";
+
+    // The processing settings (see GazeSettings), and those of the driver itself.
+    struct DriverSettings : GazeSettings {
+        // Which EyeTrackerSource feeds the shimmed HMD: "pvr", "replay" or "synthetic".
+        std::string trackerSource = "pvr";
+
+        // Recording to play back when trackerSource is "replay", and whether to loop it.
+        std::string replayFile;
+        bool replayLoop = true;
+
+        // Cast the gaze against the scene proxy supplied by applications (see GazeSceneProxy.h).
+        bool sceneProxy = false;
+
+        // Interval (seconds) at which the resources of vrserver and the health of the update loop are sampled, to
+        // warn about leaks and drifts in the SteamVR log (see HealthMonitor). 0 disables the monitoring.
+        int32_t healthMonitorInterval = 0;
+
+        // Run every scheduler of the driver on a virtual clock that only moves with the "advance_time <seconds>" debug
+        // request, for reproducible simulations with the replay and synthetic sources (see VirtualClock).
+        bool virtualTime = false;
+    };
+
+    // Read the settings from SteamVR. Must be called after the driver context is initialized.
+    void LoadDriverSettings();
+
+    const DriverSettings& GetDriverSettings();
+
+} // namespace driver_shim
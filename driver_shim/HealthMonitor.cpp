@@ -0,0 +1,262 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "pch.h"
+
+#include "Clock.h"
+#include "HealthMonitor.h"
+#include "Tracing.h"
+
+namespace {
+
+    using namespace driver_shim;
+
+    struct MetricInfo {
+        const char* name;
+        bool isChecked;
+        bool isTwoSided;
+        double tolerance;
+    };
+
+    // The tolerances absorb the usual fluctuations (heap growth, thread pools, handles opened by other drivers).
+    constexpr MetricInfo k_Metrics[HealthMonitor::MetricCount] = {
+        {"WorkingSet", true, false, 16.0 * 1024 * 1024},
+        {"PrivateBytes", true, false, 16.0 * 1024 * 1024},
+        {"HandleCount", true, false, 100.0},
+        {"ThreadCount", true, false, 8.0},
+        {"UpdateRate", false, false, 0.0},
+        {"DroppedSamples", true, false, 50.0},
+        {"ClockOffset", true, true, 0.005},
+    };
+
+    constexpr size_t k_QuarterSize = HealthMonitor::k_WindowSize / 4;
+
+    size_t CountThreads() {
+        const HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+        if (snapshot == INVALID_HANDLE_VALUE) {
+            return 0;
+        }
+
+        const DWORD processId = GetCurrentProcessId();
+        size_t count = 0;
+        THREADENTRY32 entry{};
+        entry.dwSize = sizeof(entry);
+        for (BOOL hasEntry = Thread32First(snapshot, &entry); hasEntry; hasEntry = Thread32Next(snapshot, &entry)) {
+            if (entry.th32OwnerProcessID == processId) {
+                count++;
+            }
+        }
+        CloseHandle(snapshot);
+        return count;
+    }
+
+} // namespace
+
+namespace driver_shim {
+
+    HealthMonitor::HealthMonitor() : m_windows(MetricCount, FixedRing<double>(k_WindowSize)) {
+    }
+
+    HealthMonitor::~HealthMonitor() {
+        Stop();
+    }
+
+    void HealthMonitor::Start(double intervalInSeconds) {
+        Stop();
+
+        {
+            std::unique_lock lock(m_mutex);
+            for (auto& window : m_windows) {
+                window.Clear();
+            }
+            std::fill(std::begin(m_isDrifting), std::end(m_isDrifting), false);
+            m_lastUpdateCount = m_updateCount.load();
+            m_lastDroppedCount = m_droppedCount.load();
+        }
+
+        m_stop = false;
+        m_thread = std::thread(&HealthMonitor::MonitorThread, this, intervalInSeconds);
+    }
+
+    void HealthMonitor::Stop() {
+        if (!m_thread.joinable()) {
+            return;
+        }
+
+        {
+            std::unique_lock lock(m_stopMutex);
+            m_stop = true;
+        }
+        m_stopCondition.notify_all();
+        m_thread.join();
+    }
+
+    void HealthMonitor::RecordUpdate(double sampleTimeInSeconds) {
+        m_updateCount.fetch_add(1, std::memory_order_relaxed);
+        m_clockOffset.store(GetClock().Now() - sampleTimeInSeconds, std::memory_order_relaxed);
+        m_hasClockOffset.store(true, std::memory_order_relaxed);
+    }
+
+    void HealthMonitor::RecordDroppedSample() {
+        m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void HealthMonitor::ResetClockOffset() {
+        m_hasClockOffset = false;
+        m_resetClockOffset = true;
+    }
+
+    void HealthMonitor::GetLatest(double (&values)[MetricCount]) const {
+        std::unique_lock lock(m_mutex);
+        std::copy(std::begin(m_latest), std::end(m_latest), values);
+    }
+
+    const char* HealthMonitor::GetMetricName(Metric metric) {
+        return k_Metrics[metric].name;
+    }
+
+    void HealthMonitor::MonitorThread(double intervalInSeconds) {
+        TraceLocalActivity(local);
+        TraceLoggingWriteStart(local, "HealthMonitor_MonitorThread");
+
+        SetThreadDescription(GetCurrentThread(), L"HealthMonitor_MonitorThread");
+
+        double lastTime = GetClock().Now();
+        std::unique_lock lock(m_stopMutex);
+        while (!GetClock().WaitFor(lock, m_stopCondition, intervalInSeconds, [&] { return m_stop; })) {
+            const double now = GetClock().Now();
+            Sample(now - lastTime);
+            lastTime = now;
+        }
+        GetClock().OnThreadExit();
+
+        TraceLoggingWriteStop(local, "HealthMonitor_MonitorThread");
+    }
+
+    void HealthMonitor::Sample(double elapsedInSeconds) {
+        double values[MetricCount]{};
+
+        PROCESS_MEMORY_COUNTERS_EX memory{};
+        if (GetProcessMemoryInfo(
+                GetCurrentProcess(), reinterpret_cast<PROCESS_MEMORY_COUNTERS*>(&memory), sizeof(memory))) {
+            values[WorkingSet] = (double)memory.WorkingSetSize;
+            values[PrivateBytes] = (double)memory.PrivateUsage;
+        }
+        DWORD handleCount = 0;
+        GetProcessHandleCount(GetCurrentProcess(), &handleCount);
+        values[HandleCount] = handleCount;
+        values[ThreadCount] = (double)CountThreads();
+
+        const uint64_t updateCount = m_updateCount.load(std::memory_order_relaxed);
+        const uint64_t droppedCount = m_droppedCount.load(std::memory_order_relaxed);
+        const bool hasClockOffset = m_hasClockOffset.load(std::memory_order_relaxed);
+        values[ClockOffset] = m_clockOffset.load(std::memory_order_relaxed);
+
+        std::unique_lock lock(m_mutex);
+
+        values[UpdateRate] = (updateCount - m_lastUpdateCount) / elapsedInSeconds;
+        values[DroppedSamples] = (double)(droppedCount - m_lastDroppedCount);
+        m_lastUpdateCount = updateCount;
+        m_lastDroppedCount = droppedCount;
+
+        if (m_resetClockOffset.exchange(false)) {
+            m_windows[ClockOffset].Clear();
+            m_isDrifting[ClockOffset] = false;
+        }
+
+        for (int i = 0; i < MetricCount; i++) {
+            const Metric metric = (Metric)i;
+            m_latest[metric] = values[metric];
+
+            // There is nothing to measure the clock against while no samples are coming.
+            if (metric == ClockOffset && !hasClockOffset) {
+                continue;
+            }
+
+            FixedRing<double>& window = m_windows[metric];
+            if (window.IsFull()) {
+                window.PopFront();
+            }
+            window.PushBack(values[metric]);
+            CheckDrift(metric);
+        }
+
+        TraceLoggingWrite(TraceProvider,
+                          "HealthMonitor_Sample",
+                          TLArg(values[WorkingSet], "WorkingSet"),
+                          TLArg(values[PrivateBytes], "PrivateBytes"),
+                          TLArg(values[HandleCount], "HandleCount"),
+                          TLArg(values[ThreadCount], "ThreadCount"),
+                          TLArg(values[UpdateRate], "UpdateRate"),
+                          TLArg(values[DroppedSamples], "DroppedSamples"),
+                          TLArg(values[ClockOffset], "ClockOffset"));
+    }
+
+    void HealthMonitor::CheckDrift(Metric metric) {
+        const MetricInfo& info = k_Metrics[metric];
+        const FixedRing<double>& window = m_windows[metric];
+        if (!info.isChecked || !window.IsFull()) {
+            return;
+        }
+
+        double oldestMin = window[0], oldestMax = window[0];
+        double recentMin = window[k_WindowSize - 1], recentMax = window[k_WindowSize - 1];
+        for (size_t i = 0; i < k_QuarterSize; i++) {
+            oldestMin = std::min(oldestMin, window[i]);
+            oldestMax = std::max(oldestMax, window[i]);
+            recentMin = std::min(recentMin, window[k_WindowSize - 1 - i]);
+            recentMax = std::max(recentMax, window[k_WindowSize - 1 - i]);
+        }
+
+        const bool isGrowing = recentMin - oldestMax > info.tolerance;
+        const bool isShrinking = info.isTwoSided && oldestMin - recentMax > info.tolerance;
+        const bool isDrifting = isGrowing || isShrinking;
+
+        // Only report the transitions, a leak would otherwise be reported at every sample.
+        if (isDrifting != m_isDrifting[metric]) {
+            m_isDrifting[metric] = isDrifting;
+            TraceLoggingWrite(TraceProvider,
+                              "HealthMonitor_Drift",
+                              TLArg(info.name, "Metric"),
+                              TLArg(isDrifting, "Drifting"),
+                              TLArg(window[0], "Oldest"),
+                              TLArg(window[k_WindowSize - 1], "Latest"));
+            if (isDrifting) {
+                DriverLog("Warning: %s keeps %s: %.6g -> %.6g over the last %zu samples",
+                          info.name,
+                          isGrowing ? "growing" : "decreasing",
+                          window[0],
+                          window[k_WindowSize - 1],
+                          k_WindowSize);
+            } else {
+                DriverLog("%s is stable again", info.name);
+            }
+        }
+    }
+
+    HealthMonitor& GetHealthMonitor() {
+        static HealthMonitor monitor;
+        return monitor;
+    }
+
+} // namespace driver_shim
@@ -0,0 +1,101 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "FixedRing.h"
+
+namespace driver_shim {
+
+    // Samples the resources held by vrserver (memory, handles, threads) and the health of the update loop at a fixed
+    // interval, and warns in the SteamVR log when one of them keeps drifting. Leaks only become visible after hours,
+    // so each metric is kept over a sliding window of k_WindowSize samples, and is reported when the lowest value of
+    // the most recent quarter of the window exceeds the highest value of the oldest quarter by more than a tolerance:
+    // it went up and never came back down.
+    class HealthMonitor {
+      public:
+        enum Metric {
+            WorkingSet,     // Bytes.
+            PrivateBytes,   // Bytes.
+            HandleCount,    // Handles opened by the process.
+            ThreadCount,    // Threads of the process.
+            UpdateRate,     // Samples received from the source per second.
+            DroppedSamples, // Samples pushed by the source and overwritten before the update thread took them.
+            ClockOffset,    // Seconds between the driver clock and the sample timestamps, drifting either way.
+            MetricCount
+        };
+
+        static constexpr size_t k_WindowSize = 60;
+
+        HealthMonitor();
+        ~HealthMonitor();
+
+        // Start sampling every intervalInSeconds, on a background thread.
+        void Start(double intervalInSeconds);
+        void Stop();
+
+        // Called from the update thread. These only touch atomics.
+        void RecordUpdate(double sampleTimeInSeconds);
+        void RecordDroppedSample();
+
+        // Forget the clock offset, when the sample timestamps legitimately jump (new session, replay restarted...).
+        void ResetClockOffset();
+
+        // The latest value of each metric (0 before the first sample).
+        void GetLatest(double (&values)[MetricCount]) const;
+
+        static const char* GetMetricName(Metric metric);
+
+      private:
+        void MonitorThread(double intervalInSeconds);
+        void Sample(double elapsedInSeconds);
+        void CheckDrift(Metric metric);
+
+        std::atomic<uint64_t> m_updateCount = 0;
+        std::atomic<uint64_t> m_droppedCount = 0;
+        std::atomic<double> m_clockOffset = 0.0;
+        std::atomic<bool> m_hasClockOffset = false;
+        std::atomic<bool> m_resetClockOffset = false;
+
+        mutable std::mutex m_mutex;
+        std::vector<FixedRing<double>> m_windows;
+        double m_latest[MetricCount]{};
+        bool m_isDrifting[MetricCount]{};
+        uint64_t m_lastUpdateCount = 0;
+        uint64_t m_lastDroppedCount = 0;
+
+        std::mutex m_stopMutex;
+        std::condition_variable m_stopCondition;
+        bool m_stop = false;
+        std::thread m_thread;
+    };
+
+    HealthMonitor& GetHealthMonitor();
+
+} // namespace driver_shim
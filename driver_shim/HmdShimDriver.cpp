@@ -1,28 +1,13 @@
-// MIT License
-//
-// Copyright(c) 2025 Matthieu Bucchianeri
-//
-// Permission is hereby granted, free of charge, to any person obtaining a copy
-// of this software and associated documentation files (the "Software"), to deal
-// in the Software without restriction, including without limitation the rights
-// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
-// copies of the Software, and to permit persons to whom the Software is
-// furnished to do so, subject to the following conditions:
-//
-// The above copyright notice and this permission notice shall be included in all
-// copies or substantial portions of the Software.
-//
-// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-// SOFTWARE.
-
 #include "pch.h"
 
+#include "DriverSettings.h"
+#include "GazeEvents.h"
+#include "GazeUpdateLoop.h"
+#include "HealthMonitor.h"
+#include "PrewarmedThread.h"
+#include "SceneProxyWatcher.h"
 #include "ShimDriverManager.h"
+#include "StartupTimeline.h"
 #include "DetourUtils.h"
 #include "Tracing.h"
 
@@ -35,15 +20,57 @@ namespace {
         }
     };
 
+    vr::HmdQuaternion_t Multiply(const vr::HmdQuaternion_t& a, const vr::HmdQuaternion_t& b) {
+        return {a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+                a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+                a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w};
+    }
+
+    void Rotate(const vr::HmdQuaternion_t& q, const float v[3], float result[3]) {
+        // v' = v + w * t + q x t, with t = 2 * (q x v).
+        const double tx = 2.0 * (q.y * v[2] - q.z * v[1]);
+        const double ty = 2.0 * (q.z * v[0] - q.x * v[2]);
+        const double tz = 2.0 * (q.x * v[1] - q.y * v[0]);
+        result[0] = (float)(v[0] + q.w * tx + q.y * tz - q.z * ty);
+        result[1] = (float)(v[1] + q.w * ty + q.z * tx - q.x * tz);
+        result[2] = (float)(v[2] + q.w * tz + q.x * ty - q.y * tx);
+    }
+
+    // Rotate a head-space direction into world space, using the pose of the headset.
+    void RotateToWorld(const vr::DriverPose_t& pose, const float direction[3], float result[3]) {
+        // The pose rotation is relative to the driver space.
+        Rotate(Multiply(pose.qWorldFromDriverRotation, pose.qRotation), direction, result);
+    }
+
+    void GetWorldPosition(const vr::DriverPose_t& pose, float result[3]) {
+        const float position[3] = {(float)pose.vecPosition[0], (float)pose.vecPosition[1], (float)pose.vecPosition[2]};
+        Rotate(pose.qWorldFromDriverRotation, position, result);
+        for (int axis = 0; axis < 3; axis++) {
+            result[axis] += (float)pose.vecWorldFromDriverTranslation[axis];
+        }
+    }
+
     // The HmdShimDriver driver wraps another ITrackedDeviceServerDriver instance with the intent to override
-    // properties and behaviors.
-    struct HmdShimDriver : public vr::ITrackedDeviceServerDriver {
-        HmdShimDriver(vr::ITrackedDeviceServerDriver* shimmedDevice, pvrEnvHandle pvr, pvrSessionHandle pvrSession)
-            : m_shimmedDevice(shimmedDevice), m_pvr(pvr), m_pvrSession(pvrSession) {
+    // properties and behaviors. The processing of the gaze is done by a GazeUpdateLoop, for which it publishes the gaze
+    // to the input component and the events of the device.
+    struct HmdShimDriver final : public vr::ITrackedDeviceServerDriver, public GazeUpdateLoop::Host {
+        // Farthest distance (meters) at which objects of the scene proxy are hit by the gaze.
+        static constexpr float k_MaxGazeDistance = 100.f;
+
+        HmdShimDriver(vr::ITrackedDeviceServerDriver* shimmedDevice, std::shared_ptr<EyeTrackerSource> trackerSource)
+            : m_shimmedDevice(shimmedDevice), m_loop(std::move(trackerSource), *this, GetDriverSettings()) {
             TraceLocalActivity(local);
             TraceLoggingWriteStart(local, "HmdShimDriver_Ctor");
+            StartupStep step("HmdShimDriver::HmdShimDriver");
+
+            // Prepare everything we can ahead of Activate(), so that it only needs to create the component and wake up
+            // the update thread.
+            m_updateThread = AcquirePrewarmedThread();
 
-            // TODO: Add any early initialization here if needed.
+            if (GetDriverSettings().sceneProxy) {
+                m_sceneProxy = std::make_unique<SceneProxyWatcher>();
+            }
 
             // TODO: Add capabilities detection (if not already done in Driver::Init() earlier) and throw
             // EyeTrackerNotSupportedException to skip shimming when capabilities are not available.
@@ -51,9 +78,15 @@ namespace {
             TraceLoggingWriteStop(local, "HmdShimDriver_Ctor");
         }
 
+        ~HmdShimDriver() {
+            // In case vrserver did not deactivate the device.
+            StopUpdateThread();
+        }
+
         vr::EVRInitError Activate(uint32_t unObjectId) override {
             TraceLocalActivity(local);
             TraceLoggingWriteStart(local, "HmdShimDriver_Activate", TLArg(unObjectId, "ObjectId"));
+            StartupStep step("HmdShimDriver::Activate");
 
             // Activate the real device driver.
             m_shimmedDevice->Activate(unObjectId);
@@ -73,9 +106,8 @@ namespace {
             DriverLog("Eye Gaze Component: %lld", m_eyeTrackingComponent);
 
             // Schedule updates in a background thread.
-            // TODO: Can use a callback instead of a thread here, if available.
-            m_active = true;
-            m_updateThread = std::thread(&HmdShimDriver::UpdateThread, this);
+            m_loop.Start();
+            m_updateThread->Run([this] { m_loop.Run(); });
 
             TraceLoggingWriteStop(local, "HmdShimDriver_Activate");
 
@@ -86,9 +118,7 @@ namespace {
             TraceLocalActivity(local);
             TraceLoggingWriteStart(local, "HmdShimDriver_Deactivate", TLArg(m_deviceIndex, "ObjectId"));
 
-            if (m_active.exchange(false)) {
-                m_updateThread.join();
-            }
+            StopUpdateThread();
 
             m_deviceIndex = vr::k_unTrackedDeviceIndexInvalid;
 
@@ -99,6 +129,12 @@ namespace {
             TraceLoggingWriteStop(local, "HmdShimDriver_Deactivate");
         }
 
+        void StopUpdateThread() {
+            if (m_loop.Stop()) {
+                m_updateThread->Wait();
+            }
+        }
+
         void EnterStandby() override {
             m_shimmedDevice->EnterStandby();
         }
@@ -112,102 +148,152 @@ namespace {
         }
 
         void DebugRequest(const char* pchRequest, char* pchResponseBuffer, uint32_t unResponseBufferSize) override {
+            // The requests about the gaze (see GazeUpdateLoop::HandleDebugRequest()).
+            std::string response;
+            if (m_loop.HandleDebugRequest(pchRequest, response)) {
+                snprintf(pchResponseBuffer, unResponseBufferSize, "%s", response.c_str());
+                return;
+            }
+
+            // "health" returns the latest values sampled by the health monitor.
+            if (!strcmp(pchRequest, "health")) {
+                double values[HealthMonitor::MetricCount];
+                GetHealthMonitor().GetLatest(values);
+                for (int i = 0; i < HealthMonitor::MetricCount; i++) {
+                    char buffer[64];
+                    snprintf(buffer,
+                             sizeof(buffer),
+                             "%s%s=%.6g",
+                             i ? " " : "",
+                             HealthMonitor::GetMetricName((HealthMonitor::Metric)i),
+                             values[i]);
+                    response += buffer;
+                }
+                snprintf(pchResponseBuffer, unResponseBufferSize, "%s", response.c_str());
+                return;
+            }
+
             m_shimmedDevice->DebugRequest(pchRequest, pchResponseBuffer, unResponseBufferSize);
         }
 
-        void UpdateThread() {
-            TraceLocalActivity(local);
-            TraceLoggingWriteStart(local, "HmdShimDriver_UpdateThread");
+        // GazeUpdateLoop::Host, called from the update thread.
 
-            DriverLog("Hello from HmdShimDriver::UpdateThread");
-            SetThreadDescription(GetCurrentThread(), L"HmdShimDriver_UpdateThread");
+        void Publish(bool isValid, const float direction[3]) override {
+            vr::VREyeTrackingData_t data{};
+            data.bValid = data.bTracked = data.bActive = isValid;
+            data.vGazeTarget = {direction[0], direction[1], direction[2]};
+            vr::VRDriverInput()->UpdateEyeTrackingComponent(m_eyeTrackingComponent, &data, 0.f);
+        }
 
-            const vr::PropertyContainerHandle_t container =
-                vr::VRProperties()->TrackedDeviceToPropertyContainer(m_deviceIndex);
+        // Deliver each event raised on the sample as a vendor-specific event on our device.
+        void PublishEvents(const GazeSample& gaze) override {
+            for (uint32_t index = 0; index < k_GazeEventCount; index++) {
+                const uint32_t type = 1u << index;
+                if (!(gaze.events & type)) {
+                    continue;
+                }
 
-            vr::VREyeTrackingData_t data{};
-            while (true) {
-                // Wait for the next time to update.
-                {
-                    TraceLocalActivity(sleep);
-                    TraceLoggingWriteStart(sleep, "HmdShimDriver_UpdateThread_Sleep");
+                GazeEventData payload{};
+                payload.version = k_GazeEventDataVersion;
+                payload.type = type;
+                payload.timeInSeconds = gaze.timeInSeconds;
+                const bool hasDuration = type == GazeEvent_FixationEnd || type == GazeEvent_Blink;
+                payload.duration = hasDuration ? gaze.eventDuration : 0.f;
+                payload.yaw = gaze.eventYaw;
+                payload.pitch = gaze.eventPitch;
+
+                vr::VREvent_Data_t data{};
+                memcpy(&data.reserved, &payload, sizeof(payload));
+
+                TraceLoggingWrite(TraceProvider,
+                                  "HmdShimDriver_GazeEvent",
+                                  TLArg(type, "Type"),
+                                  TLArg(payload.timeInSeconds, "TimeInSeconds"),
+                                  TLArg(payload.duration, "Duration"));
+                vr::VRServerDriverHost()->VendorSpecificEvent(
+                    m_deviceIndex, (vr::EVREventType)(k_GazeEventBase + index), data, 0.0);
+            }
+        }
+
+        // Rotate the gaze with the pose of the headset, and cast it against the scene proxy.
+        bool ProcessWorldGaze(const GazeSample& gaze, bool needsWorldDirection, float worldDirection[3]) override {
+            if (!needsWorldDirection && !m_sceneProxy) {
+                return false;
+            }
+            const vr::DriverPose_t pose = m_shimmedDevice->GetPose();
+            if (!pose.poseIsValid) {
+                return false;
+            }
+            RotateToWorld(pose, gaze.direction, worldDirection);
+            if (m_sceneProxy) {
+                CastGaze(gaze, pose, worldDirection);
+            }
+            return true;
+        }
 
-                    // We refresh the data at this frequency.
-                    // TODO: Use event-based sleep/wake up if appropriate.
-                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        void OnStart() override {
+            GetHealthMonitor().ResetClockOffset();
+        }
 
-                    TraceLoggingWriteStop(sleep, "HmdShimDriver_UpdateThread_Sleep", TLArg(m_active.load(), "Active"));
+        void OnSample(double timeInSeconds) override {
+            GetHealthMonitor().RecordUpdate(timeInSeconds);
+        }
 
-                    if (!m_active) {
-                        break;
-                    }
-                }
+        void OnDroppedSample() override {
+            GetHealthMonitor().RecordDroppedSample();
+        }
 
-                // Retrieve the data from the eye tracker and push it to the input component.
-                pvrEyeTrackingInfo state{};
-                pvrResult result = pvr_getEyeTrackingInfo(m_pvrSession, pvr_getTimeSeconds(m_pvr), &state);
-                TraceLoggingWriteTagged(local,
-                                        "HmdShimDriver_PvrEyeTrackingInfo",
-                                        TLArg((int)result, "Result"),
-                                        TLArg(state.TimeInSeconds, "TimeInSeconds"));
-
-                const bool isEyeTrackingDataAvailable = result == pvr_success && state.TimeInSeconds > 0;
-                if (isEyeTrackingDataAvailable) {
-                    TraceLoggingWriteTagged(local,
-                                            "HmdShimDriver_PvrEyeTrackingInfo",
-                                            TLArg(state.GazeTan[0].x, "LeftGazeTanX"),
-                                            TLArg(state.GazeTan[0].y, "LeftGazeTanY"),
-                                            TLArg(state.GazeTan[1].x, "RightGazeTanX"),
-                                            TLArg(state.GazeTan[1].y, "RightGazeTanY"));
-
-                    // Compute the gaze pitch/yaw angles by averaging both eyes.
-                    const float angleHorizontal = atanf((state.GazeTan[0].x + state.GazeTan[1].x) / 2.f);
-                    const float angleVertical = atanf((state.GazeTan[0].y + state.GazeTan[1].y) / 2.f);
-
-                    // Use polar coordinates to create a unit vector.
-                    DirectX::XMStoreFloat3(
-                        (DirectX::XMFLOAT3*)&data.vGazeTarget,
-                        DirectX::XMVector3Normalize(DirectX::XMVectorSet(sinf(angleHorizontal) * cosf(angleVertical),
-                                                                         sinf(angleVertical),
-                                                                         -cosf(angleHorizontal) * cosf(angleVertical),
-                                                                         1)));
-                    data.bValid = data.bTracked = data.bActive = true;
-                } else {
-                    // Fallback to identity.
-                    DirectX::XMStoreFloat3((DirectX::XMFLOAT3*)&data.vGazeTarget, DirectX::XMVectorSet(0, 0, -1, 1));
-                    data.bValid = data.bTracked = data.bActive = false;
-                }
-                vr::VRDriverInput()->UpdateEyeTrackingComponent(m_eyeTrackingComponent, &data, 0.f);
+        // Find the object of the application's scene proxy that the user is looking at, and report it back.
+        void CastGaze(const GazeSample& gaze, const vr::DriverPose_t& pose, const float worldDirection[3]) {
+            const std::shared_ptr<const SceneBvh> bvh = m_sceneProxy->GetBvh();
+            if (!bvh) {
+                return;
             }
 
-            DriverLog("Bye from HmdShimDriver::UpdateThread");
-
-            TraceLoggingWriteStop(local, "HmdShimDriver_UpdateThread");
+            float origin[3];
+            GetWorldPosition(pose, origin);
+            const SceneBvh::Hit hit = bvh->Intersect(origin, worldDirection, k_MaxGazeDistance);
+            m_sceneProxy->PublishHit(gaze.timeInSeconds, hit);
+            if (hit.objectId != m_lastHitObjectId) {
+                TraceLoggingWrite(TraceProvider,
+                                  "HmdShimDriver_SceneHit",
+                                  TLArg(hit.objectId, "ObjectId"),
+                                  TLArg(hit.distance, "Distance"),
+                                  TLArg(gaze.timeInSeconds, "TimeInSeconds"));
+                m_lastHitObjectId = hit.objectId;
+            }
         }
 
         vr::ITrackedDeviceServerDriver* const m_shimmedDevice;
-        const pvrEnvHandle m_pvr;
-        const pvrSessionHandle m_pvrSession;
 
         vr::TrackedDeviceIndex_t m_deviceIndex = vr::k_unTrackedDeviceIndexInvalid;
 
-        std::atomic<bool> m_active = false;
-        std::thread m_updateThread;
+        std::unique_ptr<PrewarmedThread> m_updateThread;
+
+        std::unique_ptr<SceneProxyWatcher> m_sceneProxy;
+        uint32_t m_lastHitObjectId = k_GazeSceneNoHit;
 
         vr::VRInputComponentHandle_t m_eyeTrackingComponent = 0;
+
+        // Declared last, since its update thread calls back into the members above.
+        GazeUpdateLoop m_loop;
     };
 } // namespace
 
 namespace driver_shim {
 
     vr::ITrackedDeviceServerDriver* CreateHmdShimDriver(vr::ITrackedDeviceServerDriver* shimmedDriver,
-                                                        pvrEnvHandle pvr,
-                                                        pvrSessionHandle pvrSession) {
+                                                        std::shared_ptr<EyeTrackerSource> trackerSource) {
         try {
-            return new HmdShimDriver(shimmedDriver, pvr, pvrSession);
+            return new HmdShimDriver(shimmedDriver, std::move(trackerSource));
         } catch (EyeTrackerNotSupportedException&) {
             return shimmedDriver;
         }
     }
 
+    void DestroyHmdShimDriver(vr::ITrackedDeviceServerDriver* driver) {
+        // The OpenVR interfaces have no virtual destructor.
+        delete static_cast<HmdShimDriver*>(driver);
+    }
+
 } // namespace driver_shim
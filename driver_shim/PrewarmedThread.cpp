@@ -0,0 +1,129 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "PrewarmedThread.h"
+#include "Tracing.h"
+
+namespace {
+    using namespace driver_shim;
+
+    // How much of the stack to touch upfront. Covers the deepest path of the update loop with room to spare.
+    constexpr size_t k_StackPrefaultSize = 64 * 1024;
+
+    std::mutex g_poolMutex;
+    std::vector<std::unique_ptr<PrewarmedThread>> g_pool;
+
+    void PrefaultStack() {
+        volatile uint8_t stack[k_StackPrefaultSize];
+        for (size_t i = 0; i < sizeof(stack); i += 4096) {
+            stack[i] = 0;
+        }
+    }
+
+} // namespace
+
+namespace driver_shim {
+
+    PrewarmedThread::PrewarmedThread(const std::wstring& name) : m_name(name) {
+        m_thread = std::thread(&PrewarmedThread::ThreadMain, this);
+    }
+
+    PrewarmedThread::~PrewarmedThread() {
+        {
+            std::unique_lock lock(m_mutex);
+            m_exit = true;
+        }
+        m_condition.notify_all();
+        m_thread.join();
+    }
+
+    void PrewarmedThread::Run(std::function<void()> job) {
+        {
+            std::unique_lock lock(m_mutex);
+            m_job = std::move(job);
+            m_isRunning = true;
+        }
+        m_condition.notify_all();
+    }
+
+    void PrewarmedThread::Wait() {
+        std::unique_lock lock(m_mutex);
+        m_condition.wait(lock, [&] { return !m_isRunning; });
+    }
+
+    void PrewarmedThread::ThreadMain() {
+        SetThreadDescription(GetCurrentThread(), m_name.c_str());
+        PrefaultStack();
+
+        std::unique_lock lock(m_mutex);
+        while (true) {
+            m_condition.wait(lock, [&] { return m_isRunning || m_exit; });
+            if (m_exit) {
+                break;
+            }
+
+            std::function<void()> job = std::move(m_job);
+            lock.unlock();
+            job();
+            lock.lock();
+
+            m_isRunning = false;
+            m_condition.notify_all();
+        }
+    }
+
+    void PrewarmThreads(size_t count) {
+        TraceLocalActivity(local);
+        TraceLoggingWriteStart(local, "PrewarmThreads", TLArg(count, "Count"));
+
+        std::unique_lock lock(g_poolMutex);
+        while (g_pool.size() < count) {
+            g_pool.push_back(std::make_unique<PrewarmedThread>(L"HmdShimDriver_UpdateThread"));
+        }
+
+        TraceLoggingWriteStop(local, "PrewarmThreads");
+    }
+
+    std::unique_ptr<PrewarmedThread> AcquirePrewarmedThread() {
+        std::unique_lock lock(g_poolMutex);
+
+        std::unique_ptr<PrewarmedThread> thread;
+        if (!g_pool.empty()) {
+            thread = std::move(g_pool.back());
+            g_pool.pop_back();
+        } else {
+            thread = std::make_unique<PrewarmedThread>(L"HmdShimDriver_UpdateThread");
+        }
+
+        TraceLoggingWrite(TraceProvider, "AcquirePrewarmedThread", TLArg(g_pool.size(), "Remaining"));
+
+        return thread;
+    }
+
+    void ReleasePrewarmedThreads() {
+        std::unique_lock lock(g_poolMutex);
+        g_pool.clear();
+    }
+
+} // namespace driver_shim
@@ -0,0 +1,71 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace driver_shim {
+
+    // A thread created ahead of time and parked until it is given work, so that starting work does not pay for thread
+    // creation and for faulting in the thread's stack.
+    class PrewarmedThread {
+      public:
+        explicit PrewarmedThread(const std::wstring& name);
+        ~PrewarmedThread();
+
+        PrewarmedThread(const PrewarmedThread&) = delete;
+        PrewarmedThread& operator=(const PrewarmedThread&) = delete;
+
+        // Wake up the thread to run job. Only one job may run at a time.
+        void Run(std::function<void()> job);
+
+        // Wait for the current job to return. The caller is responsible for telling the job to return.
+        void Wait();
+
+      private:
+        void ThreadMain();
+
+        const std::wstring m_name;
+
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::function<void()> m_job;
+        bool m_isRunning = false;
+        bool m_exit = false;
+        std::thread m_thread;
+    };
+
+    // Create threads ahead of time, typically from Driver::Init().
+    void PrewarmThreads(size_t count);
+
+    // Take one of the pre-warmed threads, or create a new one if none is left.
+    std::unique_ptr<PrewarmedThread> AcquirePrewarmedThread();
+
+    // Release all the pre-warmed threads that were not used.
+    void ReleasePrewarmedThreads();
+
+} // namespace driver_shim
@@ -0,0 +1,117 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "DeviceRegistry.h"
+#include "DriverSettings.h"
+#include "EyeTrackerSource.h"
+#include "Tracing.h"
+
+namespace {
+    using namespace driver_shim;
+
+    // PVR does not offer notifications, this source must be polled.
+    struct PvrEyeTrackerSource : public EyeTrackerSource {
+        PvrEyeTrackerSource(std::shared_ptr<PvrSession> pvrSession) : m_pvrSession(std::move(pvrSession)) {
+        }
+
+        const char* GetName() const override {
+            return "pvr";
+        }
+
+        bool GetLatestSample(EyeTrackerSample& sample) override {
+            TraceLocalActivity(local);
+            TraceLoggingWriteStart(local, "PvrEyeTrackerSource_GetLatestSample");
+
+            const double now = pvr_getTimeSeconds(m_pvrSession->GetEnv());
+            pvrEyeTrackingInfo state{};
+            pvrResult result = pvr_getEyeTrackingInfo(m_pvrSession->GetSession(), now, &state);
+            TraceLoggingWriteTagged(local,
+                                    "PvrEyeTrackerSource_PvrEyeTrackingInfo",
+                                    TLArg((int)result, "Result"),
+                                    TLArg(state.TimeInSeconds, "TimeInSeconds"));
+
+            // Invalid samples are stamped with the time of the query, so that the duration of tracking losses is known.
+            sample.isValid = result == pvr_success && state.TimeInSeconds > 0;
+            sample.timeInSeconds = now;
+            if (sample.isValid) {
+                TraceLoggingWriteTagged(local,
+                                        "PvrEyeTrackerSource_PvrEyeTrackingInfo",
+                                        TLArg(state.GazeTan[0].x, "LeftGazeTanX"),
+                                        TLArg(state.GazeTan[0].y, "LeftGazeTanY"),
+                                        TLArg(state.GazeTan[1].x, "RightGazeTanX"),
+                                        TLArg(state.GazeTan[1].y, "RightGazeTanY"));
+
+                sample.timeInSeconds = state.TimeInSeconds;
+                for (int eye = 0; eye < 2; eye++) {
+                    sample.gazeTan[eye].x = state.GazeTan[eye].x;
+                    sample.gazeTan[eye].y = state.GazeTan[eye].y;
+                }
+            }
+
+            TraceLoggingWriteStop(local, "PvrEyeTrackerSource_GetLatestSample", TLArg(sample.isValid, "Valid"));
+
+            return sample.isValid;
+        }
+
+        const std::shared_ptr<PvrSession> m_pvrSession;
+    };
+
+} // namespace
+
+namespace driver_shim {
+
+    std::shared_ptr<EyeTrackerSource> CreatePvrEyeTrackerSource(std::shared_ptr<PvrSession> pvrSession) {
+        return std::make_shared<PvrEyeTrackerSource>(std::move(pvrSession));
+    }
+
+    std::shared_ptr<EyeTrackerSource> CreateEyeTrackerSource() {
+        TraceLocalActivity(local);
+        TraceLoggingWriteStart(local, "CreateEyeTrackerSource");
+
+        const DriverSettings& settings = GetDriverSettings();
+
+        std::shared_ptr<EyeTrackerSource> source;
+        if (settings.trackerSource == "replay") {
+            source = CreateReplayEyeTrackerSource(settings.replayFile, settings.replayLoop);
+        } else if (settings.trackerSource == "synthetic") {
+            source = CreateSyntheticEyeTrackerSource();
+        } else {
+            std::shared_ptr<PvrSession> pvrSession = GetDeviceRegistry().AcquireSession();
+            if (pvrSession) {
+                source = CreatePvrEyeTrackerSource(std::move(pvrSession));
+            }
+        }
+
+        if (source) {
+            DriverLog("Using eye tracker source: %s", source->GetName());
+        } else {
+            DriverLog("Failed to create eye tracker source: %s", settings.trackerSource.c_str());
+        }
+
+        TraceLoggingWriteStop(local, "CreateEyeTrackerSource", TLArg(source ? source->GetName() : "", "Source"));
+
+        return source;
+    }
+
+} // namespace driver_shim
@@ -0,0 +1,168 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "Clock.h"
+#include "SceneProxyWatcher.h"
+#include "Tracing.h"
+
+namespace driver_shim {
+
+    SceneProxyWatcher::SceneProxyWatcher() {
+        m_thread = std::thread(&SceneProxyWatcher::WatchThread, this);
+    }
+
+    SceneProxyWatcher::~SceneProxyWatcher() {
+        {
+            std::unique_lock lock(m_stopMutex);
+            m_stop = true;
+        }
+        m_stopCondition.notify_all();
+        m_thread.join();
+    }
+
+    void SceneProxyWatcher::PublishHit(double timeInSeconds, const SceneBvh::Hit& hit) {
+        // Uncontended except when the watch thread unmaps the view.
+        std::unique_lock lock(m_unmapMutex);
+        GazeSceneProxyHeader* const header = m_header.load(std::memory_order_acquire);
+        if (!header) {
+            return;
+        }
+
+        GazeSceneHit& output = header->hit;
+        const uint32_t sequence = output.sequence.load(std::memory_order_relaxed);
+        output.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        output.objectId = hit.objectId;
+        output.distance = hit.distance;
+        output.timeInSeconds = timeInSeconds;
+        output.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    void SceneProxyWatcher::WatchThread() {
+        TraceLocalActivity(local);
+        TraceLoggingWriteStart(local, "SceneProxyWatcher_WatchThread");
+
+        SetThreadDescription(GetCurrentThread(), L"SceneProxyWatcher_WatchThread");
+
+        std::unique_lock lock(m_stopMutex);
+        while (!GetClock().WaitFor(lock, m_stopCondition, k_GazeSceneProxyPollMs / 1000.0, [&] { return m_stop; })) {
+            if (m_header.load(std::memory_order_relaxed) || OpenMapping()) {
+                Update();
+            }
+        }
+        GetClock().OnThreadExit();
+
+        CloseMapping();
+
+        TraceLoggingWriteStop(local, "SceneProxyWatcher_WatchThread");
+    }
+
+    bool SceneProxyWatcher::OpenMapping() {
+        m_mapping = OpenFileMappingA(FILE_MAP_READ | FILE_MAP_WRITE, FALSE, k_GazeSceneProxyName);
+        if (!m_mapping) {
+            return false;
+        }
+
+        auto header =
+            reinterpret_cast<GazeSceneProxyHeader*>(MapViewOfFile(m_mapping, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, 0));
+        MEMORY_BASIC_INFORMATION info{};
+        if (!header || !VirtualQuery(header, &info, sizeof(info)) || info.RegionSize < sizeof(GazeSceneProxyHeader) ||
+            header->magic != k_GazeSceneProxyMagic || header->version != k_GazeSceneProxyVersion ||
+            info.RegionSize < sizeof(GazeSceneProxyHeader) + (size_t)header->capacity * sizeof(GazeScenePrimitive)) {
+            DriverLog("Ignoring invalid scene proxy");
+            if (header) {
+                UnmapViewOfFile(header);
+            }
+            CloseHandle(m_mapping);
+            m_mapping = nullptr;
+            return false;
+        }
+
+        // The application can change the header at any time: only trust the size of the view.
+        m_capacity = (info.RegionSize - sizeof(GazeSceneProxyHeader)) / sizeof(GazeScenePrimitive);
+        DriverLog("Opened scene proxy with capacity for %u primitives", header->capacity);
+        m_lastGeneration = 0;
+        m_header.store(header, std::memory_order_release);
+        return true;
+    }
+
+    void SceneProxyWatcher::CloseMapping() {
+        {
+            std::unique_lock lock(m_unmapMutex);
+            GazeSceneProxyHeader* const header = m_header.exchange(nullptr);
+            if (header) {
+                UnmapViewOfFile(header);
+            }
+        }
+        if (m_mapping) {
+            CloseHandle(m_mapping);
+            m_mapping = nullptr;
+        }
+    }
+
+    void SceneProxyWatcher::Update() {
+        GazeSceneProxyHeader* const header = m_header.load(std::memory_order_relaxed);
+
+        // Copy the primitives while the application is not writing them, and retry at the next poll otherwise.
+        const uint32_t generation = header->generation.load(std::memory_order_acquire);
+        if (generation == m_lastGeneration || (generation & 1)) {
+            return;
+        }
+        const uint32_t count = (uint32_t)std::min<size_t>(header->primitiveCount, m_capacity);
+        const auto primitives = reinterpret_cast<const GazeScenePrimitive*>(header + 1);
+        m_primitives.assign(primitives, primitives + count);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (header->generation.load(std::memory_order_relaxed) != generation) {
+            return;
+        }
+        m_lastGeneration = generation;
+
+        TraceLocalActivity(local);
+        TraceLoggingWriteStart(
+            local, "SceneProxyWatcher_Update", TLArg(generation, "Generation"), TLArg(count, "Primitives"));
+
+        const auto start = std::chrono::steady_clock::now();
+        const std::shared_ptr<const SceneBvh> current = GetBvh();
+        std::shared_ptr<SceneBvh> next;
+        const bool refit = current && m_refitCount < k_MaxRefits && current->HasSameTopology(m_primitives);
+        if (refit) {
+            next = std::make_shared<SceneBvh>(*current);
+            next->Refit(m_primitives);
+            m_refitCount++;
+        } else {
+            next = std::make_shared<SceneBvh>(m_primitives);
+            m_refitCount = 0;
+        }
+        std::atomic_store(&m_bvh, std::shared_ptr<const SceneBvh>(std::move(next)));
+        const auto duration =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+        TraceLoggingWriteStop(
+            local, "SceneProxyWatcher_Update", TLArg(refit, "Refit"), TLArg(duration.count(), "DurationUs"));
+        if (!refit) {
+            DriverLog("Built scene hierarchy of %u primitives in %lld us", count, duration.count());
+        }
+    }
+
+} // namespace driver_shim
@@ -0,0 +1,80 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "GazeSceneProxy.h"
+#include "SceneBvh.h"
+
+namespace driver_shim {
+
+    // Watches the scene proxy shared by an application (see GazeSceneProxy.h), and maintains a SceneBvh for it on a
+    // background thread, so that the update thread only casts rays. The hierarchy is refitted when the primitives only
+    // moved, and rebuilt when they changed or after k_MaxRefits refits (which degrade its quality).
+    class SceneProxyWatcher {
+      public:
+        static constexpr uint32_t k_MaxRefits = 32;
+
+        SceneProxyWatcher();
+        ~SceneProxyWatcher();
+
+        // The latest hierarchy, or nullptr if no application supplied a scene.
+        std::shared_ptr<const SceneBvh> GetBvh() const {
+            return std::atomic_load(&m_bvh);
+        }
+
+        // Report the result of the ray cast for a gaze sample to the application. Must be called from one thread.
+        void PublishHit(double timeInSeconds, const SceneBvh::Hit& hit);
+
+      private:
+        void WatchThread();
+        bool OpenMapping();
+        void CloseMapping();
+        void Update();
+
+        std::shared_ptr<const SceneBvh> m_bvh;
+
+        // Mapped by the watch thread, which only unmaps it when stopping, under m_unmapMutex since PublishHit() may
+        // be writing the hit.
+        std::mutex m_unmapMutex;
+        std::atomic<GazeSceneProxyHeader*> m_header = nullptr;
+        HANDLE m_mapping = nullptr;
+
+        // Number of primitives that fit in the view, measured when it was mapped.
+        size_t m_capacity = 0;
+        uint32_t m_lastGeneration = 0;
+        uint32_t m_refitCount = 0;
+        std::vector<GazeScenePrimitive> m_primitives;
+
+        std::mutex m_stopMutex;
+        std::condition_variable m_stopCondition;
+        bool m_stop = false;
+        std::thread m_thread;
+    };
+
+} // namespace driver_shim
@@ -24,14 +24,12 @@
 
 #include "ShimDriverManager.h"
 #include "DetourUtils.h"
+#include "StartupTimeline.h"
 #include "Tracing.h"
 
 namespace {
     using namespace driver_shim;
 
-    pvrEnvHandle g_pvr = nullptr;
-    pvrSessionHandle g_pvrSession = nullptr;
-
     DEFINE_DETOUR_FUNCTION(bool,
                            IVRServerDriverHost_TrackedDeviceAdded,
                            vr::IVRServerDriverHost* driverHost,
@@ -43,6 +41,7 @@ namespace {
                                "IVRServerDriverHost_TrackedDeviceAdded",
                                TLArg(pchDeviceSerialNumber, "DeviceSerialNumber"),
                                TLArg((int)eDeviceClass, "DeviceClass"));
+        StartupStep step("TrackedDeviceAdded");
 
         vr::ITrackedDeviceServerDriver* shimmedDriver = pDriver;
 
@@ -51,7 +50,20 @@ namespace {
             TraceLoggingWriteTagged(local, "IVRServerDriverHost_TrackedDeviceAdded", TLArg(true, "IsTargetDriver"));
             if (eDeviceClass == vr::TrackedDeviceClass_HMD) {
                 DriverLog("Shimming new TrackedDeviceClass_HMD with HmdShimDriver");
-                shimmedDriver = CreateHmdShimDriver(pDriver, g_pvr, g_pvrSession);
+
+                // The device holds a reference on its source, which keeps any PVR session alive for as long as needed.
+                std::shared_ptr<EyeTrackerSource> trackerSource = CreateEyeTrackerSource();
+                if (trackerSource) {
+                    shimmedDriver = CreateHmdShimDriver(pDriver, trackerSource);
+                    if (shimmedDriver != pDriver) {
+                        GetDeviceRegistry().Register({pchDeviceSerialNumber ? pchDeviceSerialNumber : "",
+                                                      eDeviceClass,
+                                                      shimmedDriver,
+                                                      trackerSource});
+                    }
+                } else {
+                    DriverLog("Failed to create eye tracker source, not shimming");
+                }
             }
         }
 
@@ -67,27 +79,66 @@ namespace {
 
 namespace driver_shim {
 
-    void InstallShimDriverHook(pvrEnvHandle pvr, pvrSessionHandle pvrSession) {
+    void InstallShimDriverHook() {
         TraceLocalActivity(local);
         TraceLoggingWriteStart(local, "InstallShimDriverHook");
+        StartupStep step("InstallShimDriverHook");
 
         DriverLog("Installing IVRServerDriverHost::TrackedDeviceAdded hook");
 
-        g_pvr = pvr;
-        g_pvrSession = pvrSession;
+        // All hooks are installed within a single transaction, in order to minimize the time vrserver's threads are
+        // suspended.
+        DetourTransactionScope transaction;
 
         // TODO: Consider hooking all flavors, though I doubt the driver_aapvr will change anytime soon.
         vr::EVRInitError eError;
         DetourMethodAttach(
+            transaction,
             // driver_aapvr uses the 006 flavor.
             vr::VRDriverContext()->GetGenericInterface("IVRServerDriverHost_006", &eError),
             0 /* TrackedDeviceAdded() */,
             hooked_IVRServerDriverHost_TrackedDeviceAdded,
             original_IVRServerDriverHost_TrackedDeviceAdded);
 
+        const LONG result = transaction.Commit();
+        TraceLoggingWriteTagged(local,
+                                "InstallShimDriverHook_Transaction",
+                                TLArg(result, "Result"),
+                                TLArg(transaction.GetOperationCount(), "Hooks"),
+                                TLArg(transaction.GetDuration().count(), "DurationUs"));
+        DriverLog("Installed %u hook(s) in %lld us (status: %ld)",
+                  transaction.GetOperationCount(),
+                  transaction.GetDuration().count(),
+                  result);
+
         TraceLoggingWriteStop(local, "InstallShimDriverHook");
     }
 
+    void UninstallShimDriverHook() {
+        TraceLocalActivity(local);
+        TraceLoggingWriteStart(local, "UninstallShimDriverHook");
+
+        // Mirror InstallShimDriverHook(), so that reloading the driver does not leave stale trampolines behind.
+        DetourTransactionScope transaction;
+
+        DetourMethodDetach(transaction,
+                           hooked_IVRServerDriverHost_TrackedDeviceAdded,
+                           original_IVRServerDriverHost_TrackedDeviceAdded);
+
+        const LONG result = transaction.Commit();
+        TraceLoggingWriteTagged(local,
+                                "UninstallShimDriverHook_Transaction",
+                                TLArg(result, "Result"),
+                                TLArg(transaction.GetOperationCount(), "Hooks"),
+                                TLArg(transaction.GetDuration().count(), "DurationUs"));
+        DriverLog("Uninstalled %u hook(s) in %lld us (status: %ld)",
+                  transaction.GetOperationCount(),
+                  transaction.GetDuration().count(),
+                  result);
+
+        TraceLoggingWriteStop(local, "UninstallShimDriverHook");
+    }
+
     bool IsTargetDriver(void* returnAddress) {
         HMODULE callerModule;
         if (GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
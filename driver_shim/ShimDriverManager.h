@@ -24,15 +24,20 @@
 #include <intrin.h>
 #include <openvr_driver.h>
 
+#include "DeviceRegistry.h"
+
 #pragma intrinsic(_ReturnAddress)
 
 namespace driver_shim {
 
-    void InstallShimDriverHook(pvrEnvHandle pvr, pvrSessionHandle pvrSession);
+    void InstallShimDriverHook();
+    void UninstallShimDriverHook();
     bool IsTargetDriver(void* returnAddress);
 
     vr::ITrackedDeviceServerDriver* CreateHmdShimDriver(vr::ITrackedDeviceServerDriver* shimmedDriver,
-                                                        pvrEnvHandle pvr,
-                                                        pvrSessionHandle pvrSession);
+                                                        std::shared_ptr<EyeTrackerSource> trackerSource);
+
+    // Destroy a device returned by CreateHmdShimDriver() (not the device it shims, which its driver owns).
+    void DestroyHmdShimDriver(vr::ITrackedDeviceServerDriver* driver);
 
 } // namespace driver_shim
@@ -22,6 +22,7 @@
 
 #include "pch.h"
 
+#include "StartupTimeline.h"
 #include "Tracing.h"
 
 // {15d4b714-f01f-4f5b-9a76-de69f386ade9}
@@ -33,6 +34,7 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
     switch (ul_reason_for_call) {
     case DLL_PROCESS_ATTACH:
         TraceLoggingRegister(TraceProvider);
+        driver_shim::InitializeStartupTimeline();
         break;
     case DLL_PROCESS_DETACH:
         TraceLoggingUnregister(TraceProvider);
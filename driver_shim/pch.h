@@ -23,14 +23,32 @@
 #pragma once
 
 #define WIN32_LEAN_AND_MEAN // Exclude rarely-used stuff from Windows headers
+#define NOMINMAX
 #include <windows.h>
+#include <psapi.h>
+#include <tlhelp32.h>
 #include <DirectXMath.h>
 #include <TraceLoggingActivity.h>
 #include <TraceLoggingProvider.h>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cfloat>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include <openvr_driver.h>
 #include <driverlog.h>
@@ -40,3 +58,9 @@
 #include <PVR_Interface.h>
 
 #include <detours.h>
+
+// The driver is a thin adapter around the portable eye tracking library.
+namespace eyetracking_core {}
+namespace driver_shim {
+    using namespace eyetracking_core;
+} // namespace driver_shim
@@ -0,0 +1,153 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "Arena.h"
+#include "Platform.h"
+#include "Tracing.h"
+
+namespace {
+
+    size_t RoundUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+#ifdef _WIN32
+    // Large pages require the privilege to lock pages in memory to be granted to the account, and then enabled in the
+    // token of the process.
+    bool EnableLockMemoryPrivilege() {
+        HANDLE token;
+        if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) {
+            return false;
+        }
+        TOKEN_PRIVILEGES privileges{};
+        privileges.PrivilegeCount = 1;
+        privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+        bool success = LookupPrivilegeValueW(nullptr, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid) &&
+                       AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) &&
+                       GetLastError() == ERROR_SUCCESS;
+        CloseHandle(token);
+        return success;
+    }
+
+    void* MapLargePages(size_t& size) {
+        const size_t largePageSize = GetLargePageMinimum();
+        if (!largePageSize || !EnableLockMemoryPrivilege()) {
+            return nullptr;
+        }
+        size = RoundUp(size, largePageSize);
+        return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+    }
+
+    void* MapPages(size_t size) {
+        return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    }
+
+    void UnmapPages(void* address, size_t /* size */) {
+        VirtualFree(address, 0, MEM_RELEASE);
+    }
+#else
+    constexpr size_t k_HugePageSize = 2 * 1024 * 1024;
+
+    void* MapLargePages(size_t& size) {
+        size = RoundUp(size, k_HugePageSize);
+        void* const address =
+            mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        return address != MAP_FAILED ? address : nullptr;
+    }
+
+    void* MapPages(size_t size) {
+        void* const address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        return address != MAP_FAILED ? address : nullptr;
+    }
+
+    void UnmapPages(void* address, size_t size) {
+        munmap(address, size);
+    }
+#endif
+
+} // namespace
+
+namespace eyetracking_core {
+
+    Arena::Arena(size_t size, bool largePages) {
+        TraceLocalActivity(local);
+        TraceLoggingWriteStart(local, "Arena_Ctor", TLArg(size, "Size"), TLArg(largePages, "LargePages"));
+
+        if (size) {
+            size = RoundUp(size, k_SliceAlignment);
+            void* base = nullptr;
+            if (largePages) {
+                base = MapLargePages(size);
+                m_largePages = base != nullptr;
+                if (!base) {
+                    Log("Large pages are not available, using regular pages for the arena");
+                }
+            }
+            if (!base) {
+                base = MapPages(size);
+            }
+            if (base) {
+                // Fault in every page now rather than on the first sample.
+                memset(base, 0, size);
+                m_base = static_cast<std::byte*>(base);
+                m_capacity = size;
+            } else {
+                Log("Failed to reserve %zu bytes for the arena", size);
+            }
+        }
+
+        TraceLoggingWriteStop(local, "Arena_Ctor", TLArg(m_capacity, "Capacity"), TLArg(m_largePages, "LargePages"));
+    }
+
+    Arena::~Arena() {
+        if (m_base) {
+            UnmapPages(m_base, m_capacity);
+        }
+    }
+
+    void* Arena::Allocate(size_t size, size_t alignment) {
+        alignment = alignment > k_SliceAlignment ? alignment : k_SliceAlignment;
+        size_t used = m_used.load(std::memory_order_relaxed);
+        size_t offset;
+        do {
+            offset = RoundUp(used, alignment);
+            if (offset > m_capacity || size > m_capacity - offset) {
+                TraceLoggingWrite(TraceProvider, "Arena_Exhausted", TLArg(size, "Size"), TLArg(used, "Used"));
+                return nullptr;
+            }
+        } while (!m_used.compare_exchange_weak(used, offset + size, std::memory_order_relaxed));
+
+        return m_base + offset;
+    }
+
+} // namespace eyetracking_core
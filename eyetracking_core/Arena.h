@@ -0,0 +1,182 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace eyetracking_core {
+
+    // One region of memory, reserved and faulted in at construction, from which subsystems carve fixed slices for
+    // their rings, trees and grids. Keeping them together (and optionally on large pages) reduces the TLB misses of
+    // the update thread, which walks all of them for every sample.
+    //
+    // Slices are never freed individually: the whole region is released with the arena, which must therefore outlive
+    // them. Carving is thread-safe and lock-free, but it is meant for setup: allocate everything upfront.
+    class Arena {
+      public:
+        // Large pages need a privilege on Windows (SeLockMemoryPrivilege) and reserved huge pages on Linux
+        // (vm.nr_hugepages). Without them, regular pages are used instead. A size of 0 disables the arena.
+        Arena(size_t size, bool largePages);
+        ~Arena();
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        // Returns nullptr once the arena is exhausted; callers then fall back to the heap.
+        void* Allocate(size_t size, size_t alignment);
+
+        size_t GetCapacity() const {
+            return m_capacity;
+        }
+
+        size_t GetUsed() const {
+            return m_used.load(std::memory_order_relaxed);
+        }
+
+        bool HasLargePages() const {
+            return m_largePages;
+        }
+
+        // Slices are aligned on cache lines, so that two subsystems never share one.
+        static constexpr size_t k_SliceAlignment = 64;
+
+      private:
+        std::byte* m_base = nullptr;
+        size_t m_capacity = 0;
+        bool m_largePages = false;
+        std::atomic<size_t> m_used = 0;
+    };
+
+    // A fixed-size array carved from an arena, or from the heap when there is no arena or it is exhausted. The elements
+    // are value-initialized.
+    template <typename T>
+    class ArenaArray {
+      public:
+        ArenaArray() = default;
+
+        ArenaArray(size_t size, Arena* arena = nullptr) {
+            Allocate(size, arena);
+        }
+
+        ArenaArray(const ArenaArray& other) {
+            Allocate(other.m_size, other.m_arena);
+            for (size_t i = 0; i < m_size; i++) {
+                m_data[i] = other.m_data[i];
+            }
+        }
+
+        ArenaArray(ArenaArray&& other) noexcept {
+            Swap(other);
+        }
+
+        ArenaArray& operator=(ArenaArray other) noexcept {
+            Swap(other);
+            return *this;
+        }
+
+        ~ArenaArray() {
+            for (size_t i = 0; i < m_size; i++) {
+                m_data[i].~T();
+            }
+            if (m_isOnHeap) {
+                ::operator delete(m_data, std::align_val_t(alignof(T)));
+            }
+        }
+
+        size_t size() const {
+            return m_size;
+        }
+
+        T* data() {
+            return m_data;
+        }
+
+        const T* data() const {
+            return m_data;
+        }
+
+        T* begin() {
+            return m_data;
+        }
+
+        T* end() {
+            return m_data + m_size;
+        }
+
+        const T* begin() const {
+            return m_data;
+        }
+
+        const T* end() const {
+            return m_data + m_size;
+        }
+
+        T& operator[](size_t index) {
+            return m_data[index];
+        }
+
+        const T& operator[](size_t index) const {
+            return m_data[index];
+        }
+
+        bool IsInArena() const {
+            return m_size && !m_isOnHeap;
+        }
+
+      private:
+        void Allocate(size_t size, Arena* arena) {
+            if (!size) {
+                return;
+            }
+            m_arena = arena;
+            void* memory = arena ? arena->Allocate(size * sizeof(T), alignof(T)) : nullptr;
+            if (!memory) {
+                memory = ::operator new(size * sizeof(T), std::align_val_t(alignof(T)));
+                m_isOnHeap = true;
+            }
+            m_data = static_cast<T*>(memory);
+            for (size_t i = 0; i < size; i++) {
+                new (m_data + i) T();
+            }
+            m_size = size;
+        }
+
+        void Swap(ArenaArray& other) noexcept {
+            std::swap(m_data, other.m_data);
+            std::swap(m_size, other.m_size);
+            std::swap(m_arena, other.m_arena);
+            std::swap(m_isOnHeap, other.m_isOnHeap);
+        }
+
+        T* m_data = nullptr;
+        size_t m_size = 0;
+        Arena* m_arena = nullptr;
+        bool m_isOnHeap = false;
+    };
+
+} // namespace eyetracking_core
@@ -0,0 +1,197 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "Clock.h"
+#include "Platform.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    SystemClock g_systemClock;
+    std::unique_ptr<VirtualClock> g_virtualClock;
+    Clock* g_clock = &g_systemClock;
+
+} // namespace
+
+namespace eyetracking_core {
+
+    void Clock::SleepUntil(double deadline) {
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::unique_lock lock(mutex);
+        WaitUntil(lock, condition, deadline, [] { return false; });
+    }
+
+    double SystemClock::Now() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    bool SystemClock::WaitUntil(std::unique_lock<std::mutex>& lock,
+                                std::condition_variable& condition,
+                                double deadline,
+                                const std::function<bool()>& predicate) {
+        const std::chrono::steady_clock::time_point time(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(deadline)));
+        return condition.wait_until(lock, time, predicate);
+    }
+
+    bool VirtualClock::WaitUntil(std::unique_lock<std::mutex>& lock,
+                                 std::condition_variable& condition,
+                                 double deadline,
+                                 const std::function<bool()>& predicate) {
+        Waiter waiter{lock.mutex(), &condition, deadline, 0, std::this_thread::get_id()};
+        {
+            std::unique_lock waitersLock(m_mutex);
+            waiter.id = m_nextWaiterId++;
+            m_waiters.push_back(&waiter);
+            m_busyThreads.erase(std::remove(m_busyThreads.begin(), m_busyThreads.end(), waiter.threadId),
+                                m_busyThreads.end());
+        }
+        m_waitersChanged.notify_all();
+
+        // The time is read with the mutex of the waiter held, and AdvanceTo() only notifies after acquiring that same
+        // mutex, so a step cannot slip in between the check and the wait.
+        bool result;
+        while (!(result = predicate()) && Now() < deadline) {
+            condition.wait(lock);
+        }
+
+        {
+            std::unique_lock waitersLock(m_mutex);
+            m_waiters.erase(std::find(m_waiters.begin(), m_waiters.end(), &waiter));
+        }
+        m_waitersChanged.notify_all();
+
+        return result;
+    }
+
+    void VirtualClock::AdvanceTo(double time) {
+        std::unique_lock advanceLock(m_advanceMutex);
+        std::unique_lock lock(m_mutex);
+        while (true) {
+            // Stop at the earliest deadline before the requested time.
+            const double now = Now();
+            double next = time;
+            for (const Waiter* waiter : m_waiters) {
+                if (waiter->deadline > now && waiter->deadline < next) {
+                    next = waiter->deadline;
+                }
+            }
+            if (next > now) {
+                m_now.store(next, std::memory_order_release);
+            }
+
+            WakeDueWaiters(lock);
+            if (!m_waitersChanged.wait_for(lock, k_BusyTimeout, [&] { return m_busyThreads.empty(); })) {
+                Log("Virtual clock: %zu thread(s) still busy after %lld ms at %.6f s, no longer waiting for them",
+                    m_busyThreads.size(),
+                    (long long)k_BusyTimeout.count(),
+                    next);
+            }
+            m_busyThreads.clear();
+
+            if (next >= time) {
+                break;
+            }
+        }
+    }
+
+    void VirtualClock::OnThreadExit() {
+        {
+            std::unique_lock lock(m_mutex);
+            m_busyThreads.erase(std::remove(m_busyThreads.begin(), m_busyThreads.end(), std::this_thread::get_id()),
+                                m_busyThreads.end());
+        }
+        m_waitersChanged.notify_all();
+    }
+
+    void VirtualClock::WaitForWaiters(size_t count) {
+        std::unique_lock lock(m_mutex);
+        m_waitersChanged.wait(lock, [&] { return m_waiters.size() >= count; });
+    }
+
+    bool VirtualClock::IsWaiting(uint64_t id) const {
+        return std::any_of(m_waiters.begin(), m_waiters.end(), [&](const Waiter* waiter) { return waiter->id == id; });
+    }
+
+    void VirtualClock::WakeDueWaiters(std::unique_lock<std::mutex>& lock) {
+        const double now = Now();
+
+        // The due threads are busy from now on, even if they notice the new time by themselves before being notified,
+        // eg: while the lock is released below to wake up another one of them.
+        for (const Waiter* waiter : m_waiters) {
+            if (waiter->deadline <= now) {
+                m_busyThreads.push_back(waiter->threadId);
+            }
+        }
+
+        for (size_t i = 0; i < m_waiters.size();) {
+            const Waiter* const waiter = m_waiters[i];
+            if (waiter->deadline > now) {
+                i++;
+                continue;
+            }
+
+            // Owning the mutex of the waiter means that it is blocked in its wait, or has yet to check the time. If
+            // another thread owns it, let that thread go and retry, since waiting on it here could deadlock.
+            if (waiter->mutex->try_lock()) {
+                waiter->mutex->unlock();
+                waiter->condition->notify_all();
+                const uint64_t id = waiter->id;
+                m_waitersChanged.wait(lock, [&] { return !IsWaiting(id); });
+            } else {
+                lock.unlock();
+                std::this_thread::yield();
+                lock.lock();
+            }
+
+            // The list may have changed while the lock was released.
+            i = 0;
+        }
+    }
+
+    Clock& GetClock() {
+        return *g_clock;
+    }
+
+    void SetVirtualTime(bool enable) {
+        if (enable && !g_virtualClock) {
+            g_virtualClock = std::make_unique<VirtualClock>();
+        }
+        g_clock = enable ? static_cast<Clock*>(g_virtualClock.get()) : &g_systemClock;
+    }
+
+    VirtualClock* GetVirtualClock() {
+        return g_clock == g_virtualClock.get() ? g_virtualClock.get() : nullptr;
+    }
+
+} // namespace eyetracking_core
@@ -0,0 +1,157 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace eyetracking_core {
+
+    // The time source behind every scheduler and timestamp of the driver, in seconds. Measurements of the CPU cost of
+    // the code (pipeline and plugin timings, startup timeline) deliberately stay on the steady clock, and the PVR
+    // source keeps the timestamps of the headset.
+    class Clock {
+      public:
+        virtual ~Clock() = default;
+
+        virtual double Now() const = 0;
+
+        // Wait on condition (with lock held) until predicate returns true or the clock reaches deadline. Returns the
+        // last value of predicate.
+        virtual bool WaitUntil(std::unique_lock<std::mutex>& lock,
+                               std::condition_variable& condition,
+                               double deadline,
+                               const std::function<bool()>& predicate) = 0;
+
+        bool WaitFor(std::unique_lock<std::mutex>& lock,
+                     std::condition_variable& condition,
+                     double seconds,
+                     const std::function<bool()>& predicate) {
+            return WaitUntil(lock, condition, Now() + seconds, predicate);
+        }
+
+        void SleepUntil(double deadline);
+
+        void SleepFor(double seconds) {
+            SleepUntil(Now() + seconds);
+        }
+
+        // Must be called by the threads that wait on the clock once they are done with it, eg: before they exit.
+        virtual void OnThreadExit() {
+        }
+    };
+
+    // std::chrono::steady_clock.
+    class SystemClock final : public Clock {
+      public:
+        double Now() const override;
+        bool WaitUntil(std::unique_lock<std::mutex>& lock,
+                       std::condition_variable& condition,
+                       double deadline,
+                       const std::function<bool()>& predicate) override;
+    };
+
+    // A clock that only moves when told to, so that hours of behavior can be simulated in seconds, with the same
+    // timestamps on every run.
+    //
+    // Advancing steps through the deadlines of the pending waits in order: each waiter observes exactly its own
+    // deadline, and the clock only moves to the next step once the threads woken by this one are waiting again, or
+    // have called OnThreadExit().
+    //
+    // Runs are reproducible as long as the threads woken by a step only block on the clock, and hand their work to
+    // other threads within that step (eg: in the callback of a source). Threads woken by another thread rather than
+    // by the clock are not waited for, and the threads woken by the same step run concurrently. As a safety net, a
+    // thread that is still busy after k_BusyTimeout (real time), for example because it is blocked on a lock, is
+    // logged and no longer waited for: the rest of the run is then no longer guaranteed to be reproducible.
+    class VirtualClock final : public Clock {
+      public:
+        static constexpr auto k_BusyTimeout = std::chrono::milliseconds(100);
+
+        explicit VirtualClock(double startTime = 0.0) : m_now(startTime) {
+        }
+
+        double Now() const override {
+            return m_now.load(std::memory_order_acquire);
+        }
+
+        bool WaitUntil(std::unique_lock<std::mutex>& lock,
+                       std::condition_variable& condition,
+                       double deadline,
+                       const std::function<bool()>& predicate) override;
+
+        void Advance(double seconds) {
+            AdvanceTo(Now() + seconds);
+        }
+
+        void AdvanceTo(double time);
+
+        void OnThreadExit() override;
+
+        // Block until at least count waits are pending, eg: until the threads that were just started are settled, so
+        // that the next step does not depend on how fast they started.
+        void WaitForWaiters(size_t count);
+
+      private:
+        struct Waiter {
+            std::mutex* mutex;
+            std::condition_variable* condition;
+            double deadline;
+            uint64_t id;
+            std::thread::id threadId;
+        };
+
+        bool IsWaiting(uint64_t id) const;
+        void WakeDueWaiters(std::unique_lock<std::mutex>& lock);
+
+        std::atomic<double> m_now;
+
+        std::mutex m_advanceMutex;
+
+        // Protects the list of waiters. It is never held while blocking on the mutex of a waiter, since waiters take
+        // it with their own mutex held.
+        std::mutex m_mutex;
+        std::condition_variable m_waitersChanged;
+        std::vector<Waiter*> m_waiters;
+        uint64_t m_nextWaiterId = 0;
+
+        // Threads woken by the current step, that have not started waiting again.
+        std::vector<std::thread::id> m_busyThreads;
+    };
+
+    // The clock of the driver: the steady clock, or a VirtualClock when the virtualTime setting is enabled.
+    Clock& GetClock();
+
+    // Select the clock. Must be called before any thread uses it (see Driver::Init()).
+    void SetVirtualTime(bool enable);
+
+    // The virtual clock, or nullptr when virtual time is not enabled.
+    VirtualClock* GetVirtualClock();
+
+} // namespace eyetracking_core
@@ -0,0 +1,180 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <utility>
+
+#include "Clock.h"
+#include "ConsumerDemand.h"
+#include "Platform.h"
+#include "Tracing.h"
+
+namespace eyetracking_core {
+
+    ConsumerDemand::ConsumerDemand(bool alwaysOn, GazeExportWriter* exporter, std::function<void()> onDemand)
+        : m_alwaysOn(alwaysOn), m_exporter(exporter && exporter->IsOpen() ? exporter : nullptr),
+          m_onDemand(std::move(onDemand)) {
+        m_lastHeartbeatTime = GetClock().Now();
+        if (m_exporter) {
+            m_lastHeartbeat = m_exporter->GetHeartbeat();
+            m_thread = std::thread(&ConsumerDemand::WatchThread, this);
+        }
+    }
+
+    ConsumerDemand::~ConsumerDemand() {
+        if (m_thread.joinable()) {
+            m_stop = true;
+            m_exporter->SignalDemand();
+            m_thread.join();
+        }
+        if (m_exporter) {
+            m_exporter->SetIdle(false);
+        }
+    }
+
+    void ConsumerDemand::Subscribe(double seconds) {
+        m_subscriptionEnd = GetClock().Now() + seconds;
+        Wake();
+    }
+
+    void ConsumerDemand::Unsubscribe() {
+        m_subscriptionEnd = 0.0;
+    }
+
+    void ConsumerDemand::Reset() {
+        m_lastTime = GetClock().Now();
+        m_lastCpuTime = GetThreadCpuTime();
+    }
+
+    bool ConsumerDemand::Update() {
+        const double now = GetClock().Now();
+        const double cpuTime = GetThreadCpuTime();
+
+        if (m_exporter) {
+            const uint32_t heartbeat = m_exporter->GetHeartbeat();
+            if (heartbeat != m_lastHeartbeat) {
+                m_lastHeartbeat = heartbeat;
+                m_lastHeartbeatTime = now;
+            }
+        }
+        const bool hasReader = m_exporter && now - m_lastHeartbeatTime < k_HeartbeatTimeout;
+        const bool hasSubscription = now < m_subscriptionEnd.load();
+        bool isIdle = !m_alwaysOn && !hasReader && !hasSubscription;
+
+        // A reader only signals demand once it sees the idle flag: one that came back right before it was set shows
+        // in the heartbeat instead.
+        if (isIdle && !m_isIdle && m_exporter) {
+            m_exporter->SetIdle(true);
+            if (m_exporter->GetHeartbeat() != m_lastHeartbeat) {
+                m_lastHeartbeat = m_exporter->GetHeartbeat();
+                m_lastHeartbeatTime = now;
+                m_exporter->SetIdle(false);
+                isIdle = false;
+            }
+        }
+
+        {
+            std::unique_lock lock(m_statisticsMutex);
+            // The time since the previous update was spent at the previous rate.
+            if (m_isIdle) {
+                m_statistics.idleSeconds += now - m_lastTime;
+                m_statistics.idleCpuSeconds += cpuTime - m_lastCpuTime;
+            } else {
+                m_statistics.fullSeconds += now - m_lastTime;
+                m_statistics.fullCpuSeconds += cpuTime - m_lastCpuTime;
+            }
+        }
+        m_lastTime = now;
+        m_lastCpuTime = cpuTime;
+
+        if (isIdle != m_isIdle) {
+            TraceLoggingWrite(TraceProvider,
+                              "ConsumerDemand_Update",
+                              TLArg(isIdle, "Idle"),
+                              TLArg(hasReader, "Reader"),
+                              TLArg(hasSubscription, "Subscription"));
+            Log("Gaze consumers %s, switching to the %s rate",
+                isIdle ? "gone" : "back",
+                isIdle ? "keep-alive" : "full");
+            if (m_exporter) {
+                m_exporter->SetIdle(isIdle);
+            }
+            m_isIdle = isIdle;
+        }
+
+        return !isIdle;
+    }
+
+    ConsumerDemand::Statistics ConsumerDemand::GetStatistics() const {
+        std::unique_lock lock(m_statisticsMutex);
+        Statistics statistics = m_statistics;
+        if (statistics.fullSeconds > 0.0) {
+            const double fullCpuRate = statistics.fullCpuSeconds / statistics.fullSeconds;
+            statistics.savedCpuSeconds =
+                std::max(statistics.idleSeconds * fullCpuRate - statistics.idleCpuSeconds, 0.0);
+        }
+        return statistics;
+    }
+
+    void ConsumerDemand::ReportStatistics() const {
+        const Statistics statistics = GetStatistics();
+        TraceLoggingWrite(TraceProvider,
+                          "ConsumerDemand_Statistics",
+                          TLArg(statistics.fullSeconds, "FullSeconds"),
+                          TLArg(statistics.fullCpuSeconds, "FullCpuSeconds"),
+                          TLArg(statistics.idleSeconds, "IdleSeconds"),
+                          TLArg(statistics.idleCpuSeconds, "IdleCpuSeconds"),
+                          TLArg(statistics.savedCpuSeconds, "SavedCpuSeconds"));
+        Log("Gaze consumers: %.1f s at full rate (%.3f s CPU), %.1f s idle (%.3f s CPU), %.3f s CPU saved",
+            statistics.fullSeconds,
+            statistics.fullCpuSeconds,
+            statistics.idleSeconds,
+            statistics.idleCpuSeconds,
+            statistics.savedCpuSeconds);
+    }
+
+    void ConsumerDemand::WatchThread() {
+        TraceLocalActivity(local);
+        TraceLoggingWriteStart(local, "ConsumerDemand_WatchThread");
+
+        SetThreadName("ConsumerDemand_WatchThread");
+
+        // Readers only signal while the export is idle, so this thread sleeps while the gaze is consumed.
+        uint32_t demand = m_exporter->GetDemand();
+        while (!m_stop) {
+            if (m_exporter->WaitForDemand(demand, 1.0)) {
+                demand = m_exporter->GetDemand();
+                if (!m_stop) {
+                    Wake();
+                }
+            }
+        }
+
+        TraceLoggingWriteStop(local, "ConsumerDemand_WatchThread");
+    }
+
+    void ConsumerDemand::Wake() {
+        m_generation++;
+        m_onDemand();
+    }
+
+} // namespace eyetracking_core
@@ -0,0 +1,110 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "GazeExportChannel.h"
+
+namespace eyetracking_core {
+
+    // Decides whether anyone consumes the gaze, so that the update thread can drop to a keep-alive rate when nobody
+    // does. The consumers are the readers of the gaze export (through their heartbeat), the subscriptions of the host
+    // (eg: the DebugRequest() of the driver), and the consumers configured in the settings (recording, heatmap...),
+    // which are always on.
+    //
+    // While idle, a reader or a subscription calls onDemand right away, so that the update thread is back to its full
+    // rate within one sample period.
+    class ConsumerDemand {
+      public:
+        // Without any sign of life for this long, a reader of the export is gone.
+        static constexpr double k_HeartbeatTimeout = 1.0;
+
+        // exporter may be null. onDemand is called from any thread.
+        ConsumerDemand(bool alwaysOn, GazeExportWriter* exporter, std::function<void()> onDemand);
+        ~ConsumerDemand();
+
+        ConsumerDemand(const ConsumerDemand&) = delete;
+        ConsumerDemand& operator=(const ConsumerDemand&) = delete;
+
+        // Hold the full rate for the next seconds (until Unsubscribe()).
+        void Subscribe(double seconds);
+        void Unsubscribe();
+
+        // Incremented every time demand shows up, to end the wait of the update thread.
+        uint32_t GetGeneration() const {
+            return m_generation.load();
+        }
+
+        // Called from the update thread when it starts, so that the time it was stopped is not accounted for.
+        void Reset();
+
+        // Called from the update thread once per update. Returns whether it should run at its full rate.
+        bool Update();
+
+        bool IsIdle() const {
+            return m_isIdle.load();
+        }
+
+        // The time and the processor time of the update thread at each rate, and the processor time saved by idling
+        // (estimated from the cost of the full rate).
+        struct Statistics {
+            double fullSeconds;
+            double fullCpuSeconds;
+            double idleSeconds;
+            double idleCpuSeconds;
+            double savedCpuSeconds;
+        };
+        Statistics GetStatistics() const;
+        void ReportStatistics() const;
+
+      private:
+        void WatchThread();
+        void Wake();
+
+        const bool m_alwaysOn;
+        GazeExportWriter* const m_exporter;
+        const std::function<void()> m_onDemand;
+
+        std::atomic<uint32_t> m_generation = 0;
+        std::atomic<bool> m_isIdle = false;
+        std::atomic<double> m_subscriptionEnd = 0.0;
+
+        // Only touched by the update thread.
+        uint32_t m_lastHeartbeat = 0;
+        double m_lastHeartbeatTime = 0.0;
+        double m_lastTime = 0.0;
+        double m_lastCpuTime = 0.0;
+
+        mutable std::mutex m_statisticsMutex;
+        Statistics m_statistics{};
+
+        std::atomic<bool> m_stop = false;
+        std::thread m_thread;
+    };
+
+} // namespace eyetracking_core
@@ -0,0 +1,58 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <mutex>
+#include <utility>
+
+#include "EyeTrackerSource.h"
+
+namespace eyetracking_core {
+
+    bool PushEyeTrackerSource::GetLatestSample(EyeTrackerSample& sample) {
+        std::unique_lock lock(m_mutex);
+        sample = m_latestSample;
+        return m_hasSample;
+    }
+
+    bool PushEyeTrackerSource::StartCallbacks(SampleCallback callback) {
+        std::unique_lock lock(m_mutex);
+        m_callback = std::move(callback);
+        return true;
+    }
+
+    void PushEyeTrackerSource::StopCallbacks() {
+        std::unique_lock lock(m_mutex);
+        m_callback = nullptr;
+    }
+
+    void PushEyeTrackerSource::Deliver(const EyeTrackerSample& sample) {
+        // The callback is invoked with the lock held, which guarantees that StopCallbacks() does not return while a
+        // callback is in progress.
+        std::unique_lock lock(m_mutex);
+        m_latestSample = sample;
+        m_hasSample = true;
+        if (m_callback) {
+            m_callback(sample);
+        }
+    }
+
+} // namespace eyetracking_core
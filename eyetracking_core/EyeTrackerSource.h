@@ -0,0 +1,121 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace eyetracking_core {
+
+    struct EyeGazeTan {
+        float x = 0.f;
+        float y = 0.f;
+    };
+
+    // One reading from the eye tracker.
+    struct EyeTrackerSample {
+        double timeInSeconds = 0.0;
+        EyeGazeTan gazeTan[2]; // Left, Right
+        bool isValid = false;
+    };
+
+    // An EyeTrackerSource produces the samples for a device. Sources are either polled (the caller retrieves the
+    // latest sample at its own pace), or push samples through a callback as soon as they arrive. Push sources must
+    // still answer GetLatestSample() so that the caller can choose either mode.
+    class EyeTrackerSource {
+      public:
+        using SampleCallback = std::function<void(const EyeTrackerSample&)>;
+
+        virtual ~EyeTrackerSource() = default;
+
+        virtual const char* GetName() const = 0;
+
+        // Retrieve the most recent sample. Returns false if the tracker has no data available.
+        virtual bool GetLatestSample(EyeTrackerSample& sample) = 0;
+
+        // Whether StartCallbacks() is supported.
+        virtual bool SupportsCallback() const {
+            return false;
+        }
+
+        // Start delivering samples to callback, from a thread owned by the source.
+        virtual bool StartCallbacks([[maybe_unused]] SampleCallback callback) {
+            return false;
+        }
+
+        // Stop delivering samples. No callback is in progress or will be made once this returns.
+        virtual void StopCallbacks() {
+        }
+    };
+
+    // Common implementation for push sources: keeps the latest sample for polling and dispatches it to the callback.
+    class PushEyeTrackerSource : public EyeTrackerSource {
+      public:
+        bool GetLatestSample(EyeTrackerSample& sample) override;
+
+        bool SupportsCallback() const override {
+            return true;
+        }
+
+        bool StartCallbacks(SampleCallback callback) override;
+        void StopCallbacks() override;
+
+      protected:
+        // Called by the implementation whenever a new sample is available.
+        void Deliver(const EyeTrackerSample& sample);
+
+      private:
+        std::mutex m_mutex;
+        EyeTrackerSample m_latestSample;
+        bool m_hasSample = false;
+        SampleCallback m_callback;
+    };
+
+    // A source fed by hand, meant for test harnesses. Samples are pushed with Inject(), and can optionally be polled.
+    class StubEyeTrackerSource : public PushEyeTrackerSource {
+      public:
+        explicit StubEyeTrackerSource(bool supportsCallback = true) : m_supportsCallback(supportsCallback) {
+        }
+
+        const char* GetName() const override {
+            return "stub";
+        }
+
+        bool SupportsCallback() const override {
+            return m_supportsCallback;
+        }
+
+        void Inject(const EyeTrackerSample& sample) {
+            Deliver(sample);
+        }
+
+      private:
+        const bool m_supportsCallback;
+    };
+
+    std::shared_ptr<EyeTrackerSource> CreateReplayEyeTrackerSource(const std::string& path, bool loop);
+    std::shared_ptr<EyeTrackerSource> CreateSyntheticEyeTrackerSource();
+
+} // namespace eyetracking_core
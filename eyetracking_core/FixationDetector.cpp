@@ -0,0 +1,164 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cmath>
+
+#include "FixationDetector.h"
+#include "Platform.h"
+
+namespace {
+
+    constexpr float k_RadiansToDegrees = 180.f / 3.14159265f;
+
+} // namespace
+
+namespace eyetracking_core {
+
+    FixationDetector::FixationDetector(const Parameters& parameters)
+        : m_parameters(parameters),
+          m_window((size_t)std::ceil(std::max(parameters.minDuration * parameters.maxSampleRate, 0.0)) + 1),
+          m_yawExtents(m_window.GetCapacity()), m_pitchExtents(m_window.GetCapacity()) {
+    }
+
+    void FixationDetector::Process(GazeSample& sample) {
+        if (!sample.isValid) {
+            Reset();
+            return;
+        }
+
+        const WindowSample current{
+            sample.timeInSeconds, sample.yaw * k_RadiansToDegrees, sample.pitch * k_RadiansToDegrees};
+
+        if (m_inFixation) {
+            const float minYaw = std::min(m_fixationMinYaw, current.yaw);
+            const float maxYaw = std::max(m_fixationMaxYaw, current.yaw);
+            const float minPitch = std::min(m_fixationMinPitch, current.pitch);
+            const float maxPitch = std::max(m_fixationMaxPitch, current.pitch);
+            if ((maxYaw - minYaw) + (maxPitch - minPitch) > m_parameters.dispersion) {
+                // The fixation ended on the previous sample, this one starts a new window.
+                m_inFixation = false;
+                StartWindow(current);
+            } else {
+                m_fixationMinYaw = minYaw;
+                m_fixationMaxYaw = maxYaw;
+                m_fixationMinPitch = minPitch;
+                m_fixationMaxPitch = maxPitch;
+                m_fixationYawSum += current.yaw;
+                m_fixationPitchSum += current.pitch;
+                m_fixationCount++;
+            }
+        } else {
+            PushWindow(current);
+
+            // Slide the window until it is compact enough to be the beginning of a fixation.
+            while (GetWindowDispersion() > m_parameters.dispersion) {
+                PopWindow();
+            }
+
+            if (m_window.Back().time - m_window.Front().time >= m_parameters.minDuration) {
+                StartFixation();
+            }
+        }
+
+        sample.isFixation = m_inFixation;
+        if (m_inFixation) {
+            sample.fixationYaw = (float)(m_fixationYawSum / m_fixationCount) / k_RadiansToDegrees;
+            sample.fixationPitch = (float)(m_fixationPitchSum / m_fixationCount) / k_RadiansToDegrees;
+            sample.fixationDuration = (float)(current.time - m_fixationStart);
+        }
+    }
+
+    void FixationDetector::Reset() {
+        m_inFixation = false;
+        m_window.Clear();
+        m_yawExtents.Clear();
+        m_pitchExtents.Clear();
+        m_windowFirstSequence = m_nextSequence;
+        m_windowYawSum = m_windowPitchSum = 0.0;
+    }
+
+    void FixationDetector::PushWindow(const WindowSample& sample) {
+        if (m_window.IsFull()) {
+            // The stream is faster than maxSampleRate: a full window is compact, yet shorter than minDuration
+            // (otherwise the fixation would have started), and dropping its oldest sample keeps it short.
+            if (!m_truncatedCount++) {
+                const double span = m_window.Back().time - m_window.Front().time;
+                Log("Fixation window of %zu samples only spans %.1f ms of the %.1f ms needed (%.0f Hz, above "
+                    "maxSampleRate %.0f Hz): no fixation can be detected at this rate",
+                    m_window.GetSize(),
+                    span * 1000.0,
+                    m_parameters.minDuration * 1000.0,
+                    span > 0.0 ? (m_window.GetSize() - 1) / span : 0.0,
+                    m_parameters.maxSampleRate);
+            }
+            PopWindow();
+        }
+
+        const uint64_t sequence = m_nextSequence++;
+        m_window.PushBack(sample);
+        m_yawExtents.Push(sequence, sample.yaw);
+        m_pitchExtents.Push(sequence, sample.pitch);
+        m_windowYawSum += sample.yaw;
+        m_windowPitchSum += sample.pitch;
+    }
+
+    void FixationDetector::PopWindow() {
+        const WindowSample& oldest = m_window.Front();
+        m_windowYawSum -= oldest.yaw;
+        m_windowPitchSum -= oldest.pitch;
+        m_window.PopFront();
+
+        m_windowFirstSequence++;
+        m_yawExtents.Evict(m_windowFirstSequence);
+        m_pitchExtents.Evict(m_windowFirstSequence);
+    }
+
+    float FixationDetector::GetWindowDispersion() const {
+        if (m_window.IsEmpty()) {
+            return 0.f;
+        }
+        return (m_yawExtents.GetMax() - m_yawExtents.GetMin()) + (m_pitchExtents.GetMax() - m_pitchExtents.GetMin());
+    }
+
+    void FixationDetector::StartFixation() {
+        m_inFixation = true;
+        m_fixationStart = m_window.Front().time;
+        m_fixationMinYaw = m_yawExtents.GetMin();
+        m_fixationMaxYaw = m_yawExtents.GetMax();
+        m_fixationMinPitch = m_pitchExtents.GetMin();
+        m_fixationMaxPitch = m_pitchExtents.GetMax();
+        m_fixationYawSum = m_windowYawSum;
+        m_fixationPitchSum = m_windowPitchSum;
+        m_fixationCount = m_window.GetSize();
+
+        // The window is not needed until the fixation ends.
+        Reset();
+        m_inFixation = true;
+    }
+
+    void FixationDetector::StartWindow(const WindowSample& sample) {
+        Reset();
+        PushWindow(sample);
+    }
+
+} // namespace eyetracking_core
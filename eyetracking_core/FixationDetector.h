@@ -0,0 +1,97 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "FixedRing.h"
+#include "GazePipeline.h"
+
+namespace eyetracking_core {
+
+    // Dispersion-threshold (I-DT) fixation detector running incrementally on the gaze stream.
+    //
+    // Before a fixation is found, the window is a sliding window ending at the latest sample, whose dispersion is kept
+    // in O(1) amortized time by monotonic min/max deques. The window never spans more than the minimum fixation
+    // duration, which bounds its size. Once a fixation is found, the window only grows until the dispersion is
+    // exceeded, so running extremes are sufficient. Memory is allocated once, at construction.
+    class FixationDetector : public GazeStage {
+      public:
+        struct Parameters {
+            float dispersion = 1.f; // Degrees, (max yaw - min yaw) + (max pitch - min pitch).
+            double minDuration = 0.1;
+            // Sizes the window. On a faster stream, the window fills up before it spans minDuration, and no fixation
+            // is found (see GetTruncatedCount()).
+            float maxSampleRate = 1000.f;
+        };
+
+        FixationDetector() : FixationDetector(Parameters()) {
+        }
+        explicit FixationDetector(const Parameters& parameters);
+
+        const char* GetName() const override {
+            return "FixationDetector";
+        }
+
+        void Process(GazeSample& sample) override;
+        void Reset() override;
+
+        // The number of samples that were dropped from a full window shorter than minDuration, because the stream was
+        // faster than maxSampleRate. The first occurrence is also logged.
+        uint64_t GetTruncatedCount() const {
+            return m_truncatedCount;
+        }
+
+      private:
+        struct WindowSample {
+            double time;
+            float yaw;   // Degrees.
+            float pitch; // Degrees.
+        };
+
+        void PushWindow(const WindowSample& sample);
+        void PopWindow();
+        float GetWindowDispersion() const;
+        void StartFixation();
+        void StartWindow(const WindowSample& sample);
+
+        const Parameters m_parameters;
+
+        FixedRing<WindowSample> m_window;
+        MonotonicMinMax<float> m_yawExtents;
+        MonotonicMinMax<float> m_pitchExtents;
+        uint64_t m_windowFirstSequence = 0;
+        uint64_t m_nextSequence = 0;
+        double m_windowYawSum = 0.0;
+        double m_windowPitchSum = 0.0;
+
+        bool m_inFixation = false;
+        double m_fixationStart = 0.0;
+        float m_fixationMinYaw = 0.f, m_fixationMaxYaw = 0.f;
+        float m_fixationMinPitch = 0.f, m_fixationMaxPitch = 0.f;
+        double m_fixationYawSum = 0.0;
+        double m_fixationPitchSum = 0.0;
+        uint64_t m_fixationCount = 0;
+
+        uint64_t m_truncatedCount = 0;
+    };
+
+} // namespace eyetracking_core
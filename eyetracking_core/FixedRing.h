@@ -0,0 +1,172 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "Arena.h"
+
+namespace eyetracking_core {
+
+    // A double-ended queue with a capacity fixed at construction. No memory is allocated after construction.
+    template <typename T>
+    class FixedRing {
+      public:
+        explicit FixedRing(size_t capacity, Arena* arena = nullptr) : m_entries(capacity, arena) {
+        }
+
+        size_t GetCapacity() const {
+            return m_entries.size();
+        }
+
+        size_t GetSize() const {
+            return m_size;
+        }
+
+        bool IsEmpty() const {
+            return m_size == 0;
+        }
+
+        bool IsFull() const {
+            return m_size == m_entries.size();
+        }
+
+        void Clear() {
+            m_head = m_size = 0;
+        }
+
+        T& Front() {
+            assert(m_size);
+            return m_entries[m_head];
+        }
+
+        const T& Front() const {
+            assert(m_size);
+            return m_entries[m_head];
+        }
+
+        T& Back() {
+            assert(m_size);
+            return m_entries[Wrap(m_head + m_size - 1)];
+        }
+
+        const T& Back() const {
+            assert(m_size);
+            return m_entries[Wrap(m_head + m_size - 1)];
+        }
+
+        // Index 0 is the front.
+        const T& operator[](size_t index) const {
+            assert(index < m_size);
+            return m_entries[Wrap(m_head + index)];
+        }
+
+        void PushBack(const T& value) {
+            assert(!IsFull());
+            m_entries[Wrap(m_head + m_size)] = value;
+            m_size++;
+        }
+
+        void PopFront() {
+            assert(m_size);
+            m_head = Wrap(m_head + 1);
+            m_size--;
+        }
+
+        void PopBack() {
+            assert(m_size);
+            m_size--;
+        }
+
+      private:
+        size_t Wrap(size_t index) const {
+            return index < m_entries.size() ? index : index - m_entries.size();
+        }
+
+        ArenaArray<T> m_entries;
+        size_t m_head = 0;
+        size_t m_size = 0;
+    };
+
+    // Tracks the minimum and maximum of a sliding window in O(1) amortized time per value, using a pair of monotonic
+    // deques. Values are identified by increasing sequence numbers, and leave the window through Evict().
+    template <typename T>
+    class MonotonicMinMax {
+      public:
+        // capacity is the maximum number of values in the window.
+        explicit MonotonicMinMax(size_t capacity, Arena* arena = nullptr)
+            : m_min(capacity, arena), m_max(capacity, arena) {
+        }
+
+        void Push(uint64_t sequence, T value) {
+            while (!m_min.IsEmpty() && !(m_min.Back().value < value)) {
+                m_min.PopBack();
+            }
+            m_min.PushBack({sequence, value});
+
+            while (!m_max.IsEmpty() && !(value < m_max.Back().value)) {
+                m_max.PopBack();
+            }
+            m_max.PushBack({sequence, value});
+        }
+
+        // Remove all values with a sequence number lower than firstSequence.
+        void Evict(uint64_t firstSequence) {
+            while (!m_min.IsEmpty() && m_min.Front().sequence < firstSequence) {
+                m_min.PopFront();
+            }
+            while (!m_max.IsEmpty() && m_max.Front().sequence < firstSequence) {
+                m_max.PopFront();
+            }
+        }
+
+        void Clear() {
+            m_min.Clear();
+            m_max.Clear();
+        }
+
+        bool IsEmpty() const {
+            return m_min.IsEmpty();
+        }
+
+        T GetMin() const {
+            return m_min.Front().value;
+        }
+
+        T GetMax() const {
+            return m_max.Front().value;
+        }
+
+      private:
+        struct Entry {
+            uint64_t sequence;
+            T value;
+        };
+
+        FixedRing<Entry> m_min;
+        FixedRing<Entry> m_max;
+    };
+
+} // namespace eyetracking_core
@@ -0,0 +1,76 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "GazePipeline.h"
+#include "SavitzkyGolay.h"
+
+namespace eyetracking_core {
+
+    // Estimates the angular velocity and acceleration of the gaze with a causal Savitzky-Golay differentiator, which is
+    // far less noisy than a finite difference of consecutive samples.
+    template <size_t Window, size_t Order>
+    class GazeDerivativeStage : public GazeStage {
+        static_assert(Order >= 2, "Acceleration requires a polynomial of order 2 or more");
+
+      public:
+        const char* GetName() const override {
+            return "GazeDerivativeStage";
+        }
+
+        void Process(GazeSample& sample) override {
+            if (!sample.isValid) {
+                m_differentiator.Reset();
+                return;
+            }
+
+            // A sample repeated by the source (same timestamp) keeps the estimate of the original one.
+            constexpr float k_RadiansToDegrees = 180.f / 3.14159265f;
+            m_differentiator.Push(sample.timeInSeconds,
+                                  {sample.yaw * k_RadiansToDegrees, sample.pitch * k_RadiansToDegrees});
+
+            float derivatives[Order + 1][2];
+            if (m_differentiator.GetDerivatives(derivatives)) {
+                const float(&velocity)[2] = derivatives[1];
+                const float(&acceleration)[2] = derivatives[2];
+                // Horizontal angles shrink towards the poles.
+                const float cosPitch = cosf(sample.pitch);
+                sample.hasDerivatives = true;
+                sample.velocityYaw = velocity[0];
+                sample.velocityPitch = velocity[1];
+                sample.angularVelocity =
+                    sqrtf(velocity[0] * velocity[0] * cosPitch * cosPitch + velocity[1] * velocity[1]);
+                sample.angularAcceleration =
+                    sqrtf(acceleration[0] * acceleration[0] * cosPitch * cosPitch + acceleration[1] * acceleration[1]);
+            }
+        }
+
+        void Reset() override {
+            m_differentiator.Reset();
+        }
+
+      private:
+        SavitzkyGolayDifferentiator<Window, Order, 2> m_differentiator;
+    };
+
+} // namespace eyetracking_core
@@ -0,0 +1,142 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cmath>
+
+#include "GazeEventDetector.h"
+#include "GazeEvents.h"
+
+namespace eyetracking_core {
+
+    void GazeEventDetector::Process(GazeSample& sample) {
+        const double now = sample.timeInSeconds;
+
+        if (!sample.isValid) {
+            if (!m_isInvalid) {
+                m_isInvalid = true;
+                m_invalidStart = now;
+                if (m_inFixation) {
+                    EndFixation(sample, now);
+                }
+                ResetFixationCandidate();
+                m_inSaccade = false;
+            }
+            m_hasPrevious = false;
+            return;
+        }
+
+        if (m_isInvalid) {
+            m_isInvalid = false;
+
+            // Short losses of tracking are blinks, longer ones are the headset being removed or the tracker failing.
+            const double duration = now - m_invalidStart;
+            if (duration >= m_parameters.minBlinkDuration && duration <= m_parameters.maxBlinkDuration) {
+                sample.events |= GazeEvent_Blink;
+                sample.eventDuration = (float)duration;
+                sample.eventYaw = sample.yaw;
+                sample.eventPitch = sample.pitch;
+            }
+        }
+
+        // Prefer the smoothed velocity from GazeDerivativeStage when it is in the pipeline.
+        float velocity = sample.angularVelocity;
+        const bool hasVelocity = sample.hasDerivatives || (m_hasPrevious && now > m_previousTime);
+        if (!sample.hasDerivatives && hasVelocity) {
+            const float cosAngle = sample.direction[0] * m_previousDirection[0] +
+                                   sample.direction[1] * m_previousDirection[1] +
+                                   sample.direction[2] * m_previousDirection[2];
+            const float angle = acosf(std::clamp(cosAngle, -1.f, 1.f)) * 180.f / 3.14159265f;
+            velocity = (float)(angle / (now - m_previousTime));
+        }
+
+        m_hasPrevious = true;
+        m_previousTime = now;
+        m_previousDirection[0] = sample.direction[0];
+        m_previousDirection[1] = sample.direction[1];
+        m_previousDirection[2] = sample.direction[2];
+
+        if (!hasVelocity) {
+            return;
+        }
+
+        if (velocity >= m_parameters.saccadeVelocity) {
+            if (!m_inSaccade) {
+                if (m_inFixation) {
+                    EndFixation(sample, now);
+                }
+                m_inSaccade = true;
+                sample.events |= GazeEvent_SaccadeOnset;
+                if (!(sample.events & GazeEvent_FixationEnd)) {
+                    sample.eventYaw = sample.yaw;
+                    sample.eventPitch = sample.pitch;
+                }
+            }
+            ResetFixationCandidate();
+            return;
+        }
+
+        if (velocity <= m_parameters.fixationVelocity) {
+            m_inSaccade = false;
+            if (m_fixationStart < 0) {
+                m_fixationStart = now;
+            }
+        }
+
+        // Between both thresholds, keep accumulating into any ongoing fixation or candidate.
+        if (m_fixationStart >= 0) {
+            m_fixationYawSum += sample.yaw;
+            m_fixationPitchSum += sample.pitch;
+            m_fixationCount++;
+
+            if (!m_inFixation && now - m_fixationStart >= m_parameters.minFixationDuration) {
+                m_inFixation = true;
+                sample.events |= GazeEvent_FixationStart;
+                sample.eventYaw = (float)(m_fixationYawSum / m_fixationCount);
+                sample.eventPitch = (float)(m_fixationPitchSum / m_fixationCount);
+            }
+        }
+    }
+
+    void GazeEventDetector::Reset() {
+        m_hasPrevious = false;
+        m_inSaccade = false;
+        m_inFixation = false;
+        m_isInvalid = false;
+        ResetFixationCandidate();
+    }
+
+    void GazeEventDetector::EndFixation(GazeSample& sample, double endTime) {
+        sample.events |= GazeEvent_FixationEnd;
+        sample.eventDuration = (float)(endTime - m_fixationStart);
+        sample.eventYaw = (float)(m_fixationYawSum / m_fixationCount);
+        sample.eventPitch = (float)(m_fixationPitchSum / m_fixationCount);
+        m_inFixation = false;
+    }
+
+    void GazeEventDetector::ResetFixationCandidate() {
+        m_fixationStart = -1.0;
+        m_fixationYawSum = m_fixationPitchSum = 0.0;
+        m_fixationCount = 0;
+    }
+
+} // namespace eyetracking_core
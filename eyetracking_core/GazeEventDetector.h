@@ -0,0 +1,75 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "GazePipeline.h"
+
+namespace eyetracking_core {
+
+    // Velocity-threshold (I-VT) classifier raising discrete GazeEventType events on the samples where they occur.
+    // Every event is raised exactly once: each transition of the classifier state produces one event.
+    class GazeEventDetector : public GazeStage {
+      public:
+        struct Parameters {
+            float saccadeVelocity = 75.f;     // Degrees per second.
+            float fixationVelocity = 30.f;    // Degrees per second.
+            double minFixationDuration = 0.08;
+            double minBlinkDuration = 0.05;
+            double maxBlinkDuration = 0.5;
+        };
+
+        GazeEventDetector() = default;
+        explicit GazeEventDetector(const Parameters& parameters) : m_parameters(parameters) {
+        }
+
+        const char* GetName() const override {
+            return "GazeEventDetector";
+        }
+
+        void Process(GazeSample& sample) override;
+        void Reset() override;
+
+      private:
+        void EndFixation(GazeSample& sample, double endTime);
+        void ResetFixationCandidate();
+
+        const Parameters m_parameters;
+
+        bool m_hasPrevious = false;
+        double m_previousTime = 0.0;
+        float m_previousDirection[3]{};
+
+        bool m_inSaccade = false;
+
+        // Candidate or ongoing fixation.
+        bool m_inFixation = false;
+        double m_fixationStart = -1.0;
+        double m_fixationYawSum = 0.0;
+        double m_fixationPitchSum = 0.0;
+        uint32_t m_fixationCount = 0;
+
+        bool m_isInvalid = false;
+        double m_invalidStart = 0.0;
+    };
+
+} // namespace eyetracking_core
@@ -0,0 +1,60 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+
+// Gaze events are delivered to applications and overlays as vendor-specific events on the HMD device, through
+// IVRServerDriverHost::VendorSpecificEvent(). This header only depends on standard types, so that clients can include
+// it directly.
+namespace eyetracking_core {
+
+    enum GazeEventType : uint32_t {
+        GazeEvent_FixationStart = 1 << 0,
+        GazeEvent_FixationEnd = 1 << 1,
+        GazeEvent_SaccadeOnset = 1 << 2,
+        GazeEvent_Blink = 1 << 3,
+    };
+
+    // The OpenVR event type for each event is k_GazeEventBase + log2(GazeEventType), ie: FixationStart is
+    // k_GazeEventBase + 0, Blink is k_GazeEventBase + 3. This is within the VREvent_VendorSpecific_Reserved range.
+    constexpr uint32_t k_GazeEventBase = 10000 /* VREvent_VendorSpecific_Reserved_Start */ + 0x450;
+    constexpr uint32_t k_GazeEventCount = 4;
+    static_assert(k_GazeEventBase + k_GazeEventCount - 1 <= 19999 /* VREvent_VendorSpecific_Reserved_End */,
+                  "Gaze events must be vendor-specific events");
+
+    // Payload of the event, stored at the beginning of VREvent_Data_t::reserved.
+    struct GazeEventData {
+        uint32_t version;
+        uint32_t type;       // GazeEventType
+        double timeInSeconds; // Time of the sample where the event was detected, in the tracker's clock.
+        float duration;      // Seconds. For FixationEnd: fixation duration. For Blink: time with no valid gaze.
+        float yaw;           // Radians. Gaze at the time of the event (fixation: centroid).
+        float pitch;         // Radians.
+        uint32_t reserved;
+    };
+    static_assert(sizeof(GazeEventData) <= 48, "Must fit in VREvent_Reserved_t");
+
+    constexpr uint32_t k_GazeEventDataVersion = 1;
+
+} // namespace eyetracking_core
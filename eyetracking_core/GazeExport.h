@@ -0,0 +1,107 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Applications and tools can read the gaze computed by the driver through shared memory, without going through
+// SteamVR. This header only depends on standard types, so that clients can include it directly.
+//
+// The driver creates a named shared memory (k_GazeExportName) holding a GazeExportHeader, and writes every sample to
+// `latest`. `sequence` is odd while the driver is writing: readers should retry if it is odd or changed while they were
+// reading the sample, but only a bounded number of times, since a driver that stopped while writing leaves it odd until
+// it restarts (it then makes it even again, with an invalid sample).
+//
+// Rather than polling, readers can block until `sequence` changes: increment `waiters`, check `sequence` again, wait,
+// then decrement `waiters`. On Linux, the wait is a FUTEX_WAIT (not private) on `sequence`. On Windows, it is a wait on
+// the named semaphore k_GazeExportSemaphoreName, which the driver releases once per waiter: a reader may be woken
+// without a new sample (eg: after another reader timed out), and must check `sequence` again. The driver only signals
+// when `waiters` is not zero, so that exporting costs nothing to the update thread when nobody waits.
+//
+// Readers that must not lose samples read the ring of the last `ringCapacity` samples that follows the header instead.
+// Samples are numbered from 0, and sample n is stored in slot n % ringCapacity. `ringHead` is the number of samples
+// published so far. Each slot has its own sequence: 2n + 1 while sample n is being written, 2n + 2 once it is complete.
+// Each reader keeps its own cursor (the number of the next sample to read): samples older than ringHead - ringCapacity
+// were overwritten, as was a sample whose slot sequence does not match (before or after copying it). The driver never
+// waits for readers.
+//
+// The driver may slow down the eye tracker when nobody consumes the gaze. Readers tell it that they are there by
+// incrementing `heartbeat` at least every k_GazeExportHeartbeatMs. When `idle` is not zero, the driver is running at a
+// reduced rate: a reader that needs the full rate back right away also increments `demand` and wakes the driver (Linux:
+// FUTEX_WAKE on `demand`; Windows: set the named event k_GazeExportDemandEventName).
+//
+// GazeExportReader (GazeExportChannel.h) implements these protocols.
+namespace eyetracking_core {
+
+#ifdef _WIN32
+    constexpr const char* k_GazeExportName = "Local\\PimaxEyeTrackingGaze";
+    constexpr const char* k_GazeExportSemaphoreName = "Local\\PimaxEyeTrackingGazeReady";
+    constexpr const char* k_GazeExportDemandEventName = "Local\\PimaxEyeTrackingGazeDemand";
+#else
+    constexpr const char* k_GazeExportName = "/PimaxEyeTrackingGaze";
+#endif
+    constexpr uint32_t k_GazeExportMagic = 0x5A414750; // 'PGAZ'
+    constexpr uint32_t k_GazeExportVersion = 3;
+    constexpr uint32_t k_GazeExportHeartbeatMs = 250;
+
+    enum GazeExportFlags : uint32_t {
+        GazeExportFlags_Valid = 1 << 0,
+        GazeExportFlags_Fixation = 1 << 1,
+    };
+
+    struct GazeExportSample {
+        double timeInSeconds; // Time of the gaze sample, in the tracker's clock.
+        float gazeTan[2][2];  // [eye][x/y]
+        float yaw;            // Radians.
+        float pitch;          // Radians.
+        float direction[3];   // Unit vector in head space (-Z forward).
+        uint32_t flags;       // GazeExportFlags.
+        uint32_t events;      // Bitmask of GazeEventType (see GazeEvents.h) detected on this sample.
+        uint32_t reserved[3];
+    };
+    static_assert(sizeof(GazeExportSample) == 64);
+
+    struct GazeExportSlot {
+        std::atomic<uint64_t> sequence;
+        uint64_t reserved;
+        GazeExportSample sample;
+    };
+    static_assert(sizeof(GazeExportSlot) == 80);
+
+    struct GazeExportHeader {
+        uint32_t magic;
+        uint32_t version;
+        std::atomic<uint32_t> sequence;
+        std::atomic<uint32_t> waiters;
+        uint32_t ringCapacity; // Number of GazeExportSlot following the header.
+        std::atomic<uint32_t> heartbeat;
+        std::atomic<uint64_t> ringHead;
+        std::atomic<uint32_t> idle;
+        std::atomic<uint32_t> demand;
+        uint32_t reserved[6];
+        GazeExportSample latest;
+    };
+    static_assert(sizeof(GazeExportHeader) == 128);
+
+} // namespace eyetracking_core
@@ -0,0 +1,424 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+
+#include "GazeExportChannel.h"
+#include "Tracing.h"
+
+namespace {
+    using namespace eyetracking_core;
+
+    // Readers are woken by at most this many releases of the semaphore per sample.
+    constexpr long k_MaxWaiters = 64;
+
+#ifdef _WIN32
+    HANDLE OpenExportSemaphore(bool create) {
+        const std::string name = k_GazeExportSemaphoreName;
+        const std::wstring wideName(name.begin(), name.end());
+        return create ? CreateSemaphoreW(nullptr, 0, k_MaxWaiters, wideName.c_str())
+                      : OpenSemaphoreW(SEMAPHORE_MODIFY_STATE | SYNCHRONIZE, FALSE, wideName.c_str());
+    }
+
+    // Auto-reset: the driver is the only one waiting on it.
+    HANDLE OpenDemandEvent(bool create) {
+        const std::string name = k_GazeExportDemandEventName;
+        const std::wstring wideName(name.begin(), name.end());
+        return create ? CreateEventW(nullptr, FALSE, FALSE, wideName.c_str())
+                      : OpenEventW(EVENT_MODIFY_STATE, FALSE, wideName.c_str());
+    }
+#elif defined(__linux__)
+    // The memory is shared between processes, so the futex cannot be FUTEX_PRIVATE_FLAG.
+    void FutexWait(std::atomic<uint32_t>& word, uint32_t value, double timeoutSeconds) {
+        timespec timeout{};
+        timeout.tv_sec = (time_t)timeoutSeconds;
+        timeout.tv_nsec = (long)((timeoutSeconds - (double)timeout.tv_sec) * 1e9);
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, value, &timeout, nullptr, 0);
+    }
+
+    void FutexWakeAll(std::atomic<uint32_t>& word) {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+    }
+#endif
+
+    void SignalDemand(GazeExportHeader* header, [[maybe_unused]] void* event) {
+        header->demand.fetch_add(1, std::memory_order_seq_cst);
+#ifdef _WIN32
+        SetEvent(event);
+#elif defined(__linux__)
+        FutexWakeAll(header->demand);
+#endif
+    }
+
+} // namespace
+
+namespace eyetracking_core {
+
+    GazeExportWriter::~GazeExportWriter() {
+        Close();
+    }
+
+    bool GazeExportWriter::Open() {
+        Close();
+
+        const size_t size = sizeof(GazeExportHeader) + k_RingCapacity * sizeof(GazeExportSlot);
+        if (!m_memory.Create(k_GazeExportName, size)) {
+            Log("Failed to create gaze export: %s", k_GazeExportName);
+            return false;
+        }
+#ifdef _WIN32
+        m_semaphore = OpenExportSemaphore(true);
+        m_demandEvent = OpenDemandEvent(true);
+        if (!m_semaphore || !m_demandEvent) {
+            Log("Failed to create gaze export events: %s", k_GazeExportSemaphoreName);
+            if (m_semaphore) {
+                CloseHandle(m_semaphore);
+                m_semaphore = nullptr;
+            }
+            if (m_demandEvent) {
+                CloseHandle(m_demandEvent);
+                m_demandEvent = nullptr;
+            }
+            m_memory.Close();
+            return false;
+        }
+#endif
+
+        // Readers left over from a previous session keep their count of waiters and their cursors.
+        GazeExportHeader* const header = reinterpret_cast<GazeExportHeader*>(m_memory.GetData());
+
+        // A previous session that stopped in the middle of a publish left the sequence odd, which readers would take
+        // as a write in progress forever: complete it with an invalid sample. A slot of the ring left in the same state
+        // is rewritten by the next publish, since ringHead was not incremented.
+        const uint32_t sequence = header->sequence.load(std::memory_order_relaxed);
+        if (sequence & 1) {
+            memset(&header->latest, 0, sizeof(header->latest));
+            header->sequence.store(sequence + 1, std::memory_order_release);
+        }
+
+        header->magic = k_GazeExportMagic;
+        header->version = k_GazeExportVersion;
+        header->ringCapacity = k_RingCapacity;
+        header->idle = 0;
+        m_header = header;
+        m_slots = reinterpret_cast<GazeExportSlot*>(header + 1);
+        m_publishedCount = m_signaledCount = 0;
+
+        return true;
+    }
+
+    void GazeExportWriter::Close() {
+        if (!m_header) {
+            return;
+        }
+
+        m_header = nullptr;
+        m_slots = nullptr;
+        m_memory.Close();
+#ifdef _WIN32
+        CloseHandle(m_semaphore);
+        m_semaphore = nullptr;
+        CloseHandle(m_demandEvent);
+        m_demandEvent = nullptr;
+#endif
+    }
+
+    void GazeExportWriter::Publish(const GazeSample& sample) {
+        GazeExportSample output{};
+        output.timeInSeconds = sample.timeInSeconds;
+        for (int eye = 0; eye < 2; eye++) {
+            output.gazeTan[eye][0] = sample.gazeTan[eye].x;
+            output.gazeTan[eye][1] = sample.gazeTan[eye].y;
+        }
+        output.yaw = sample.yaw;
+        output.pitch = sample.pitch;
+        std::copy(std::begin(sample.direction), std::end(sample.direction), output.direction);
+        output.flags = (sample.isValid ? (uint32_t)GazeExportFlags_Valid : 0) |
+                       (sample.isFixation ? (uint32_t)GazeExportFlags_Fixation : 0);
+        output.events = sample.events;
+
+        // The ring first, so that a reader woken for this sample finds it there.
+        const uint64_t index = m_header->ringHead.load(std::memory_order_relaxed);
+        GazeExportSlot& slot = m_slots[index % k_RingCapacity];
+        slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        memcpy(&slot.sample, &output, sizeof(output));
+        slot.sequence.store(2 * index + 2, std::memory_order_release);
+        m_header->ringHead.store(index + 1, std::memory_order_release);
+
+        const uint32_t sequence = m_header->sequence.load(std::memory_order_relaxed);
+        m_header->sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        memcpy(&m_header->latest, &output, sizeof(output));
+
+        // Sequentially consistent with the increment of waiters by the readers: either we see their increment, or they
+        // see the new sequence before waiting.
+        m_header->sequence.store(sequence + 2, std::memory_order_seq_cst);
+        m_publishedCount++;
+
+        const uint32_t waiters = m_header->waiters.load(std::memory_order_seq_cst);
+        if (!waiters) {
+            return;
+        }
+        m_signaledCount++;
+#ifdef _WIN32
+        ReleaseSemaphore(m_semaphore, std::min((long)waiters, k_MaxWaiters), nullptr);
+#elif defined(__linux__)
+        FutexWakeAll(m_header->sequence);
+#endif
+    }
+
+    void GazeExportWriter::ReportStatistics() const {
+        TraceLoggingWrite(TraceProvider,
+                          "GazeExportWriter_Statistics",
+                          TLArg(m_publishedCount, "Published"),
+                          TLArg(m_signaledCount, "Signaled"));
+        Log("Exported %llu gaze samples, signaled waiting readers for %llu",
+            (unsigned long long)m_publishedCount,
+            (unsigned long long)m_signaledCount);
+    }
+
+    bool GazeExportWriter::WaitForDemand(uint32_t demand, double timeoutSeconds) {
+        if (m_header->demand.load(std::memory_order_acquire) != demand) {
+            return true;
+        }
+#ifdef _WIN32
+        WaitForSingleObject(m_demandEvent, (DWORD)std::ceil(timeoutSeconds * 1000.0));
+#elif defined(__linux__)
+        FutexWait(m_header->demand, demand, timeoutSeconds);
+#else
+        std::this_thread::sleep_for(std::chrono::duration<double>(std::min(timeoutSeconds, 0.001)));
+#endif
+        return m_header->demand.load(std::memory_order_acquire) != demand;
+    }
+
+    void GazeExportWriter::SignalDemand() {
+#ifdef _WIN32
+        ::SignalDemand(m_header, m_demandEvent);
+#else
+        ::SignalDemand(m_header, nullptr);
+#endif
+    }
+
+    GazeExportReader::~GazeExportReader() {
+        Close();
+    }
+
+    bool GazeExportReader::Open() {
+        Close();
+
+        if (!m_memory.Open(k_GazeExportName)) {
+            return false;
+        }
+        const GazeExportHeader* const header = reinterpret_cast<const GazeExportHeader*>(m_memory.GetData());
+        if (m_memory.GetSize() < sizeof(GazeExportHeader) || header->magic != k_GazeExportMagic ||
+            header->version != k_GazeExportVersion || !header->ringCapacity ||
+            m_memory.GetSize() < sizeof(GazeExportHeader) + header->ringCapacity * sizeof(GazeExportSlot)) {
+            m_memory.Close();
+            return false;
+        }
+#ifdef _WIN32
+        m_semaphore = OpenExportSemaphore(false);
+        m_demandEvent = OpenDemandEvent(false);
+        if (!m_semaphore || !m_demandEvent) {
+            if (m_semaphore) {
+                CloseHandle(m_semaphore);
+                m_semaphore = nullptr;
+            }
+            if (m_demandEvent) {
+                CloseHandle(m_demandEvent);
+                m_demandEvent = nullptr;
+            }
+            m_memory.Close();
+            return false;
+        }
+#endif
+        m_header = reinterpret_cast<GazeExportHeader*>(m_memory.GetData());
+        m_slots = reinterpret_cast<const GazeExportSlot*>(m_header + 1);
+        m_nextHeartbeat = {};
+
+        return true;
+    }
+
+    void GazeExportReader::Close() {
+        if (!m_header) {
+            return;
+        }
+
+        m_header = nullptr;
+        m_slots = nullptr;
+        m_memory.Close();
+#ifdef _WIN32
+        CloseHandle(m_semaphore);
+        m_semaphore = nullptr;
+        CloseHandle(m_demandEvent);
+        m_demandEvent = nullptr;
+#endif
+    }
+
+    bool GazeExportReader::Read(GazeExportSample& sample, uint32_t& sequence) {
+        Heartbeat();
+        for (uint32_t attempt = 0; attempt < k_MaxReadAttempts; attempt++) {
+            const uint32_t current = m_header->sequence.load(std::memory_order_acquire);
+            if (current & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+            memcpy(&sample, &m_header->latest, sizeof(sample));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_header->sequence.load(std::memory_order_relaxed) == current) {
+                sequence = current;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool GazeExportReader::Wait(uint32_t sequence, double timeoutSeconds) {
+        Heartbeat();
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(timeoutSeconds);
+        while (true) {
+            const uint32_t current = m_header->sequence.load(std::memory_order_acquire);
+            if (current != sequence && !(current & 1)) {
+                return true;
+            }
+
+            const double remaining =
+                std::chrono::duration<double>(deadline - std::chrono::steady_clock::now()).count();
+            if (remaining <= 0.0) {
+                return false;
+            }
+            if (current & 1) {
+                // The driver is in the middle of writing the sample.
+                std::this_thread::yield();
+                continue;
+            }
+
+            m_header->waiters.fetch_add(1, std::memory_order_seq_cst);
+            if (m_header->sequence.load(std::memory_order_seq_cst) == sequence) {
+#ifdef _WIN32
+                WaitForSingleObject(m_semaphore, (DWORD)std::ceil(remaining * 1000.0));
+#elif defined(__linux__)
+                FutexWait(m_header->sequence, sequence, remaining);
+#else
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+#endif
+            }
+            m_header->waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    size_t GazeExportReader::ReadRing(uint64_t& cursor,
+                                      GazeExportSample* samples,
+                                      size_t count,
+                                      uint64_t& missed) {
+        Heartbeat();
+        const uint64_t capacity = m_header->ringCapacity;
+        size_t copied = 0;
+        while (copied < count) {
+            const uint64_t head = m_header->ringHead.load(std::memory_order_acquire);
+            if (cursor > head) {
+                // The driver restarted the numbering.
+                cursor = head;
+            }
+            if (head - cursor > capacity) {
+                // Overrun: catch up to the oldest sample still in the ring.
+                missed += head - cursor - capacity;
+                cursor = head - capacity;
+            }
+
+            const size_t available = (size_t)std::min<uint64_t>(head - cursor, count - copied);
+            if (!available) {
+                break;
+            }
+            for (size_t i = 0; i < available; i++) {
+                const GazeExportSlot& slot = m_slots[cursor % capacity];
+                const uint64_t expected = 2 * cursor + 2;
+                if (slot.sequence.load(std::memory_order_acquire) != expected) {
+                    break;
+                }
+                memcpy(&samples[copied], &slot.sample, sizeof(GazeExportSample));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) != expected) {
+                    break;
+                }
+                copied++;
+                cursor++;
+            }
+
+            // The writer lapped us while copying: the sample at cursor is lost, and maybe more.
+            if (copied < count && cursor < head) {
+                const uint64_t newHead = m_header->ringHead.load(std::memory_order_acquire);
+                const uint64_t oldest = newHead > capacity ? newHead - capacity : 0;
+                const uint64_t next = std::max(cursor + 1, oldest);
+                missed += next - cursor;
+                cursor = next;
+            }
+        }
+        return copied;
+    }
+
+    bool GazeExportReader::WaitRing(uint64_t cursor, double timeoutSeconds) {
+        // The head is updated before the sequence, so a sample published after reading the sequence wakes us up.
+        const uint32_t sequence = m_header->sequence.load(std::memory_order_acquire);
+        if (GetRingHead() > cursor) {
+            return true;
+        }
+        return Wait(sequence & ~1u, timeoutSeconds) || GetRingHead() > cursor;
+    }
+
+    void GazeExportReader::Heartbeat() {
+        const auto now = std::chrono::steady_clock::now();
+        if (now < m_nextHeartbeat) {
+            return;
+        }
+        // Twice per period, so that a reader calling at the period is never seen as gone.
+        m_nextHeartbeat = now + std::chrono::milliseconds(k_GazeExportHeartbeatMs / 2);
+
+        m_header->heartbeat.fetch_add(1, std::memory_order_seq_cst);
+        if (m_header->idle.load(std::memory_order_seq_cst)) {
+#ifdef _WIN32
+            ::SignalDemand(m_header, m_demandEvent);
+#else
+            ::SignalDemand(m_header, nullptr);
+#endif
+        }
+    }
+
+} // namespace eyetracking_core
@@ -0,0 +1,154 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "GazeExport.h"
+#include "GazePipeline.h"
+#include "Platform.h"
+
+namespace eyetracking_core {
+
+    // The driver side of the shared memory export (see GazeExport.h).
+    class GazeExportWriter {
+      public:
+        // About 4 s at 250 Hz.
+        static constexpr uint32_t k_RingCapacity = 1024;
+
+        GazeExportWriter() = default;
+        ~GazeExportWriter();
+
+        GazeExportWriter(const GazeExportWriter&) = delete;
+        GazeExportWriter& operator=(const GazeExportWriter&) = delete;
+
+        bool Open();
+        void Close();
+
+        bool IsOpen() const {
+            return m_header != nullptr;
+        }
+
+        // Must be called from one thread.
+        void Publish(const GazeSample& sample);
+
+        uint64_t GetPublishedCount() const {
+            return m_publishedCount;
+        }
+
+        // Samples published while at least one reader was waiting.
+        uint64_t GetSignaledCount() const {
+            return m_signaledCount;
+        }
+
+        // Log how often the readers had to be woken up.
+        void ReportStatistics() const;
+
+        // Incremented by the readers while they consume the gaze.
+        uint32_t GetHeartbeat() const {
+            return m_header->heartbeat.load(std::memory_order_relaxed);
+        }
+
+        // Tell the readers that the rate is reduced, so that they wake WaitForDemand() up when they need it back.
+        void SetIdle(bool idle) {
+            m_header->idle.store(idle ? 1 : 0, std::memory_order_seq_cst);
+        }
+
+        uint32_t GetDemand() const {
+            return m_header->demand.load(std::memory_order_acquire);
+        }
+
+        // Block until a reader signals demand (after GetDemand() returned demand). Returns false on timeout.
+        bool WaitForDemand(uint32_t demand, double timeoutSeconds);
+
+        // Wake WaitForDemand() up, eg: to stop the thread calling it.
+        void SignalDemand();
+
+      private:
+        SharedMemory m_memory;
+        GazeExportHeader* m_header = nullptr;
+        GazeExportSlot* m_slots = nullptr;
+#ifdef _WIN32
+        void* m_semaphore = nullptr;
+        void* m_demandEvent = nullptr;
+#endif
+
+        uint64_t m_publishedCount = 0;
+        uint64_t m_signaledCount = 0;
+    };
+
+    // The client side of the shared memory export.
+    class GazeExportReader {
+      public:
+        static constexpr uint32_t k_MaxReadAttempts = 1000;
+
+        GazeExportReader() = default;
+        ~GazeExportReader();
+
+        GazeExportReader(const GazeExportReader&) = delete;
+        GazeExportReader& operator=(const GazeExportReader&) = delete;
+
+        // Fails until the driver has created the export.
+        bool Open();
+        void Close();
+
+        bool IsOpen() const {
+            return m_header != nullptr;
+        }
+
+        // Copy the latest sample and its sequence number (pass it to Wait()). Fails if the sample was being written on
+        // every one of k_MaxReadAttempts attempts, eg: the driver stopped in the middle of writing it.
+        bool Read(GazeExportSample& sample, uint32_t& sequence);
+
+        // Block until a sample newer than sequence is published, without polling. Returns false on timeout.
+        bool Wait(uint32_t sequence, double timeoutSeconds);
+
+        // The number of samples published so far: a cursor to start reading the ring from the next sample.
+        uint64_t GetRingHead() const {
+            return m_header->ringHead.load(std::memory_order_acquire);
+        }
+
+        // Copy up to count samples from the ring, starting at cursor, and advance cursor past them. The samples that
+        // were overwritten before they could be read are skipped, and added to missed. Returns the number of samples
+        // copied, 0 when the reader is up to date.
+        size_t ReadRing(uint64_t& cursor, GazeExportSample* samples, size_t count, uint64_t& missed);
+
+        // Block until the ring has samples past cursor. Returns false on timeout.
+        bool WaitRing(uint64_t cursor, double timeoutSeconds);
+
+      private:
+        // Reading or waiting tells the driver that the gaze is consumed, and brings it back to full rate if needed.
+        void Heartbeat();
+
+        SharedMemory m_memory;
+        GazeExportHeader* m_header = nullptr;
+        const GazeExportSlot* m_slots = nullptr;
+#ifdef _WIN32
+        void* m_semaphore = nullptr;
+        void* m_demandEvent = nullptr;
+#endif
+        std::chrono::steady_clock::time_point m_nextHeartbeat{};
+    };
+
+} // namespace eyetracking_core
@@ -0,0 +1,116 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Arena.h"
+#include "GazePipeline.h"
+
+namespace eyetracking_core {
+
+    // Gaze angles binned on a grid of square cells of k_CellSize degrees, row-major from the top-left (highest pitch,
+    // lowest yaw). Values are the number of samples that landed in each cell, after decay.
+    struct GazeHeatmapGrid {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        float maxYaw = 0.f;   // Degrees, the grid spans [-maxYaw, maxYaw).
+        float maxPitch = 0.f; // Degrees, the grid spans [-maxPitch, maxPitch).
+        std::vector<float> cells;
+    };
+
+    struct GazeHeatmapSnapshot {
+        double timeInSeconds = 0.0;
+        uint64_t sampleCount = 0;
+        GazeHeatmapGrid head;
+        GazeHeatmapGrid world;
+    };
+
+    // Accumulates where the user looked, relative to the head and in the world (when the head pose is known), into
+    // fixed grids. Memory is allocated once at construction, from the arena when one is given.
+    //
+    // Decay is exponential with the given half-life, but the grid is not scaled on every sample: instead, each new
+    // sample is added with a weight that grows over time, and the grid is renormalized (a single vectorizable pass)
+    // only once the weight grows too large. A sample therefore costs an exponential and one increment per grid.
+    //
+    // Not thread-safe: TakeSnapshot() must be serialized with Add(), which only takes as long as copying the grids.
+    class GazeHeatmap {
+      public:
+        static constexpr float k_CellSize = 1.25f;
+        static constexpr float k_HeadMaxAngle = 60.f;
+
+        // A halfLife of 0 disables decay.
+        explicit GazeHeatmap(double halfLife = 0.0, Arena* arena = nullptr);
+
+        // worldDirection is the gaze as a unit vector in world space (-Z forward, +Y up), or nullptr if unknown.
+        void Add(const GazeSample& sample, const float* worldDirection);
+        void Clear();
+
+        void TakeSnapshot(GazeHeatmapSnapshot& snapshot) const;
+
+        uint64_t GetSampleCount() const {
+            return m_sampleCount;
+        }
+
+        // Samples outside of the head grid, or whose angles are not finite.
+        uint64_t GetOutOfRangeCount() const {
+            return m_outOfRangeCount;
+        }
+
+      private:
+        struct Layer {
+            uint32_t width;
+            uint32_t height;
+            float maxYaw;
+            float maxPitch;
+            ArenaArray<float> cells;
+        };
+
+        static Layer MakeLayer(float maxYaw, float maxPitch, Arena* arena);
+        bool Accumulate(Layer& layer, float yawDegrees, float pitchDegrees, bool wrapYaw);
+        void Renormalize(double timeInSeconds);
+        static void CopyLayer(const Layer& layer, float scale, GazeHeatmapGrid& grid);
+
+        // Weight at which the grid is scaled back, well within the precision of a float.
+        static constexpr float k_MaxWeight = 1024.f * 1024.f;
+
+        const double m_decayRate; // 1/s, 0 when disabled.
+        Layer m_head;
+        Layer m_world;
+
+        double m_epoch = 0.0;
+        bool m_hasEpoch = false;
+        double m_lastTime = 0.0;
+        float m_weight = 1.f;
+
+        uint64_t m_sampleCount = 0;
+        uint64_t m_outOfRangeCount = 0;
+    };
+
+    // Write each grid of the snapshot as a Portable Float Map (a grayscale float image that most image tools can read),
+    // to <pathPrefix>-head.pfm and <pathPrefix>-world.pfm.
+    bool WriteGazeHeatmap(const GazeHeatmapSnapshot& snapshot, const std::string& pathPrefix);
+
+} // namespace eyetracking_core
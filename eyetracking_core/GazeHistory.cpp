@@ -0,0 +1,291 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cmath>
+
+#include "GazeHistory.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    static_assert((GazeHistory::k_BucketsPerLevel & (GazeHistory::k_BucketsPerLevel - 1)) == 0,
+                  "The number of buckets must be a power of two");
+
+    int64_t FloorDiv(int64_t value, int64_t divisor) {
+        const int64_t quotient = value / divisor;
+        return (value % divisor < 0) ? quotient - 1 : quotient;
+    }
+
+    int64_t CeilDiv(int64_t value, int64_t divisor) {
+        return -FloorDiv(-value, divisor);
+    }
+
+    size_t GetSlot(int64_t index) {
+        return (size_t)((uint64_t)index & (GazeHistory::k_BucketsPerLevel - 1));
+    }
+
+} // namespace
+
+namespace eyetracking_core {
+
+    void GazeSummary::Add(bool isValid, float yaw, float pitch, bool hasDerivatives, float angularVelocity) {
+        sampleCount++;
+        if (isValid) {
+            validCount++;
+            Accumulate(Yaw, yaw);
+            Accumulate(Pitch, pitch);
+            if (hasDerivatives) {
+                Accumulate(AngularVelocity, angularVelocity);
+            }
+        }
+    }
+
+    void GazeSummary::Merge(const GazeSummary& other) {
+        sampleCount += other.sampleCount;
+        validCount += other.validCount;
+        for (int channel = 0; channel < ChannelCount; channel++) {
+            if (!other.count[channel]) {
+                continue;
+            }
+            if (count[channel]) {
+                min[channel] = std::min(min[channel], other.min[channel]);
+                max[channel] = std::max(max[channel], other.max[channel]);
+            } else {
+                min[channel] = other.min[channel];
+                max[channel] = other.max[channel];
+            }
+            count[channel] += other.count[channel];
+            sum[channel] += other.sum[channel];
+        }
+    }
+
+    void GazeSummary::Accumulate(Channel channel, float value) {
+        if (count[channel]) {
+            min[channel] = std::min(min[channel], value);
+            max[channel] = std::max(max[channel], value);
+        } else {
+            min[channel] = max[channel] = value;
+        }
+        count[channel]++;
+        sum[channel] += value;
+    }
+
+    GazeHistory::Level::Level(int64_t width, Arena* arena) : m_width(width), m_tree(2 * k_BucketsPerLevel, arena) {
+    }
+
+    void GazeHistory::Level::Add(int64_t ticks, const GazeSample& sample) {
+        const int64_t index = FloorDiv(ticks, m_width);
+        if (!m_hasOpen) {
+            m_hasOpen = true;
+            m_openIndex = m_firstIndex = m_oldestIndex = index;
+        } else if (index != m_openIndex) {
+            Store(m_openIndex, m_open);
+
+            // Empty the buckets skipped by a gap in the samples, which still hold summaries from a previous lap.
+            for (int64_t skipped = std::max(m_openIndex + 1, index - (int64_t)k_BucketsPerLevel + 1); skipped < index;
+                 skipped++) {
+                Store(skipped, {});
+            }
+
+            m_openIndex = index;
+            m_oldestIndex = std::max(m_oldestIndex, index - (int64_t)k_BucketsPerLevel + 1);
+            m_open = {};
+        }
+        m_open.Add(sample);
+    }
+
+    void GazeHistory::Level::Clear() {
+        m_hasOpen = false;
+        m_open = {};
+        std::fill(m_tree.begin(), m_tree.end(), GazeSummary{});
+    }
+
+    void GazeHistory::Level::Query(int64_t first, int64_t last, GazeSummary& result) const {
+        if (!m_hasOpen) {
+            return;
+        }
+
+        first = std::max(first, m_oldestIndex);
+        last = std::min(last, m_openIndex);
+        if (first > last) {
+            return;
+        }
+        if (last == m_openIndex) {
+            result.Merge(m_open);
+            last--;
+            if (first > last) {
+                return;
+            }
+        }
+
+        // The retained closed buckets span less than the ring, but the range may wrap around its end.
+        const size_t firstSlot = GetSlot(first);
+        const size_t lastSlot = GetSlot(last);
+        if (firstSlot <= lastSlot) {
+            QueryTree(firstSlot, lastSlot, result);
+        } else {
+            QueryTree(firstSlot, k_BucketsPerLevel - 1, result);
+            QueryTree(0, lastSlot, result);
+        }
+    }
+
+    int64_t GazeHistory::Level::GetOldestTicks() const {
+        if (!m_hasOpen) {
+            return INT64_MAX;
+        }
+        // Until the ring laps, the level holds every sample since the history started (like the raw samples), and
+        // ranges starting earlier need no rounding.
+        return m_oldestIndex == m_firstIndex ? INT64_MIN : m_oldestIndex * m_width;
+    }
+
+    void GazeHistory::Level::Store(int64_t index, const GazeSummary& summary) {
+        size_t node = k_BucketsPerLevel + GetSlot(index);
+        m_tree[node] = summary;
+        for (node /= 2; node; node /= 2) {
+            m_tree[node] = m_tree[2 * node];
+            m_tree[node].Merge(m_tree[2 * node + 1]);
+        }
+    }
+
+    void GazeHistory::Level::QueryTree(size_t firstSlot, size_t lastSlot, GazeSummary& result) const {
+        for (size_t left = firstSlot + k_BucketsPerLevel, right = lastSlot + k_BucketsPerLevel + 1; left < right;
+             left /= 2, right /= 2) {
+            if (left & 1) {
+                result.Merge(m_tree[left++]);
+            }
+            if (right & 1) {
+                result.Merge(m_tree[--right]);
+            }
+        }
+    }
+
+    GazeHistory::GazeHistory(Arena* arena)
+        : m_raw(k_MaxRawSamples, arena), m_levels{Level(k_TicksPerSecond / 100, arena),
+                                                  Level(k_TicksPerSecond / 10, arena),
+                                                  Level(k_TicksPerSecond, arena)} {
+    }
+
+    void GazeHistory::Add(const GazeSample& sample) {
+        const int64_t ticks = (int64_t)std::floor(sample.timeInSeconds * k_TicksPerSecond);
+        if (m_hasSamples && ticks < m_latestTicks) {
+            Clear();
+        }
+        m_hasSamples = true;
+        m_latestTicks = ticks;
+
+        const int64_t rawLimit = ticks - (int64_t)(k_RawSpan * k_TicksPerSecond);
+        while (!m_raw.IsEmpty() && (m_raw.IsFull() || m_raw.Front().ticks < rawLimit)) {
+            m_rawStartTicks = m_raw.Front().ticks + 1;
+            m_raw.PopFront();
+        }
+        m_raw.PushBack(
+            {ticks, sample.yaw, sample.pitch, sample.angularVelocity, sample.isValid, sample.hasDerivatives});
+
+        for (Level& level : m_levels) {
+            level.Add(ticks, sample);
+        }
+    }
+
+    void GazeHistory::Clear() {
+        m_raw.Clear();
+        m_rawStartTicks = INT64_MIN;
+        for (Level& level : m_levels) {
+            level.Clear();
+        }
+        m_hasSamples = false;
+        m_latestTicks = 0;
+    }
+
+    GazeSummary GazeHistory::Query(double startTime, double endTime) const {
+        GazeSummary result;
+        if (m_hasSamples) {
+            Cover(k_LevelCount,
+                  (int64_t)std::floor(startTime * k_TicksPerSecond),
+                  (int64_t)std::floor(endTime * k_TicksPerSecond),
+                  result);
+        }
+        return result;
+    }
+
+    void GazeHistory::Cover(size_t level, int64_t start, int64_t end, GazeSummary& result) const {
+        if (start >= end) {
+            return;
+        }
+
+        if (level == 0) {
+            // Binary search for the first sample, then only the samples within the range are visited.
+            size_t low = 0, high = m_raw.GetSize();
+            while (low < high) {
+                const size_t middle = (low + high) / 2;
+                if (m_raw[middle].ticks < start) {
+                    low = middle + 1;
+                } else {
+                    high = middle;
+                }
+            }
+            for (size_t i = low; i < m_raw.GetSize() && m_raw[i].ticks < end; i++) {
+                const RawSample& raw = m_raw[i];
+                result.Add(raw.isValid, raw.yaw, raw.pitch, raw.hasDerivatives, raw.angularVelocity);
+            }
+            return;
+        }
+
+        // Take the buckets entirely within the range from this level, and refine the edges from the next finer level
+        // when it still retains them.
+        const Level& summaries = m_levels[level - 1];
+        const int64_t width = summaries.GetWidth();
+        const int64_t finerStart = GetOldestTicks(level - 1);
+        int64_t first = CeilDiv(start, width);
+        int64_t last = FloorDiv(end, width) - 1;
+        if (first <= last) {
+            if (start < first * width) {
+                if (start >= finerStart) {
+                    Cover(level - 1, start, first * width, result);
+                } else {
+                    first = FloorDiv(start, width);
+                }
+            }
+            if ((last + 1) * width < end) {
+                if ((last + 1) * width >= finerStart) {
+                    Cover(level - 1, (last + 1) * width, end, result);
+                } else {
+                    last = CeilDiv(end, width) - 1;
+                }
+            }
+            summaries.Query(first, last, result);
+        } else if (start >= finerStart) {
+            Cover(level - 1, start, end, result);
+        } else {
+            summaries.Query(FloorDiv(start, width), CeilDiv(end, width) - 1, result);
+        }
+    }
+
+    int64_t GazeHistory::GetOldestTicks(size_t level) const {
+        if (level == 0) {
+            return m_raw.IsEmpty() ? INT64_MAX : m_rawStartTicks;
+        }
+        return m_levels[level - 1].GetOldestTicks();
+    }
+
+} // namespace eyetracking_core
@@ -0,0 +1,155 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Arena.h"
+#include "FixedRing.h"
+#include "GazePipeline.h"
+
+namespace eyetracking_core {
+
+    // Minimum, maximum and mean of the gaze over a span of time. Angles are in radians, velocities in degrees/s.
+    struct GazeSummary {
+        enum Channel { Yaw, Pitch, AngularVelocity, ChannelCount };
+
+        uint32_t sampleCount = 0;
+        uint32_t validCount = 0;
+
+        // Yaw and pitch are accumulated over valid samples, the angular velocity over samples with derivatives.
+        uint32_t count[ChannelCount]{};
+        float min[ChannelCount]{};
+        float max[ChannelCount]{};
+        double sum[ChannelCount]{};
+
+        void Add(const GazeSample& sample) {
+            Add(sample.isValid, sample.yaw, sample.pitch, sample.hasDerivatives, sample.angularVelocity);
+        }
+        void Add(bool isValid, float yaw, float pitch, bool hasDerivatives, float angularVelocity);
+        void Merge(const GazeSummary& other);
+
+        float GetMean(Channel channel) const {
+            return count[channel] ? (float)(sum[channel] / count[channel]) : 0.f;
+        }
+
+        float GetValidFraction() const {
+            return sampleCount ? (float)validCount / sampleCount : 0.f;
+        }
+
+      private:
+        void Accumulate(Channel channel, float value);
+    };
+
+    // History of the gaze over long windows, at decreasing resolutions: every sample for the last second, then
+    // summaries per 10 ms, 100 ms and 1 s buckets, each level retaining k_BucketsPerLevel buckets (about 10 s, 100 s
+    // and 17 min respectively).
+    //
+    // Adding a sample updates the open bucket of each level in O(1). Each level keeps its closed buckets in a segment
+    // tree, updated in O(log n) when a bucket closes, so that a range query combines a few tree queries and the raw
+    // samples at its edges, in logarithmic time.
+    //
+    // Timestamps must increase; a sample going back in time (eg: a looping replay) clears the history. Not thread-safe.
+    class GazeHistory {
+      public:
+        static constexpr size_t k_BucketsPerLevel = 1024;
+        static constexpr size_t k_MaxRawSamples = 2048;
+        static constexpr double k_RawSpan = 1.0;
+
+        // The rings and trees are carved from the arena when one is given.
+        explicit GazeHistory(Arena* arena = nullptr);
+
+        void Add(const GazeSample& sample);
+        void Clear();
+
+        // Summarize the samples within [startTime, endTime). Parts of the range older than the retention of a level
+        // are summarized from the next coarser level, and their edges are rounded outwards to its buckets.
+        GazeSummary Query(double startTime, double endTime) const;
+
+        bool IsEmpty() const {
+            return !m_hasSamples;
+        }
+
+        double GetLatestTime() const {
+            return m_latestTicks / (double)k_TicksPerSecond;
+        }
+
+      private:
+        // Timestamps are handled as integer microseconds, so that bucket boundaries are exact.
+        static constexpr int64_t k_TicksPerSecond = 1000000;
+
+        struct RawSample {
+            int64_t ticks;
+            float yaw;
+            float pitch;
+            float angularVelocity;
+            bool isValid;
+            bool hasDerivatives;
+        };
+
+        // One level of summaries: the open bucket, and a segment tree over the ring of closed buckets.
+        class Level {
+          public:
+            Level(int64_t width, Arena* arena);
+
+            void Add(int64_t ticks, const GazeSample& sample);
+            void Clear();
+
+            // Summarize buckets [first, last], clamped to the retained buckets.
+            void Query(int64_t first, int64_t last, GazeSummary& result) const;
+
+            int64_t GetWidth() const {
+                return m_width;
+            }
+
+            // Start of the oldest retained bucket, INT64_MIN when no bucket was dropped yet, or INT64_MAX when empty.
+            int64_t GetOldestTicks() const;
+
+          private:
+            void Store(int64_t index, const GazeSummary& summary);
+            void QueryTree(size_t firstSlot, size_t lastSlot, GazeSummary& result) const;
+
+            const int64_t m_width;
+            ArenaArray<GazeSummary> m_tree; // Leaves at [k_BucketsPerLevel, 2 * k_BucketsPerLevel).
+            bool m_hasOpen = false;
+            int64_t m_openIndex = 0;
+            int64_t m_firstIndex = 0;
+            int64_t m_oldestIndex = 0;
+            GazeSummary m_open;
+        };
+
+        // Summarize [start, end) from the given level (0 is the raw samples, 1..k_LevelCount the summaries).
+        void Cover(size_t level, int64_t start, int64_t end, GazeSummary& result) const;
+        int64_t GetOldestTicks(size_t level) const;
+
+        static constexpr size_t k_LevelCount = 3;
+
+        FixedRing<RawSample> m_raw;
+        int64_t m_rawStartTicks = INT64_MIN; // The raw samples are complete from this time.
+        Level m_levels[k_LevelCount];
+        bool m_hasSamples = false;
+        int64_t m_latestTicks = 0;
+    };
+
+} // namespace eyetracking_core
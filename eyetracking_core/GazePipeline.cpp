@@ -0,0 +1,117 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <utility>
+
+#include "GazePipeline.h"
+#include "Platform.h"
+#include "Tracing.h"
+
+namespace eyetracking_core {
+
+    GazeSample MakeGazeSample(const EyeTrackerSample& sample) {
+        GazeSample result;
+        result.timeInSeconds = sample.timeInSeconds;
+        result.isValid = sample.isValid;
+        result.gazeTan[0] = sample.gazeTan[0];
+        result.gazeTan[1] = sample.gazeTan[1];
+        if (sample.isValid) {
+            UpdateGazeAngles(result);
+        }
+        return result;
+    }
+
+    void UpdateGazeAngles(GazeSample& sample) {
+        // Compute the gaze pitch/yaw angles by averaging both eyes.
+        sample.yaw = atanf((sample.gazeTan[0].x + sample.gazeTan[1].x) / 2.f);
+        sample.pitch = atanf((sample.gazeTan[0].y + sample.gazeTan[1].y) / 2.f);
+        UpdateGazeDirection(sample);
+    }
+
+    void UpdateGazeDirection(GazeSample& sample) {
+        // Use polar coordinates to create a unit vector.
+        const float cosPitch = cosf(sample.pitch);
+        sample.direction[0] = sinf(sample.yaw) * cosPitch;
+        sample.direction[1] = sinf(sample.pitch);
+        sample.direction[2] = -cosf(sample.yaw) * cosPitch;
+    }
+
+    void GazePipeline::AddStage(std::unique_ptr<GazeStage> stage) {
+        Log("Adding gaze processing stage: %s", stage->GetName());
+        m_stages.push_back({std::move(stage), {}});
+    }
+
+    void GazePipeline::Process(GazeSample& sample) {
+        for (Entry& entry : m_stages) {
+            const auto start = std::chrono::steady_clock::now();
+            entry.stage->Process(sample);
+            const auto duration = std::chrono::steady_clock::now() - start;
+
+            entry.statistics.samples++;
+            entry.statistics.total += duration;
+            entry.statistics.max = std::max(entry.statistics.max, duration);
+        }
+    }
+
+    void GazePipeline::ProcessBatch(GazeSample* samples, size_t count) {
+        for (Entry& entry : m_stages) {
+            const auto start = std::chrono::steady_clock::now();
+            entry.stage->ProcessBatch(samples, count);
+            const auto duration = std::chrono::steady_clock::now() - start;
+
+            entry.statistics.samples += count;
+            entry.statistics.total += duration;
+            entry.statistics.max = std::max(entry.statistics.max, duration);
+        }
+    }
+
+    void GazePipeline::Reset() {
+        for (Entry& entry : m_stages) {
+            entry.stage->Reset();
+            entry.statistics = {};
+        }
+    }
+
+    void GazePipeline::ReportStatistics() const {
+        for (const Entry& entry : m_stages) {
+            const StageStatistics& statistics = entry.statistics;
+            const long long average =
+                statistics.samples ? (long long)(statistics.total.count() / statistics.samples) : 0;
+            TraceLoggingWrite(TraceProvider,
+                              "GazePipeline_StageStatistics",
+                              TLArg(entry.stage->GetName(), "Stage"),
+                              TLArg(statistics.samples, "Samples"),
+                              TLArg(average, "AverageNs"),
+                              TLArg((long long)statistics.max.count(), "MaxNs"));
+            Log("Stage %s: %llu samples, %lld ns average, %lld ns max",
+                entry.stage->GetName(),
+                statistics.samples,
+                average,
+                (long long)statistics.max.count());
+        }
+    }
+
+} // namespace eyetracking_core
@@ -0,0 +1,134 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "EyeTrackerSource.h"
+
+namespace eyetracking_core {
+
+    // A sample flowing through the processing pipeline. Stages may refine the gaze or attach derived data.
+    struct GazeSample {
+        double timeInSeconds = 0.0;
+        bool isValid = false;
+
+        // Raw per-eye readings from the tracker.
+        EyeGazeTan gazeTan[2];
+
+        // Combined gaze, as angles (radians) and as a unit vector in head space (-Z forward).
+        float yaw = 0.f;
+        float pitch = 0.f;
+        float direction[3] = {0.f, 0.f, -1.f};
+
+        // Angular velocity (degrees/s) and acceleration (degrees/s^2), when hasDerivatives is set.
+        bool hasDerivatives = false;
+        float velocityYaw = 0.f;
+        float velocityPitch = 0.f;
+        float angularVelocity = 0.f;
+        float angularAcceleration = 0.f;
+
+        // Ongoing fixation, if any: centroid (radians) and time since it started.
+        bool isFixation = false;
+        float fixationYaw = 0.f;
+        float fixationPitch = 0.f;
+        float fixationDuration = 0.f;
+
+        // Bitmask of GazeEventType detected on this sample. At most one of the events carries a duration or a position
+        // (eg: fixation end, blink), which is stored below.
+        uint32_t events = 0;
+        float eventDuration = 0.f;
+        float eventYaw = 0.f;
+        float eventPitch = 0.f;
+    };
+
+    // Build a pipeline sample from a tracker sample, by averaging both eyes.
+    GazeSample MakeGazeSample(const EyeTrackerSample& sample);
+
+    // Recompute yaw/pitch and the direction after a stage modified the per-eye readings.
+    void UpdateGazeAngles(GazeSample& sample);
+
+    // Recompute the direction after a stage modified yaw/pitch.
+    void UpdateGazeDirection(GazeSample& sample);
+
+    class GazeStage {
+      public:
+        virtual ~GazeStage() = default;
+
+        virtual const char* GetName() const = 0;
+        virtual void Process(GazeSample& sample) = 0;
+
+        // Process consecutive samples at once. Stages with a high per-call cost override this.
+        virtual void ProcessBatch(GazeSample* samples, size_t count) {
+            for (size_t i = 0; i < count; i++) {
+                Process(samples[i]);
+            }
+        }
+
+        // Forget any history, eg: upon re-activation.
+        virtual void Reset() {
+        }
+    };
+
+    // Runs samples through an ordered list of stages, and keeps track of the time spent in each stage.
+    class GazePipeline {
+      public:
+        struct StageStatistics {
+            uint64_t samples = 0;
+            std::chrono::nanoseconds total{};
+            std::chrono::nanoseconds max{};
+        };
+
+        void AddStage(std::unique_ptr<GazeStage> stage);
+        void Process(GazeSample& sample);
+        void ProcessBatch(GazeSample* samples, size_t count);
+        void Reset();
+
+        size_t GetStageCount() const {
+            return m_stages.size();
+        }
+
+        const GazeStage& GetStage(size_t index) const {
+            return *m_stages[index].stage;
+        }
+
+        const StageStatistics& GetStatistics(size_t index) const {
+            return m_stages[index].statistics;
+        }
+
+        // Log the per-sample cost of each stage.
+        void ReportStatistics() const;
+
+      private:
+        struct Entry {
+            std::unique_ptr<GazeStage> stage;
+            StageStatistics statistics;
+        };
+
+        std::vector<Entry> m_stages;
+    };
+
+} // namespace eyetracking_core
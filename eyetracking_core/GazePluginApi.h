@@ -0,0 +1,101 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Custom gaze processing stages (filters, calibration, classifiers...) can be loaded from shared libraries listed in
+// the "plugins" setting. This header only depends on the C standard library, so that plugins can be built with any
+// compiler or language that can export C functions.
+//
+// A plugin exports GazePlugin_GetInterface(), which returns a static GazePluginInterface. The driver calls process()
+// with a buffer of samples that it owns: the plugin modifies the samples in place and must not keep the pointer. The
+// driver measures the time spent in each plugin, and disables any plugin whose average cost exceeds the budget set in
+// the "pluginBudgetUs" setting.
+//
+// All functions of an instance are called from the same thread.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GAZE_PLUGIN_ABI_VERSION 1
+
+#ifdef _WIN32
+#define GAZE_PLUGIN_EXPORT __declspec(dllexport)
+#else
+#define GAZE_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+enum {
+    GAZE_PLUGIN_SAMPLE_VALID = 1 << 0,
+};
+
+typedef struct GazePluginSample {
+    double timeInSeconds; // In the tracker's clock.
+    uint32_t flags;       // GAZE_PLUGIN_SAMPLE_*. Clearing VALID drops the gaze for this sample.
+    float gazeTan[2][2];  // [left/right eye][x/y], tangent of the gaze angles.
+    float yaw;            // Radians, combined gaze. Recomputed by the driver if a plugin modifies gazeTan.
+    float pitch;          // Radians.
+    uint32_t reserved[7];
+} GazePluginSample;
+
+// The layout is part of the ABI: any change requires a new GAZE_PLUGIN_ABI_VERSION.
+#ifdef __cplusplus
+#define GAZE_PLUGIN_STATIC_ASSERT(condition) static_assert(condition, #condition)
+#else
+#define GAZE_PLUGIN_STATIC_ASSERT(condition) _Static_assert(condition, #condition)
+#endif
+GAZE_PLUGIN_STATIC_ASSERT(sizeof(GazePluginSample) == 64);
+GAZE_PLUGIN_STATIC_ASSERT(offsetof(GazePluginSample, timeInSeconds) == 0);
+GAZE_PLUGIN_STATIC_ASSERT(offsetof(GazePluginSample, flags) == 8);
+GAZE_PLUGIN_STATIC_ASSERT(offsetof(GazePluginSample, gazeTan) == 12);
+GAZE_PLUGIN_STATIC_ASSERT(offsetof(GazePluginSample, yaw) == 28);
+GAZE_PLUGIN_STATIC_ASSERT(offsetof(GazePluginSample, pitch) == 32);
+GAZE_PLUGIN_STATIC_ASSERT(offsetof(GazePluginSample, reserved) == 36);
+
+typedef struct GazePluginInterface {
+    uint32_t abiVersion; // GAZE_PLUGIN_ABI_VERSION
+    uint32_t sampleSize; // sizeof(GazePluginSample)
+    const char* name;
+
+    // Create an instance, with the configuration string from the settings (possibly empty). Returns NULL on failure.
+    void* (*create)(const char* config);
+    void (*destroy)(void* instance);
+
+    // Process a batch of samples in place, in chronological order. Returns 0 on success; on failure, the output is
+    // ignored and the plugin is disabled.
+    int32_t (*process)(void* instance, GazePluginSample* samples, uint32_t count);
+
+    // Forget any history, eg: when the headset is re-activated.
+    void (*reset)(void* instance);
+} GazePluginInterface;
+
+// The entry point. Returns NULL if the plugin does not support the driver's ABI version.
+typedef const GazePluginInterface* (*GazePlugin_GetInterfaceFn)(uint32_t hostAbiVersion);
+#define GAZE_PLUGIN_ENTRY_POINT "GazePlugin_GetInterface"
+
+#ifdef __cplusplus
+}
+#endif
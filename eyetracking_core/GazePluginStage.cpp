@@ -0,0 +1,223 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#include "GazePluginStage.h"
+#include "Platform.h"
+#include "Tracing.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    void* OpenLibrary(const std::string& path) {
+#ifdef _WIN32
+        return LoadLibraryA(path.c_str());
+#else
+        return dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+#endif
+    }
+
+    void* GetSymbol(void* library, const char* name) {
+#ifdef _WIN32
+        return reinterpret_cast<void*>(GetProcAddress(static_cast<HMODULE>(library), name));
+#else
+        return dlsym(library, name);
+#endif
+    }
+
+    void CloseLibrary(void* library) {
+#ifdef _WIN32
+        FreeLibrary(static_cast<HMODULE>(library));
+#else
+        dlclose(library);
+#endif
+    }
+
+    GazePluginSample ToPluginSample(const GazeSample& sample) {
+        GazePluginSample result{};
+        result.timeInSeconds = sample.timeInSeconds;
+        result.flags = sample.isValid ? GAZE_PLUGIN_SAMPLE_VALID : 0;
+        for (int eye = 0; eye < 2; eye++) {
+            result.gazeTan[eye][0] = sample.gazeTan[eye].x;
+            result.gazeTan[eye][1] = sample.gazeTan[eye].y;
+        }
+        result.yaw = sample.yaw;
+        result.pitch = sample.pitch;
+        return result;
+    }
+
+    void FromPluginSample(const GazePluginSample& result, GazeSample& sample) {
+        if (!sample.isValid) {
+            return;
+        }
+        if (!(result.flags & GAZE_PLUGIN_SAMPLE_VALID)) {
+            sample.isValid = false;
+            return;
+        }
+
+        bool gazeTanChanged = false;
+        for (int eye = 0; eye < 2; eye++) {
+            gazeTanChanged |=
+                result.gazeTan[eye][0] != sample.gazeTan[eye].x || result.gazeTan[eye][1] != sample.gazeTan[eye].y;
+            sample.gazeTan[eye].x = result.gazeTan[eye][0];
+            sample.gazeTan[eye].y = result.gazeTan[eye][1];
+        }
+        if (gazeTanChanged) {
+            UpdateGazeAngles(sample);
+        } else if (result.yaw != sample.yaw || result.pitch != sample.pitch) {
+            sample.yaw = result.yaw;
+            sample.pitch = result.pitch;
+            UpdateGazeDirection(sample);
+        }
+    }
+
+} // namespace
+
+namespace eyetracking_core {
+
+    std::unique_ptr<GazePluginStage>
+    GazePluginStage::Load(const std::string& path, const std::string& config, std::chrono::microseconds budget) {
+        TraceLocalActivity(local);
+        TraceLoggingWriteStart(local, "GazePluginStage_Load", TLArg(path.c_str(), "Path"));
+
+        void* const library = OpenLibrary(path);
+        if (!library) {
+            Log("Failed to load plugin: %s", path.c_str());
+            TraceLoggingWriteStop(local, "GazePluginStage_Load", TLArg(false, "Success"));
+            return nullptr;
+        }
+
+        const char* error = nullptr;
+        const GazePluginInterface* plugin = nullptr;
+        void* instance = nullptr;
+        const auto getInterface =
+            reinterpret_cast<GazePlugin_GetInterfaceFn>(GetSymbol(library, GAZE_PLUGIN_ENTRY_POINT));
+        if (!getInterface) {
+            error = "missing entry point";
+        } else if (!(plugin = getInterface(GAZE_PLUGIN_ABI_VERSION)) || plugin->abiVersion != GAZE_PLUGIN_ABI_VERSION) {
+            error = "unsupported ABI version";
+        } else if (plugin->sampleSize != sizeof(GazePluginSample) || !plugin->name || !plugin->create ||
+                   !plugin->destroy || !plugin->process || !plugin->reset) {
+            error = "invalid interface";
+        } else if (!(instance = plugin->create(config.c_str()))) {
+            error = "failed to create instance";
+        }
+        if (error) {
+            Log("Failed to load plugin %s: %s", path.c_str(), error);
+            CloseLibrary(library);
+            TraceLoggingWriteStop(local, "GazePluginStage_Load", TLArg(false, "Success"), TLArg(error, "Error"));
+            return nullptr;
+        }
+
+        Log("Loaded plugin %s from %s, budget %lld us", plugin->name, path.c_str(), (long long)budget.count());
+        TraceLoggingWriteStop(local, "GazePluginStage_Load", TLArg(true, "Success"), TLArg(plugin->name, "Name"));
+
+        return std::unique_ptr<GazePluginStage>(new GazePluginStage(library, plugin, instance, budget));
+    }
+
+    GazePluginStage::GazePluginStage(void* library,
+                                     const GazePluginInterface* plugin,
+                                     void* instance,
+                                     std::chrono::microseconds budget)
+        : m_library(library), m_plugin(plugin), m_instance(instance), m_name(std::string("Plugin:") + plugin->name),
+          m_budget(budget) {
+        m_buffer.resize(k_MaxBatchSize);
+    }
+
+    GazePluginStage::~GazePluginStage() {
+        m_plugin->destroy(m_instance);
+        CloseLibrary(m_library);
+    }
+
+    void GazePluginStage::ProcessBatch(GazeSample* samples, size_t count) {
+        if (m_isDisabled) {
+            return;
+        }
+
+        for (size_t offset = 0; offset < count; offset += k_MaxBatchSize) {
+            const size_t batchSize = std::min(count - offset, k_MaxBatchSize);
+            for (size_t i = 0; i < batchSize; i++) {
+                m_buffer[i] = ToPluginSample(samples[offset + i]);
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            const int32_t result = m_plugin->process(m_instance, m_buffer.data(), (uint32_t)batchSize);
+            const auto duration = std::chrono::steady_clock::now() - start;
+
+            if (result) {
+                Disable("processing failed");
+                return;
+            }
+            for (size_t i = 0; i < batchSize; i++) {
+                FromPluginSample(m_buffer[i], samples[offset + i]);
+            }
+
+            if (duration > k_MaxCallDuration) {
+                Disable("a call exceeded the maximum duration");
+                return;
+            }
+            m_windowSamples += batchSize;
+            m_windowTime += duration;
+            if (m_windowSamples >= k_EvaluationWindow) {
+                if (m_windowTime / m_windowSamples > m_budget) {
+                    Disable("average cost exceeded the budget");
+                    return;
+                }
+                m_windowSamples = 0;
+                m_windowTime = {};
+            }
+        }
+    }
+
+    void GazePluginStage::Reset() {
+        if (!m_isDisabled) {
+            m_plugin->reset(m_instance);
+        }
+        m_windowSamples = 0;
+        m_windowTime = {};
+    }
+
+    void GazePluginStage::Disable(const char* reason) {
+        const long long average = m_windowSamples ? (long long)(m_windowTime.count() / m_windowSamples) : 0;
+        TraceLoggingWrite(TraceProvider,
+                          "GazePluginStage_Disable",
+                          TLArg(m_plugin->name, "Name"),
+                          TLArg(reason, "Reason"),
+                          TLArg(average, "AverageNs"));
+        Log("Disabling plugin %s: %s (%lld ns average)", m_plugin->name, reason, average);
+        m_isDisabled = true;
+    }
+
+} // namespace eyetracking_core
@@ -0,0 +1,88 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "GazePipeline.h"
+#include "GazePluginApi.h"
+
+namespace eyetracking_core {
+
+    // A processing stage implemented by a plugin (see GazePluginApi.h). Samples are converted into a buffer owned by
+    // the stage and handed to the plugin in a single call per batch.
+    //
+    // The time spent in the plugin is averaged over windows of k_EvaluationWindow samples. A plugin exceeding its
+    // budget on average, taking longer than k_MaxCallDuration for a single call, or failing, is disabled: the stage
+    // then passes samples through unchanged.
+    class GazePluginStage : public GazeStage {
+      public:
+        static constexpr size_t k_MaxBatchSize = 256;
+        static constexpr uint64_t k_EvaluationWindow = 256;
+        static constexpr auto k_MaxCallDuration = std::chrono::milliseconds(50);
+
+        // Load a plugin and create an instance. Returns nullptr, after logging the reason, on failure.
+        static std::unique_ptr<GazePluginStage>
+        Load(const std::string& path, const std::string& config, std::chrono::microseconds budget);
+
+        ~GazePluginStage() override;
+
+        const char* GetName() const override {
+            return m_name.c_str();
+        }
+
+        void Process(GazeSample& sample) override {
+            ProcessBatch(&sample, 1);
+        }
+
+        void ProcessBatch(GazeSample* samples, size_t count) override;
+        void Reset() override;
+
+        bool IsDisabled() const {
+            return m_isDisabled;
+        }
+
+      private:
+        GazePluginStage(void* library,
+                        const GazePluginInterface* plugin,
+                        void* instance,
+                        std::chrono::microseconds budget);
+
+        void Disable(const char* reason);
+
+        void* const m_library;
+        const GazePluginInterface* const m_plugin;
+        void* const m_instance;
+        const std::string m_name;
+        const std::chrono::nanoseconds m_budget;
+
+        std::vector<GazePluginSample> m_buffer;
+        bool m_isDisabled = false;
+        uint64_t m_windowSamples = 0;
+        std::chrono::nanoseconds m_windowTime{};
+    };
+
+} // namespace eyetracking_core
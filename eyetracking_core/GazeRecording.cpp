@@ -0,0 +1,137 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "GazeRecording.h"
+#include "Platform.h"
+#include "Tracing.h"
+
+namespace eyetracking_core {
+
+    bool LoadGazeRecording(const std::string& path, std::vector<GazeRecordingRecord>& records) {
+        TraceLocalActivity(local);
+        TraceLoggingWriteStart(local, "LoadGazeRecording", TLArg(path.c_str(), "Path"));
+
+        records.clear();
+
+        FILE* const file = OpenFile(path.c_str(), "rb");
+        if (!file) {
+            TraceLoggingWriteStop(local, "LoadGazeRecording", TLArg(false, "Success"));
+            return false;
+        }
+
+        GazeRecordingHeader header{};
+        bool success = fread(&header, sizeof(header), 1, file) == 1 && header.magic == k_GazeRecordingMagic &&
+                       header.version == k_GazeRecordingVersion && header.recordSize == sizeof(GazeRecordingRecord);
+        if (success) {
+            GazeRecordingRecord record{};
+            while (fread(&record, sizeof(record), 1, file) == 1) {
+                records.push_back(record);
+            }
+        }
+        fclose(file);
+
+        TraceLoggingWriteStop(local, "LoadGazeRecording", TLArg(success, "Success"), TLArg(records.size(), "Records"));
+
+        return success;
+    }
+
+    bool MappedGazeRecording::Open(const std::string& path) {
+        TraceLocalActivity(local);
+        TraceLoggingWriteStart(local, "MappedGazeRecording_Open", TLArg(path.c_str(), "Path"));
+
+        Close();
+
+        // Recordings are read front to back.
+        bool success = m_file.Open(path.c_str(), true /* sequential */) &&
+                       m_file.GetSize() >= sizeof(GazeRecordingHeader);
+        if (success) {
+            GazeRecordingHeader header;
+            memcpy(&header, m_file.GetData(), sizeof(header));
+            success = header.magic == k_GazeRecordingMagic && header.version == k_GazeRecordingVersion &&
+                      header.recordSize == sizeof(GazeRecordingRecord);
+        }
+        if (success) {
+            // The mapping is page-aligned, so the records following the header are aligned too.
+            m_records = reinterpret_cast<const GazeRecordingRecord*>(m_file.GetData() + sizeof(GazeRecordingHeader));
+            m_count = (m_file.GetSize() - sizeof(GazeRecordingHeader)) / sizeof(GazeRecordingRecord);
+        } else {
+            Close();
+        }
+
+        TraceLoggingWriteStop(local, "MappedGazeRecording_Open", TLArg(success, "Success"), TLArg(m_count, "Records"));
+
+        return success;
+    }
+
+    void MappedGazeRecording::Close() {
+        m_file.Close();
+        m_records = nullptr;
+        m_count = 0;
+    }
+
+    GazeRecordingWriter::GazeRecordingWriter(Arena* arena) : m_arena(arena) {
+    }
+
+    GazeRecordingWriter::~GazeRecordingWriter() {
+        Close();
+    }
+
+    bool GazeRecordingWriter::Open(const std::string& path) {
+        Close();
+
+        m_file = OpenFile(path.c_str(), "wb");
+        if (!m_file) {
+            return false;
+        }
+
+        // Allocated on the first recording only, and reused by the next ones.
+        if (!m_buffer.size()) {
+            m_buffer = ArenaArray<char>(k_BufferSize, m_arena);
+        }
+        setvbuf(m_file, m_buffer.data(), _IOFBF, m_buffer.size());
+
+        GazeRecordingHeader header{};
+        header.recordSize = sizeof(GazeRecordingRecord);
+        fwrite(&header, sizeof(header), 1, m_file);
+
+        return true;
+    }
+
+    void GazeRecordingWriter::Close() {
+        if (m_file) {
+            fclose(m_file);
+            m_file = nullptr;
+        }
+    }
+
+    void GazeRecordingWriter::Write(const GazeRecordingRecord& record) {
+        if (m_file) {
+            fwrite(&record, sizeof(record), 1, m_file);
+        }
+    }
+
+} // namespace eyetracking_core
@@ -0,0 +1,107 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Arena.h"
+#include "Platform.h"
+
+namespace eyetracking_core {
+
+    // The on-disk format for recorded eye tracker sessions: a GazeRecordingHeader followed by a packed array of
+    // GazeRecordingRecord, in increasing time order. The layout is fixed so that tools can map the file directly.
+    constexpr uint32_t k_GazeRecordingMagic = 0x52544550; // 'PETR'
+    constexpr uint32_t k_GazeRecordingVersion = 1;
+
+    struct GazeRecordingHeader {
+        uint32_t magic = k_GazeRecordingMagic;
+        uint32_t version = k_GazeRecordingVersion;
+        uint32_t recordSize = 0;
+        uint32_t reserved = 0;
+    };
+    static_assert(sizeof(GazeRecordingHeader) == 16);
+
+    enum GazeRecordingFlags : uint32_t {
+        GazeRecordingFlags_Valid = 1 << 0,
+    };
+
+    struct GazeRecordingRecord {
+        double timeInSeconds;
+        float gazeTan[2][2]; // [eye][x/y]
+        uint32_t flags;
+        uint32_t reserved;
+    };
+    static_assert(sizeof(GazeRecordingRecord) == 32);
+
+    // Load an entire recording in memory. Returns false if the file cannot be read or is not a recording.
+    bool LoadGazeRecording(const std::string& path, std::vector<GazeRecordingRecord>& records);
+
+    // Access a recording in place, through a mapping of the file, for recordings too large to load.
+    class MappedGazeRecording {
+      public:
+        // Returns false if the file cannot be mapped or is not a recording.
+        bool Open(const std::string& path);
+        void Close();
+
+        const GazeRecordingRecord* GetRecords() const {
+            return m_records;
+        }
+
+        size_t GetCount() const {
+            return m_count;
+        }
+
+      private:
+        MappedFile m_file;
+        const GazeRecordingRecord* m_records = nullptr;
+        size_t m_count = 0;
+    };
+
+    // Append samples to a recording. Writes go through a buffer that is allocated and faulted in upfront (from the
+    // arena when one is given), so that the first samples written do not pay for it.
+    class GazeRecordingWriter {
+      public:
+        explicit GazeRecordingWriter(Arena* arena = nullptr);
+        ~GazeRecordingWriter();
+
+        bool Open(const std::string& path);
+        void Close();
+        void Write(const GazeRecordingRecord& record);
+
+        bool IsOpen() const {
+            return m_file != nullptr;
+        }
+
+      private:
+        static constexpr size_t k_BufferSize = 64 * 1024;
+
+        Arena* const m_arena;
+        FILE* m_file = nullptr;
+        ArenaArray<char> m_buffer;
+    };
+
+} // namespace eyetracking_core
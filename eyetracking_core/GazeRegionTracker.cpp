@@ -0,0 +1,260 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "GazeRegionTracker.h"
+#include "Platform.h"
+#include "Tracing.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    constexpr float k_RadiansToDegrees = 180.f / 3.14159265f;
+
+    // Bound the size of the index for sets of huge regions, which would otherwise be listed in many cells.
+    constexpr uint32_t k_MaxGridSize = 1024;
+
+    // The vertical extent of the region, whatever was left in halfHeight for circles.
+    float GetHalfHeight(const GazeRegion& region) {
+        return region.shape == GazeRegion::Circle ? region.halfWidth : region.halfHeight;
+    }
+
+} // namespace
+
+namespace eyetracking_core {
+
+    bool LoadGazeRegions(const std::string& path, std::vector<GazeRegion>& regions) {
+        std::ifstream file(path);
+        if (!file) {
+            return false;
+        }
+
+        regions.clear();
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream stream(line);
+            std::string shape;
+            if (!(stream >> shape) || shape[0] == '#') {
+                continue;
+            }
+
+            GazeRegion region;
+            stream >> region.id >> region.yaw >> region.pitch >> region.halfWidth;
+            if (shape == "rect") {
+                region.shape = GazeRegion::Rectangle;
+                stream >> region.halfHeight;
+            } else if (shape == "circle") {
+                region.shape = GazeRegion::Circle;
+                region.halfHeight = region.halfWidth;
+            } else {
+                return false;
+            }
+            if (stream.fail() || region.halfWidth < 0.f || region.halfHeight < 0.f) {
+                return false;
+            }
+            regions.push_back(region);
+        }
+
+        return true;
+    }
+
+    GazeRegionSet::GazeRegionSet(std::vector<GazeRegion> regions) : m_regions(std::move(regions)) {
+        if (m_regions.empty()) {
+            m_cellOffsets.assign(1, 0);
+            return;
+        }
+
+        float maxYaw = -FLT_MAX, maxPitch = -FLT_MAX;
+        m_minYaw = m_minPitch = FLT_MAX;
+        for (const GazeRegion& region : m_regions) {
+            m_minYaw = std::min(m_minYaw, region.yaw - region.halfWidth);
+            m_minPitch = std::min(m_minPitch, region.pitch - GetHalfHeight(region));
+            maxYaw = std::max(maxYaw, region.yaw + region.halfWidth);
+            maxPitch = std::max(maxPitch, region.pitch + GetHalfHeight(region));
+        }
+
+        // About one cell per region, with square-ish cells. Points on the far edges belong to the last cells.
+        const float width = std::max(maxYaw - m_minYaw, 1e-3f);
+        const float height = std::max(maxPitch - m_minPitch, 1e-3f);
+        const float cellSize = std::sqrt(width * height / m_regions.size());
+        m_columns = std::clamp((uint32_t)std::ceil(width / cellSize), 1u, k_MaxGridSize);
+        m_rows = std::clamp((uint32_t)std::ceil(height / cellSize), 1u, k_MaxGridSize);
+        m_inverseCellWidth = m_columns / width * (1.f - FLT_EPSILON);
+        m_inverseCellHeight = m_rows / height * (1.f - FLT_EPSILON);
+
+        // Two passes: count the regions overlapping each cell, then fill the lists.
+        const auto forEachCell = [&](const GazeRegion& region, auto&& callback) {
+            const auto toCell = [](float value, float inverseCellSize, uint32_t count) {
+                return std::min((uint32_t)std::max(value * inverseCellSize, 0.f), count - 1);
+            };
+            const float yaw = region.yaw - m_minYaw;
+            const float pitch = region.pitch - m_minPitch;
+            const uint32_t firstColumn = toCell(yaw - region.halfWidth, m_inverseCellWidth, m_columns);
+            const uint32_t lastColumn = toCell(yaw + region.halfWidth, m_inverseCellWidth, m_columns);
+            const uint32_t firstRow = toCell(pitch - GetHalfHeight(region), m_inverseCellHeight, m_rows);
+            const uint32_t lastRow = toCell(pitch + GetHalfHeight(region), m_inverseCellHeight, m_rows);
+            for (uint32_t row = firstRow; row <= lastRow; row++) {
+                for (uint32_t column = firstColumn; column <= lastColumn; column++) {
+                    callback(row * m_columns + column);
+                }
+            }
+        };
+
+        m_cellOffsets.assign((size_t)m_columns * m_rows + 1, 0);
+        for (const GazeRegion& region : m_regions) {
+            forEachCell(region, [&](uint32_t cell) { m_cellOffsets[cell + 1]++; });
+        }
+        for (size_t cell = 1; cell < m_cellOffsets.size(); cell++) {
+            m_cellOffsets[cell] += m_cellOffsets[cell - 1];
+        }
+        m_cellRegions.resize(m_cellOffsets.back());
+        std::vector<uint32_t> fill(m_cellOffsets.begin(), m_cellOffsets.end() - 1);
+        for (uint32_t index = 0; index < (uint32_t)m_regions.size(); index++) {
+            forEachCell(m_regions[index], [&](uint32_t cell) { m_cellRegions[fill[cell]++] = index; });
+        }
+    }
+
+    GazeRegionTracker::GazeRegionTracker() {
+        // Enough for the overlapping regions under any sample in practice, so that Process() does not allocate.
+        m_hits.reserve(64);
+        m_previousHits.reserve(64);
+    }
+
+    void GazeRegionTracker::SetRegions(std::vector<GazeRegion> regions) {
+        TraceLocalActivity(local);
+        TraceLoggingWriteStart(local, "GazeRegionTracker_SetRegions", TLArg(regions.size(), "Count"));
+
+        // Index the regions and prepare their statistics without blocking Process().
+        auto set = std::make_shared<const GazeRegionSet>(std::move(regions));
+
+        std::unique_lock updateLock(m_updateMutex);
+
+        std::unordered_map<uint32_t, uint32_t> previousIndices;
+        if (m_regions) {
+            previousIndices.reserve(m_regions->GetSize());
+            for (uint32_t index = 0; index < (uint32_t)m_regions->GetSize(); index++) {
+                previousIndices.emplace((*m_regions)[index].id, index);
+            }
+        }
+        std::vector<int64_t> carryOver(set->GetSize(), -1);
+        std::vector<Statistics> statistics(set->GetSize());
+        for (size_t index = 0; index < set->GetSize(); index++) {
+            statistics[index].id = (*set)[index].id;
+            const auto it = previousIndices.find(statistics[index].id);
+            if (it != previousIndices.end()) {
+                carryOver[index] = it->second;
+            }
+        }
+
+        {
+            std::unique_lock lock(m_mutex);
+            for (size_t index = 0; index < statistics.size(); index++) {
+                if (carryOver[index] >= 0) {
+                    statistics[index] = m_statistics[carryOver[index]];
+                }
+            }
+            m_statistics.swap(statistics);
+            m_regions.swap(set);
+            m_previousHits.clear();
+        }
+
+        TraceLoggingWriteStop(local,
+                              "GazeRegionTracker_SetRegions",
+                              TLArg(m_regions->GetColumnCount(), "Columns"),
+                              TLArg(m_regions->GetRowCount(), "Rows"));
+    }
+
+    void GazeRegionTracker::Process(const GazeSample& sample) {
+        std::unique_lock lock(m_mutex);
+
+        const double interval = m_hasLastTime ? sample.timeInSeconds - m_lastTime : 0.0;
+        m_hasLastTime = true;
+        m_lastTime = sample.timeInSeconds;
+        if (!m_regions || !sample.isValid) {
+            m_previousHits.clear();
+            return;
+        }
+
+        m_hits.clear();
+        m_regions->ForEachHit(
+            sample.yaw * k_RadiansToDegrees, sample.pitch * k_RadiansToDegrees, [&](uint32_t index) {
+                m_hits.push_back(index);
+            });
+
+        const double dwell = std::clamp(interval, 0.0, k_MaxSampleInterval);
+        for (const uint32_t index : m_hits) {
+            Statistics& statistics = m_statistics[index];
+            statistics.hitCount++;
+            statistics.dwellTime += dwell;
+            if (std::find(m_previousHits.cbegin(), m_previousHits.cend(), index) == m_previousHits.cend()) {
+                statistics.visitCount++;
+            }
+        }
+        m_hits.swap(m_previousHits);
+    }
+
+    size_t GazeRegionTracker::GetRegionCount() const {
+        std::unique_lock lock(m_mutex);
+        return m_regions ? m_regions->GetSize() : 0;
+    }
+
+    void GazeRegionTracker::GetStatistics(std::vector<Statistics>& statistics) const {
+        std::unique_lock lock(m_mutex);
+        statistics = m_statistics;
+    }
+
+    bool WriteGazeRegionStatistics(const std::vector<GazeRegionTracker::Statistics>& statistics,
+                                   const std::string& path) {
+        FILE* const file = OpenFile(path.c_str(), "w");
+        if (!file) {
+            return false;
+        }
+
+        fprintf(file, "id,hits,visits,dwell\n");
+        for (const GazeRegionTracker::Statistics& entry : statistics) {
+            fprintf(file,
+                    "%u,%llu,%llu,%.4f\n",
+                    entry.id,
+                    static_cast<unsigned long long>(entry.hitCount),
+                    static_cast<unsigned long long>(entry.visitCount),
+                    entry.dwellTime);
+        }
+        const bool success = !ferror(file);
+        fclose(file);
+
+        return success;
+    }
+
+} // namespace eyetracking_core
@@ -0,0 +1,158 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "GazePipeline.h"
+
+namespace eyetracking_core {
+
+    // A region of interest in gaze-angle space, relative to the head. Angles are in degrees, yaw increasing to the
+    // right and pitch increasing upwards. Circles use halfWidth as their radius.
+    struct GazeRegion {
+        enum Shape { Rectangle, Circle };
+
+        uint32_t id = 0;
+        Shape shape = Rectangle;
+        float yaw = 0.f;
+        float pitch = 0.f;
+        float halfWidth = 0.f;
+        float halfHeight = 0.f;
+    };
+
+    // Read regions from a text file, one per line: "rect <id> <yaw> <pitch> <halfWidth> <halfHeight>" or
+    // "circle <id> <yaw> <pitch> <radius>". Empty lines and lines starting with '#' are ignored.
+    bool LoadGazeRegions(const std::string& path, std::vector<GazeRegion>& regions);
+
+    // An immutable set of regions with a uniform grid index over their bounding box. Each cell lists the regions
+    // overlapping it, so a lookup only tests the regions near the gaze instead of all of them.
+    class GazeRegionSet {
+      public:
+        explicit GazeRegionSet(std::vector<GazeRegion> regions);
+
+        size_t GetSize() const {
+            return m_regions.size();
+        }
+
+        const GazeRegion& operator[](size_t index) const {
+            return m_regions[index];
+        }
+
+        uint32_t GetColumnCount() const {
+            return m_columns;
+        }
+
+        uint32_t GetRowCount() const {
+            return m_rows;
+        }
+
+        // Invoke callback(index) for each region containing the point.
+        template <typename Callback>
+        void ForEachHit(float yaw, float pitch, Callback&& callback) const {
+            const float column = (yaw - m_minYaw) * m_inverseCellWidth;
+            const float row = (pitch - m_minPitch) * m_inverseCellHeight;
+            if (!(column >= 0.f && column < (float)m_columns && row >= 0.f && row < (float)m_rows)) {
+                return;
+            }
+
+            const uint32_t cell = (uint32_t)row * m_columns + (uint32_t)column;
+            for (uint32_t i = m_cellOffsets[cell]; i < m_cellOffsets[cell + 1]; i++) {
+                const uint32_t index = m_cellRegions[i];
+                if (Contains(m_regions[index], yaw, pitch)) {
+                    callback(index);
+                }
+            }
+        }
+
+        static bool Contains(const GazeRegion& region, float yaw, float pitch) {
+            const float dx = yaw - region.yaw;
+            const float dy = pitch - region.pitch;
+            if (region.shape == GazeRegion::Circle) {
+                return dx * dx + dy * dy <= region.halfWidth * region.halfWidth;
+            }
+            return std::abs(dx) <= region.halfWidth && std::abs(dy) <= region.halfHeight;
+        }
+
+      private:
+        const std::vector<GazeRegion> m_regions;
+
+        float m_minYaw = 0.f;
+        float m_minPitch = 0.f;
+        float m_inverseCellWidth = 0.f;
+        float m_inverseCellHeight = 0.f;
+        uint32_t m_columns = 0;
+        uint32_t m_rows = 0;
+
+        // The regions of cell i are m_cellRegions[m_cellOffsets[i]..m_cellOffsets[i + 1]).
+        std::vector<uint32_t> m_cellOffsets;
+        std::vector<uint32_t> m_cellRegions;
+    };
+
+    // Tracks how many samples fell in each region, how many times the gaze entered it and for how long it stayed.
+    //
+    // The regions can be replaced at any time from any thread: the new set is indexed by the caller, then swapped in
+    // together with its statistics, carrying over those of regions with the same id. Samples see either set entirely.
+    class GazeRegionTracker {
+      public:
+        struct Statistics {
+            uint32_t id = 0;
+            uint64_t hitCount = 0;
+            uint64_t visitCount = 0;
+            double dwellTime = 0.0;
+        };
+
+        // Longest interval between samples counted towards the dwell time, so that tracking loss is not counted.
+        static constexpr double k_MaxSampleInterval = 0.1;
+
+        GazeRegionTracker();
+
+        void SetRegions(std::vector<GazeRegion> regions);
+        void Process(const GazeSample& sample);
+
+        size_t GetRegionCount() const;
+        void GetStatistics(std::vector<Statistics>& statistics) const;
+
+      private:
+        // Serializes SetRegions(), which is the only writer of m_regions.
+        std::mutex m_updateMutex;
+
+        mutable std::mutex m_mutex;
+        std::shared_ptr<const GazeRegionSet> m_regions;
+        std::vector<Statistics> m_statistics;
+        std::vector<uint32_t> m_hits;
+        std::vector<uint32_t> m_previousHits;
+        bool m_hasLastTime = false;
+        double m_lastTime = 0.0;
+    };
+
+    // Write the statistics as CSV, one region per line.
+    bool WriteGazeRegionStatistics(const std::vector<GazeRegionTracker::Statistics>& statistics,
+                                   const std::string& path);
+
+} // namespace eyetracking_core
@@ -0,0 +1,82 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Applications can supply a coarse proxy of their scene (boxes and triangles) through shared memory, and the driver
+// reports which object the user is looking at. This header only depends on standard types, so that clients can include
+// it directly.
+//
+// The client creates a named file mapping (k_GazeSceneProxyName) laid out as a GazeSceneProxyHeader followed by
+// `capacity` GazeScenePrimitive. To update the scene, the client increments `generation` (making it odd), writes the
+// primitives and primitiveCount, then increments `generation` again (making it even). The driver picks up the new
+// scene within k_GazeSceneProxyPollMs; it only needs to refit its acceleration structure when the ids and types of the
+// primitives are unchanged (eg: the objects moved), which is much cheaper than a full rebuild.
+//
+// Coordinates are in the SteamVR world (standing) space, in meters.
+namespace eyetracking_core {
+
+    constexpr const char* k_GazeSceneProxyName = "Local\\PimaxEyeTrackingSceneProxy";
+    constexpr uint32_t k_GazeSceneProxyMagic = 0x4E435350; // 'PSCN'
+    constexpr uint32_t k_GazeSceneProxyVersion = 1;
+    constexpr uint32_t k_GazeSceneProxyPollMs = 100;
+
+    enum GazeScenePrimitiveType : uint32_t {
+        GazeScenePrimitive_Box = 0,      // data = min[3], max[3]
+        GazeScenePrimitive_Triangle = 1, // data = v0[3], v1[3], v2[3]
+    };
+
+    struct GazeScenePrimitive {
+        uint32_t id; // Reported in GazeSceneHit::objectId. Several primitives may share the same id.
+        uint32_t type;
+        float data[9];
+        uint32_t reserved;
+    };
+    static_assert(sizeof(GazeScenePrimitive) == 48);
+
+    constexpr uint32_t k_GazeSceneNoHit = 0xFFFFFFFF;
+
+    // Written by the driver for every gaze sample. `sequence` is odd while the driver is writing: readers should retry
+    // if it is odd or changed while they were reading the other fields.
+    struct GazeSceneHit {
+        std::atomic<uint32_t> sequence;
+        uint32_t objectId;    // k_GazeSceneNoHit when the gaze ray does not hit the scene.
+        float distance;       // Meters from the head to the hit.
+        uint32_t reserved;
+        double timeInSeconds; // Time of the gaze sample, in the tracker's clock.
+    };
+
+    struct GazeSceneProxyHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t capacity; // Number of primitives the mapping can hold after the header.
+        uint32_t primitiveCount;
+        std::atomic<uint32_t> generation;
+        uint32_t reserved[5];
+        GazeSceneHit hit;
+    };
+    static_assert(sizeof(GazeSceneProxyHeader) == 64);
+
+} // namespace eyetracking_core
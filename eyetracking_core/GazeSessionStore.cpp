@@ -0,0 +1,427 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GAZE_SESSION_SSE2
+#endif
+
+#include "GazeEvents.h"
+#include "GazeSessionStore.h"
+#include "Platform.h"
+#include "Tracing.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    constexpr uint32_t k_Samples = GazeSessionChunk::k_Samples;
+
+    uint32_t PopCount(uint64_t value) {
+        value = value - ((value >> 1) & 0x5555555555555555ull);
+        value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+        value = (value + (value >> 4)) & 0x0f0f0f0f0f0f0f0full;
+        return (uint32_t)((value * 0x0101010101010101ull) >> 56);
+    }
+
+    bool IsValid(const GazeSessionChunk& chunk, uint32_t index) {
+        return (chunk.validBits[index / 64] >> (index % 64)) & 1;
+    }
+
+    // Number of bits set in [first, last).
+    uint32_t CountValid(const GazeSessionChunk& chunk, uint32_t first, uint32_t last) {
+        uint32_t count = 0;
+        while (first < last) {
+            const uint32_t bits = std::min(64 - first % 64, last - first);
+            const uint64_t mask = bits == 64 ? ~0ull : ((1ull << bits) - 1) << (first % 64);
+            count += PopCount(chunk.validBits[first / 64] & mask);
+            first += bits;
+        }
+        return count;
+    }
+
+    // Sum of the gaze tangents of the valid samples in [first, last), in the order left x/y, right x/y.
+    void SumValidGazeTan(const GazeSessionChunk& chunk, uint32_t first, uint32_t last, double sums[4]) {
+        const float* const columns[4] = {
+            chunk.gazeTanX[0], chunk.gazeTanY[0], chunk.gazeTanX[1], chunk.gazeTanY[1]};
+
+        // Process the unaligned head and the tail one sample at a time, and the rest 4 samples at a time.
+        uint32_t index = first;
+        for (; index < last && index % 4; index++) {
+            if (IsValid(chunk, index)) {
+                for (int column = 0; column < 4; column++) {
+                    sums[column] += columns[column][index];
+                }
+            }
+        }
+#ifdef GAZE_SESSION_SSE2
+        // One bit of validity per lane, turned into a lane mask.
+        const __m128i lanes = _mm_set_epi32(8, 4, 2, 1);
+        __m128 leftX = _mm_setzero_ps(), leftY = _mm_setzero_ps();
+        __m128 rightX = _mm_setzero_ps(), rightY = _mm_setzero_ps();
+        for (; index + 4 <= last; index += 4) {
+            const int nibble = (int)((chunk.validBits[index / 64] >> (index % 64)) & 0xf);
+            const __m128 mask =
+                _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(nibble), lanes), lanes));
+            leftX = _mm_add_ps(leftX, _mm_and_ps(_mm_load_ps(columns[0] + index), mask));
+            leftY = _mm_add_ps(leftY, _mm_and_ps(_mm_load_ps(columns[1] + index), mask));
+            rightX = _mm_add_ps(rightX, _mm_and_ps(_mm_load_ps(columns[2] + index), mask));
+            rightY = _mm_add_ps(rightY, _mm_and_ps(_mm_load_ps(columns[3] + index), mask));
+        }
+        alignas(16) float lanesSum[4][4];
+        _mm_store_ps(lanesSum[0], leftX);
+        _mm_store_ps(lanesSum[1], leftY);
+        _mm_store_ps(lanesSum[2], rightX);
+        _mm_store_ps(lanesSum[3], rightY);
+        for (int column = 0; column < 4; column++) {
+            const float* const lane = lanesSum[column];
+            sums[column] += (double)lane[0] + lane[1] + lane[2] + lane[3];
+        }
+#endif
+        for (; index < last; index++) {
+            if (IsValid(chunk, index)) {
+                for (int column = 0; column < 4; column++) {
+                    sums[column] += columns[column][index];
+                }
+            }
+        }
+    }
+
+    void CountClasses(
+        const GazeSessionChunk& chunk, uint32_t first, uint32_t last, uint64_t& fixationCount, uint64_t& saccadeCount) {
+        const uint8_t* const classification = chunk.classification;
+        uint32_t index = first;
+        for (; index < last && index % 16; index++) {
+            fixationCount += classification[index] == GazeSessionClass_Fixation;
+            saccadeCount += classification[index] == GazeSessionClass_Saccade;
+        }
+#ifdef GAZE_SESSION_SSE2
+        // Compare 16 samples at a time, and add up the matches (0 or 1 per byte) with a sum of absolute differences.
+        const __m128i fixation = _mm_set1_epi8(GazeSessionClass_Fixation);
+        const __m128i saccade = _mm_set1_epi8(GazeSessionClass_Saccade);
+        const __m128i one = _mm_set1_epi8(1);
+        const __m128i zero = _mm_setzero_si128();
+        __m128i fixations = zero;
+        __m128i saccades = zero;
+        for (; index + 16 <= last; index += 16) {
+            const __m128i classes = _mm_load_si128(reinterpret_cast<const __m128i*>(classification + index));
+            fixations = _mm_add_epi64(
+                fixations, _mm_sad_epu8(_mm_and_si128(_mm_cmpeq_epi8(classes, fixation), one), zero));
+            saccades =
+                _mm_add_epi64(saccades, _mm_sad_epu8(_mm_and_si128(_mm_cmpeq_epi8(classes, saccade), one), zero));
+        }
+        alignas(16) uint64_t sums[2];
+        _mm_store_si128(reinterpret_cast<__m128i*>(sums), fixations);
+        fixationCount += sums[0] + sums[1];
+        _mm_store_si128(reinterpret_cast<__m128i*>(sums), saccades);
+        saccadeCount += sums[0] + sums[1];
+#endif
+        for (; index < last; index++) {
+            fixationCount += classification[index] == GazeSessionClass_Fixation;
+            saccadeCount += classification[index] == GazeSessionClass_Saccade;
+        }
+    }
+
+    struct Cone {
+        float axis[3];
+        float cosRadius;
+    };
+
+    // Whether the gaze (tangents averaged over both eyes) is within the cone. The direction is built like
+    // UpdateGazeAngles() does, with sin(atan(t)) = t / sqrt(1 + t^2) and cos(atan(t)) = 1 / sqrt(1 + t^2).
+    bool IsInCone(const Cone& cone, float gazeX, float gazeY) {
+        const float scaleX = std::sqrt(1.f + gazeX * gazeX);
+        const float scaleY = std::sqrt(1.f + gazeY * gazeY);
+        const float dot = ((gazeX * cone.axis[0] - cone.axis[2]) / scaleX + gazeY * cone.axis[1]) / scaleY;
+        return dot >= cone.cosRadius;
+    }
+
+    // Time spent in the cone by the valid samples in [first, last). nextOffset is the time offset of the sample
+    // following the chunk, or of its last sample when there is none.
+    double SumTimeInCone(
+        const GazeSessionChunk& chunk, uint32_t first, uint32_t last, const Cone& cone, float nextOffset) {
+        const float* const offsets = chunk.timeOffset;
+        const auto getDuration = [&](uint32_t index) {
+            const float next = index + 1 < chunk.sampleCount ? offsets[index + 1] : nextOffset;
+            return std::min(next - offsets[index], GazeSessionStore::k_MaxSampleGap);
+        };
+        const auto isInCone = [&](uint32_t index) {
+            return IsValid(chunk, index) &&
+                   IsInCone(cone,
+                            (chunk.gazeTanX[0][index] + chunk.gazeTanX[1][index]) * 0.5f,
+                            (chunk.gazeTanY[0][index] + chunk.gazeTanY[1][index]) * 0.5f);
+        };
+
+        double total = 0.0;
+        uint32_t index = first;
+        for (; index < last && index % 4; index++) {
+            total += isInCone(index) ? getDuration(index) : 0.f;
+        }
+#ifdef GAZE_SESSION_SSE2
+        const __m128i lanes = _mm_set_epi32(8, 4, 2, 1);
+        const __m128 one = _mm_set1_ps(1.f);
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 axisX = _mm_set1_ps(cone.axis[0]);
+        const __m128 axisY = _mm_set1_ps(cone.axis[1]);
+        const __m128 axisZ = _mm_set1_ps(cone.axis[2]);
+        const __m128 cosRadius = _mm_set1_ps(cone.cosRadius);
+        const __m128 maxGap = _mm_set1_ps(GazeSessionStore::k_MaxSampleGap);
+        __m128 accumulator = _mm_setzero_ps();
+        // The durations need the offset of the next sample, so the last sample of the chunk is left to the tail.
+        for (; index + 4 <= last && index + 4 < chunk.sampleCount; index += 4) {
+            const int nibble = (int)((chunk.validBits[index / 64] >> (index % 64)) & 0xf);
+            const __m128 valid =
+                _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(nibble), lanes), lanes));
+
+            const __m128 gazeX = _mm_mul_ps(
+                _mm_add_ps(_mm_load_ps(chunk.gazeTanX[0] + index), _mm_load_ps(chunk.gazeTanX[1] + index)), half);
+            const __m128 gazeY = _mm_mul_ps(
+                _mm_add_ps(_mm_load_ps(chunk.gazeTanY[0] + index), _mm_load_ps(chunk.gazeTanY[1] + index)), half);
+            const __m128 scaleX = _mm_sqrt_ps(_mm_add_ps(one, _mm_mul_ps(gazeX, gazeX)));
+            const __m128 scaleY = _mm_sqrt_ps(_mm_add_ps(one, _mm_mul_ps(gazeY, gazeY)));
+            const __m128 dot = _mm_div_ps(
+                _mm_add_ps(_mm_div_ps(_mm_sub_ps(_mm_mul_ps(gazeX, axisX), axisZ), scaleX), _mm_mul_ps(gazeY, axisY)),
+                scaleY);
+            const __m128 inCone = _mm_and_ps(valid, _mm_cmpge_ps(dot, cosRadius));
+
+            const __m128 duration =
+                _mm_min_ps(_mm_sub_ps(_mm_loadu_ps(offsets + index + 1), _mm_load_ps(offsets + index)), maxGap);
+            accumulator = _mm_add_ps(accumulator, _mm_and_ps(duration, inCone));
+        }
+        alignas(16) float lanesSum[4];
+        _mm_store_ps(lanesSum, accumulator);
+        total += (double)lanesSum[0] + lanesSum[1] + lanesSum[2] + lanesSum[3];
+#endif
+        for (; index < last; index++) {
+            total += isInCone(index) ? getDuration(index) : 0.f;
+        }
+        return total;
+    }
+
+} // namespace
+
+namespace eyetracking_core {
+
+    float GazeSessionSummary::GetMeanYaw() const {
+        return atanf((meanGazeTan[0].x + meanGazeTan[1].x) / 2.f);
+    }
+
+    float GazeSessionSummary::GetMeanPitch() const {
+        return atanf((meanGazeTan[0].y + meanGazeTan[1].y) / 2.f);
+    }
+
+    GazeSessionStore::GazeSessionStore(size_t maxChunks) : m_maxChunks(std::max(maxChunks, (size_t)1)) {
+    }
+
+    void GazeSessionStore::Add(const GazeSample& sample) {
+        if (!m_chunks.empty() && sample.timeInSeconds < m_chunks.back()->lastTime) {
+            Clear();
+        }
+
+        // Chunks are allocated as the session grows, then recycled from the oldest.
+        if (m_chunks.empty() || m_chunks.back()->sampleCount == k_Samples) {
+            std::unique_ptr<GazeSessionChunk> chunk;
+            if (m_chunks.size() == m_maxChunks) {
+                chunk = std::move(m_chunks.front());
+                m_chunks.pop_front();
+            } else {
+                chunk = std::make_unique<GazeSessionChunk>();
+            }
+            chunk->baseTime = sample.timeInSeconds;
+            chunk->sampleCount = chunk->validCount = 0;
+            memset(chunk->reserved, 0, sizeof(chunk->reserved));
+            memset(chunk->validBits, 0, sizeof(chunk->validBits));
+            m_chunks.push_back(std::move(chunk));
+        }
+
+        if (sample.events & GazeEvent_SaccadeOnset) {
+            m_inSaccade = true;
+        }
+        if (sample.isFixation || !sample.isValid) {
+            m_inSaccade = false;
+        }
+
+        GazeSessionChunk& chunk = *m_chunks.back();
+        const uint32_t index = chunk.sampleCount++;
+        chunk.lastTime = sample.timeInSeconds;
+        chunk.timeOffset[index] = (float)(sample.timeInSeconds - chunk.baseTime);
+        for (int eye = 0; eye < 2; eye++) {
+            chunk.gazeTanX[eye][index] = sample.isValid ? sample.gazeTan[eye].x : 0.f;
+            chunk.gazeTanY[eye][index] = sample.isValid ? sample.gazeTan[eye].y : 0.f;
+        }
+        if (sample.isValid) {
+            chunk.validBits[index / 64] |= 1ull << (index % 64);
+            chunk.validCount++;
+        }
+        chunk.classification[index] = !sample.isValid     ? GazeSessionClass_None
+                                      : sample.isFixation ? GazeSessionClass_Fixation
+                                      : m_inSaccade       ? GazeSessionClass_Saccade
+                                                          : GazeSessionClass_None;
+    }
+
+    void GazeSessionStore::Clear() {
+        m_chunks.clear();
+        m_inSaccade = false;
+    }
+
+    GazeSessionSummary GazeSessionStore::Summarize(double startTime, double endTime) const {
+        TraceLocalActivity(local);
+        TraceLoggingWriteStart(
+            local, "GazeSessionStore_Summarize", TLArg(startTime, "StartTime"), TLArg(endTime, "EndTime"));
+
+        GazeSessionSummary summary;
+        double sums[4]{};
+        uint64_t fixationCount = 0;
+        uint64_t saccadeCount = 0;
+        for (size_t i = FindChunk(startTime); i < m_chunks.size() && m_chunks[i]->baseTime < endTime; i++) {
+            const GazeSessionChunk& chunk = *m_chunks[i];
+            uint32_t first, last;
+            FindRange(chunk, startTime, endTime, first, last);
+
+            summary.sampleCount += last - first;
+            summary.validCount += first == 0 && last == chunk.sampleCount ? chunk.validCount
+                                                                          : CountValid(chunk, first, last);
+            SumValidGazeTan(chunk, first, last, sums);
+            CountClasses(chunk, first, last, fixationCount, saccadeCount);
+        }
+
+        if (summary.validCount) {
+            for (int eye = 0; eye < 2; eye++) {
+                summary.meanGazeTan[eye].x = (float)(sums[2 * eye] / summary.validCount);
+                summary.meanGazeTan[eye].y = (float)(sums[2 * eye + 1] / summary.validCount);
+            }
+        }
+        summary.classCount[GazeSessionClass_Fixation] = (uint32_t)fixationCount;
+        summary.classCount[GazeSessionClass_Saccade] = (uint32_t)saccadeCount;
+        summary.classCount[GazeSessionClass_None] = summary.sampleCount - (uint32_t)(fixationCount + saccadeCount);
+
+        TraceLoggingWriteStop(local,
+                              "GazeSessionStore_Summarize",
+                              TLArg(summary.sampleCount, "Samples"),
+                              TLArg(summary.validCount, "Valid"));
+
+        return summary;
+    }
+
+    double GazeSessionStore::GetTimeInCone(
+        double startTime, double endTime, float yaw, float pitch, float radius) const {
+        TraceLocalActivity(local);
+        TraceLoggingWriteStart(local,
+                               "GazeSessionStore_GetTimeInCone",
+                               TLArg(startTime, "StartTime"),
+                               TLArg(endTime, "EndTime"),
+                               TLArg(yaw, "Yaw"),
+                               TLArg(pitch, "Pitch"),
+                               TLArg(radius, "Radius"));
+
+        Cone cone;
+        cone.axis[0] = sinf(yaw) * cosf(pitch);
+        cone.axis[1] = sinf(pitch);
+        cone.axis[2] = -cosf(yaw) * cosf(pitch);
+        cone.cosRadius = cosf(radius);
+
+        double total = 0.0;
+        for (size_t i = FindChunk(startTime); i < m_chunks.size() && m_chunks[i]->baseTime < endTime; i++) {
+            const GazeSessionChunk& chunk = *m_chunks[i];
+            uint32_t first, last;
+            FindRange(chunk, startTime, endTime, first, last);
+
+            const float nextOffset = i + 1 < m_chunks.size()
+                                         ? (float)(m_chunks[i + 1]->baseTime - chunk.baseTime)
+                                         : chunk.timeOffset[chunk.sampleCount - 1];
+            total += SumTimeInCone(chunk, first, last, cone, nextOffset);
+        }
+
+        TraceLoggingWriteStop(local, "GazeSessionStore_GetTimeInCone", TLArg(total, "Time"));
+
+        return total;
+    }
+
+    void GazeSessionStore::TakeSnapshot(GazeSessionSnapshot& snapshot) const {
+        snapshot.sampleCount = GetSampleCount();
+        snapshot.chunks.clear();
+        snapshot.chunks.reserve(m_chunks.size());
+        for (const auto& chunk : m_chunks) {
+            snapshot.chunks.push_back(*chunk);
+        }
+    }
+
+    bool WriteGazeSession(const GazeSessionSnapshot& snapshot, const std::string& path) {
+        TraceLocalActivity(local);
+        TraceLoggingWriteStart(local, "WriteGazeSession", TLArg(path.c_str(), "Path"));
+
+        FILE* const file = OpenFile(path.c_str(), "wb");
+        if (!file) {
+            TraceLoggingWriteStop(local, "WriteGazeSession", TLArg(false, "Success"));
+            return false;
+        }
+
+        GazeSessionFileHeader header{};
+        header.chunkCount = (uint32_t)snapshot.chunks.size();
+        header.sampleCount = snapshot.sampleCount;
+        bool success = fwrite(&header, sizeof(header), 1, file) == 1;
+        for (const GazeSessionChunk& chunk : snapshot.chunks) {
+            success = success && fwrite(&chunk, sizeof(chunk), 1, file) == 1;
+        }
+        success = fclose(file) == 0 && success;
+
+        TraceLoggingWriteStop(local, "WriteGazeSession", TLArg(success, "Success"));
+
+        return success;
+    }
+
+    uint64_t GazeSessionStore::GetSampleCount() const {
+        uint64_t count = 0;
+        for (const auto& chunk : m_chunks) {
+            count += chunk->sampleCount;
+        }
+        return count;
+    }
+
+    void GazeSessionStore::FindRange(
+        const GazeSessionChunk& chunk, double startTime, double endTime, uint32_t& first, uint32_t& last) {
+        const float* const begin = chunk.timeOffset;
+        const float* const end = chunk.timeOffset + chunk.sampleCount;
+        first = startTime <= chunk.baseTime
+                    ? 0
+                    : (uint32_t)(std::lower_bound(begin, end, (float)(startTime - chunk.baseTime)) - begin);
+        last = endTime > chunk.lastTime
+                   ? chunk.sampleCount
+                   : (uint32_t)(std::lower_bound(begin, end, (float)(endTime - chunk.baseTime)) - begin);
+        last = std::max(first, last);
+    }
+
+    size_t GazeSessionStore::FindChunk(double time) const {
+        return std::partition_point(m_chunks.begin(),
+                                    m_chunks.end(),
+                                    [&](const std::unique_ptr<GazeSessionChunk>& chunk) {
+                                        return chunk->lastTime < time;
+                                    }) -
+               m_chunks.begin();
+    }
+
+} // namespace eyetracking_core
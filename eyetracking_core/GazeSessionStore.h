@@ -0,0 +1,147 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "GazePipeline.h"
+
+namespace eyetracking_core {
+
+    // Coarse classification of each stored sample, from the fixation detector and the gaze events.
+    enum GazeSessionClass : uint8_t {
+        GazeSessionClass_None,
+        GazeSessionClass_Fixation,
+        GazeSessionClass_Saccade,
+        GazeSessionClassCount
+    };
+
+    // A chunk of consecutive samples, stored as one column per field. Timestamps are float offsets from the start of
+    // the chunk (exact to a few microseconds over the span of a chunk), and validity is a bitmap.
+    //
+    // This is also the on-disk layout of an exported session: a GazeSessionFileHeader followed by chunkCount chunks.
+    // Every chunk, including the last one, has the full size; only the first sampleCount entries of its columns are
+    // meaningful. Tools can therefore map the file and index the chunks directly.
+    struct alignas(64) GazeSessionChunk {
+        static constexpr uint32_t k_Samples = 4096;
+
+        double baseTime;
+        double lastTime;
+        uint32_t sampleCount;
+        uint32_t validCount;
+        uint32_t reserved[10];
+
+        float timeOffset[k_Samples];
+        float gazeTanX[2][k_Samples]; // [eye]
+        float gazeTanY[2][k_Samples]; // [eye]
+        uint64_t validBits[k_Samples / 64];
+        uint8_t classification[k_Samples]; // GazeSessionClass
+    };
+    static_assert(sizeof(GazeSessionChunk) == 64 + 4096 * 4 * 5 + 4096 / 8 + 4096);
+
+    constexpr uint32_t k_GazeSessionMagic = 0x43544550; // 'PETC'
+    constexpr uint32_t k_GazeSessionVersion = 1;
+
+    struct GazeSessionFileHeader {
+        uint32_t magic = k_GazeSessionMagic;
+        uint32_t version = k_GazeSessionVersion;
+        uint32_t chunkSize = sizeof(GazeSessionChunk);
+        uint32_t chunkCount = 0;
+        uint64_t sampleCount = 0;
+        uint8_t reserved[40]{};
+    };
+    static_assert(sizeof(GazeSessionFileHeader) == 64);
+
+    struct GazeSessionSummary {
+        uint32_t sampleCount = 0;
+        uint32_t validCount = 0;
+
+        // Over the valid samples.
+        EyeGazeTan meanGazeTan[2];
+        uint32_t classCount[GazeSessionClassCount]{};
+
+        // Direction of the mean gaze tangents, combining both eyes (radians).
+        float GetMeanYaw() const;
+        float GetMeanPitch() const;
+    };
+
+    // A copy of the chunks of a store, so that it can be written without holding up the thread adding samples.
+    struct GazeSessionSnapshot {
+        uint64_t sampleCount = 0;
+        std::vector<GazeSessionChunk> chunks;
+    };
+
+    // In-memory store of the gaze over a session, for on-device analytics. Samples are appended to chunks of columns,
+    // so that scans over a time range only read the fields they need, and aggregate several samples per instruction.
+    // The oldest chunks are recycled once maxChunks are in use.
+    //
+    // Timestamps must increase; a sample going back in time (eg: a looping replay) clears the store. Not thread-safe.
+    class GazeSessionStore {
+      public:
+        explicit GazeSessionStore(size_t maxChunks);
+
+        void Add(const GazeSample& sample);
+        void Clear();
+
+        // Aggregate the samples within [startTime, endTime).
+        GazeSessionSummary Summarize(double startTime, double endTime) const;
+
+        // Time (seconds) that the gaze spent within radius (radians) of the direction yaw/pitch (radians), among the
+        // samples within [startTime, endTime). Each valid sample counts until the next one, up to k_MaxSampleGap.
+        double GetTimeInCone(double startTime, double endTime, float yaw, float pitch, float radius) const;
+
+        // Only takes as long as copying the chunks in use.
+        void TakeSnapshot(GazeSessionSnapshot& snapshot) const;
+
+        uint64_t GetSampleCount() const;
+
+        double GetLatestTime() const {
+            return m_chunks.empty() ? 0.0 : m_chunks.back()->lastTime;
+        }
+
+        // Longest time a sample is assumed to last, so that tracking losses do not count in the cone.
+        static constexpr float k_MaxSampleGap = 0.1f;
+
+      private:
+        // Index range [first, last) of the samples of a chunk within [startTime, endTime).
+        static void FindRange(
+            const GazeSessionChunk& chunk, double startTime, double endTime, uint32_t& first, uint32_t& last);
+
+        // Index of the first chunk that may hold samples at or after the given time.
+        size_t FindChunk(double time) const;
+
+        const size_t m_maxChunks;
+        std::deque<std::unique_ptr<GazeSessionChunk>> m_chunks;
+        bool m_inSaccade = false;
+    };
+
+    // Write a snapshot in the chunked columnar layout described above.
+    bool WriteGazeSession(const GazeSessionSnapshot& snapshot, const std::string& path);
+
+} // namespace eyetracking_core
@@ -0,0 +1,107 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdlib>
+
+#include "GazeSettings.h"
+
+namespace {
+
+    bool ParseBool(const std::string& text, bool& value) {
+        if (text == "true" || text == "1") {
+            value = true;
+        } else if (text == "false" || text == "0") {
+            value = false;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    bool ParseInt32(const std::string& text, int32_t& value) {
+        char* end = nullptr;
+        const long parsed = strtol(text.c_str(), &end, 10);
+        if (text.empty() || *end) {
+            return false;
+        }
+        value = (int32_t)parsed;
+        return true;
+    }
+
+    bool ParseFloat(const std::string& text, float& value) {
+        char* end = nullptr;
+        const float parsed = strtof(text.c_str(), &end);
+        if (text.empty() || *end) {
+            return false;
+        }
+        value = parsed;
+        return true;
+    }
+
+} // namespace
+
+namespace eyetracking_core {
+
+    bool ApplySettingOverrides(GazeSettings& settings, const std::string& overrides) {
+        size_t start = 0;
+        while (start < overrides.size()) {
+            size_t end = overrides.find(';', start);
+            if (end == std::string::npos) {
+                end = overrides.size();
+            }
+            const std::string entry = overrides.substr(start, end - start);
+            start = end + 1;
+            if (entry.empty()) {
+                continue;
+            }
+
+            const size_t separator = entry.find('=');
+            if (separator == std::string::npos) {
+                return false;
+            }
+            const std::string key = entry.substr(0, separator);
+            const std::string value = entry.substr(separator + 1);
+
+            bool success = false;
+            if (key == "medianFilterWindow") {
+                success = ParseInt32(value, settings.medianFilterWindow);
+            } else if (key == "gazeDerivatives") {
+                success = ParseBool(value, settings.gazeDerivatives);
+            } else if (key == "gazeEvents") {
+                success = ParseBool(value, settings.gazeEvents);
+            } else if (key == "fixationDetector") {
+                success = ParseBool(value, settings.fixationDetector);
+            } else if (key == "fixationDispersion") {
+                success = ParseFloat(value, settings.fixationDispersion);
+            } else if (key == "fixationMinDurationMs") {
+                success = ParseInt32(value, settings.fixationMinDurationMs);
+            } else if (key == "pluginBudgetUs") {
+                success = ParseInt32(value, settings.pluginBudgetUs);
+            }
+            if (!success) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace eyetracking_core
@@ -0,0 +1,100 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace eyetracking_core {
+
+    // The settings of the processing of the gaze (see GazeUpdateLoop). The driver reads them from SteamVR, along with
+    // its own (see DriverSettings).
+    struct GazeSettings {
+        // When set, every sample received from the tracker is recorded to this file.
+        std::string recordFile;
+
+        // Skip publishing gaze updates that moved less than this angle (degrees) since the last published one. 0
+        // disables the deadband. An update is still published at least every deadbandKeepAliveMs.
+        float deadbandAngle = 0.f;
+        int32_t deadbandKeepAliveMs = 100;
+
+        // Window (in samples) of the median filter removing spikes from the gaze. 0 disables the filter.
+        int32_t medianFilterWindow = 0;
+
+        // Estimate the gaze angular velocity and acceleration.
+        bool gazeDerivatives = false;
+
+        // Detect fixations, saccades and blinks, and deliver them as vendor-specific events (see GazeEvents.h).
+        bool gazeEvents = false;
+
+        // Dispersion-threshold fixation detection: maximum dispersion (degrees) and minimum duration of a fixation.
+        bool fixationDetector = false;
+        float fixationDispersion = 1.f;
+        int32_t fixationMinDurationMs = 100;
+
+        // When set, accumulate a gaze heatmap and write it to <heatmapFile>-head.pfm and <heatmapFile>-world.pfm
+        // when the headset is deactivated. Older samples fade out with the given half-life (seconds), unless 0.
+        std::string heatmapFile;
+        float heatmapHalfLife = 0.f;
+
+        // Regions of interest to track the dwell time in (see LoadGazeRegions()). The statistics are written to
+        // <gazeRegionsFile>.csv when the headset is deactivated.
+        std::string gazeRegionsFile;
+
+        // Processing stages loaded from shared libraries (see GazePluginApi.h), as a list of "<path>[=<config>]"
+        // separated by semicolons. They run after the median filter, in order. A plugin is disabled if its average
+        // cost per sample exceeds pluginBudgetUs.
+        std::string plugins;
+        int32_t pluginBudgetUs = 500;
+
+        // Back the memory of the recording, history and heatmap with large pages, when available.
+        bool largePages = false;
+
+        // Keep a columnar store of the gaze over the last minutes of the session, for the session_* debug requests
+        // (see GazeSessionStore). 0 disables the store.
+        int32_t sessionStoreMinutes = 0;
+
+        // Run a candidate pipeline in shadow of the production one, and report how their outputs and cost differ (see
+        // ShadowPipeline). The candidate is the production pipeline with some processing settings overridden, as a list
+        // of "<setting>=<value>" separated by semicolons, eg: "medianFilterWindow=5;fixationDispersion=0.8". Empty
+        // disables it.
+        std::string shadowPipeline;
+
+        // Record the outputs of the shadow and production pipelines, for recording_diff.
+        std::string shadowRecordFile;
+
+        // Export the gaze to other processes through shared memory (see GazeExport.h).
+        bool gazeExport = false;
+
+        // Drop to the rate of idlePollPeriodMs while nothing consumes the gaze (see ConsumerDemand.h).
+        bool demandDrivenRate = false;
+
+        // How often the eye tracker is polled while nothing consumes the gaze.
+        int32_t idlePollPeriodMs = 100;
+    };
+
+    // Apply a list of "<setting>=<value>" separated by semicolons to a copy of the settings. Only the settings of the
+    // processing pipeline can be overridden. Returns false upon an unknown setting or an invalid value.
+    bool ApplySettingOverrides(GazeSettings& settings, const std::string& overrides);
+
+} // namespace eyetracking_core
@@ -0,0 +1,628 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cfloat>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "Clock.h"
+#include "FixationDetector.h"
+#include "GazeDerivativeStage.h"
+#include "GazeEventDetector.h"
+#include "GazePluginStage.h"
+#include "GazeUpdateLoop.h"
+#include "MedianFilterStage.h"
+#include "Platform.h"
+#include "PublishDeadband.h"
+#include "StartupTimeline.h"
+#include "Tracing.h"
+
+namespace {
+    using namespace eyetracking_core;
+
+    constexpr float k_RadiansToDegrees = 180.f / 3.14159265f;
+
+    // The response to a debug request.
+    std::string Format(const char* format, ...) {
+        char buffer[512];
+        va_list args;
+        va_start(args, format);
+        vsnprintf(buffer, sizeof(buffer), format, args);
+        va_end(args);
+        return buffer;
+    }
+
+} // namespace
+
+namespace eyetracking_core {
+
+    GazeUpdateLoop::GazeUpdateLoop(std::shared_ptr<EyeTrackerSource> source, Host& host, const GazeSettings& settings)
+        : m_source(std::move(source)), m_host(host), m_settings(settings), m_arena(k_ArenaSize, settings.largePages),
+          m_recorder(&m_arena), m_history(&m_arena) {
+        StartupStep step("GazeUpdateLoop::GazeUpdateLoop");
+
+        if (!settings.recordFile.empty() && !m_recorder.Open(settings.recordFile)) {
+            Log("Failed to open recording file: %s", settings.recordFile.c_str());
+        }
+        if (!settings.heatmapFile.empty()) {
+            m_heatmap = std::make_unique<GazeHeatmap>(settings.heatmapHalfLife, &m_arena);
+        }
+        if (settings.sessionStoreMinutes > 0) {
+            const double samples = settings.sessionStoreMinutes * 60.0 * k_MaxSampleRate;
+            const size_t chunks = (size_t)(samples / GazeSessionChunk::k_Samples) + 1;
+            m_sessionStore = std::make_unique<GazeSessionStore>(chunks);
+        }
+        if (settings.gazeExport && !m_gazeExport.Open()) {
+            Log("Failed to export the gaze: %s", k_GazeExportName);
+        }
+        if (!settings.gazeRegionsFile.empty()) {
+            LoadRegions(settings.gazeRegionsFile);
+        }
+        if (settings.demandDrivenRate) {
+            // The consumers configured in the settings need every sample.
+            const bool alwaysOn = !settings.recordFile.empty() || !settings.heatmapFile.empty() ||
+                                  settings.sessionStoreMinutes > 0 || !settings.gazeRegionsFile.empty() ||
+                                  !settings.shadowPipeline.empty();
+            m_demand = std::make_unique<ConsumerDemand>(alwaysOn, &m_gazeExport, [this] { Wake(); });
+        }
+
+        BuildPipeline(m_pipeline, settings);
+        if (!settings.shadowPipeline.empty()) {
+            GazeSettings candidateSettings = settings;
+            if (ApplySettingOverrides(candidateSettings, settings.shadowPipeline)) {
+                Log("Building shadow pipeline: %s", settings.shadowPipeline.c_str());
+                GazePipeline candidate;
+                BuildPipeline(candidate, candidateSettings);
+                m_shadowPipeline = std::make_unique<ShadowPipeline>(std::move(candidate), &m_arena);
+                if (!settings.shadowRecordFile.empty() && !m_shadowPipeline->OpenRecording(settings.shadowRecordFile)) {
+                    Log("Failed to open shadow recording file: %s", settings.shadowRecordFile.c_str());
+                }
+            } else {
+                Log("Invalid shadow pipeline settings: %s", settings.shadowPipeline.c_str());
+            }
+        }
+
+        Log("Arena: %zu of %zu bytes used, %s pages",
+            m_arena.GetUsed(),
+            m_arena.GetCapacity(),
+            m_arena.HasLargePages() ? "large" : "regular");
+    }
+
+    GazeUpdateLoop::~GazeUpdateLoop() {
+        // The host must have waited for Run() to return.
+        Stop();
+    }
+
+    void GazeUpdateLoop::Start() {
+        m_startTime = std::chrono::steady_clock::now();
+        m_active = true;
+    }
+
+    bool GazeUpdateLoop::Stop() {
+        if (!m_active.exchange(false)) {
+            return false;
+        }
+        Wake();
+        return true;
+    }
+
+    void GazeUpdateLoop::Wake() {
+        {
+            // Synchronize with the wait in Run(), so that the wake-up below cannot be missed.
+            std::unique_lock lock(m_pushedSampleMutex);
+        }
+        m_pushedSampleCondition.notify_all();
+    }
+
+    void GazeUpdateLoop::Run() {
+        TraceLocalActivity(local);
+        TraceLoggingWriteStart(local, "GazeUpdateLoop_Run");
+        MarkStartupEvent("UpdateThread");
+
+        Log("Hello from GazeUpdateLoop::Run");
+
+        // Prefer to be woken up by the source when a sample arrives, which eliminates the polling latency.
+        const bool isEventDriven = m_source->SupportsCallback() &&
+                                   m_source->StartCallbacks([&](const EyeTrackerSample& sample) {
+                                       {
+                                           std::unique_lock lock(m_pushedSampleMutex);
+                                           if (m_hasPushedSample) {
+                                               m_host.OnDroppedSample();
+                                           }
+                                           m_pushedSample = sample;
+                                           m_hasPushedSample = true;
+                                       }
+                                       m_pushedSampleCondition.notify_one();
+                                   });
+        TraceLoggingWriteTagged(
+            local, "GazeUpdateLoop_Run", TLArg(m_source->GetName(), "Source"), TLArg(isEventDriven, "EventDriven"));
+        if (m_demand && isEventDriven) {
+            // The source pushes at its own rate, there is nothing to slow down.
+            Log("Ignoring demandDrivenRate with an event-driven source");
+        }
+        Log("Eye tracker source %s is %s", m_source->GetName(), isEventDriven ? "event-driven" : "polled");
+
+        // Most updates during a fixation barely move, and each of them is a costly input update in vrserver.
+        PublishDeadband deadband;
+        deadband.Configure(m_settings.deadbandAngle, m_settings.deadbandKeepAliveMs / 1000.0);
+
+        m_pipeline.Reset();
+        if (m_shadowPipeline) {
+            m_shadowPipeline->Start();
+        }
+        m_host.OnStart();
+        if (m_demand) {
+            m_demand->Reset();
+        }
+        const double idlePollPeriod = std::max(m_settings.idlePollPeriodMs, 1) / 1000.0;
+
+        bool isFirstValidSample = true;
+        double lastSampleTime = 0.0;
+        while (true) {
+            EyeTrackerSample sample;
+            bool isTimeout = false;
+
+            // Without consumers, poll at the keep-alive rate until one shows up.
+            const uint32_t demandGeneration = m_demand ? m_demand->GetGeneration() : 0;
+            const bool isIdle = m_demand && !isEventDriven && !m_demand->Update();
+
+            // Wait for the next time to update.
+            {
+                TraceLocalActivity(sleep);
+                TraceLoggingWriteStart(sleep, "GazeUpdateLoop_Run_Sleep");
+
+                std::unique_lock lock(m_pushedSampleMutex);
+                if (isEventDriven) {
+                    GetClock().WaitFor(lock, m_pushedSampleCondition, k_PushTimeout, [&] {
+                        return m_hasPushedSample || !m_active;
+                    });
+                    if (m_hasPushedSample) {
+                        sample = m_pushedSample;
+                        m_hasPushedSample = false;
+                    } else {
+                        // The source stopped delivering. Keep the clock running so that the loss is timed.
+                        isTimeout = true;
+                        sample.timeInSeconds = lastSampleTime + k_PushTimeout;
+                    }
+                } else {
+                    // We refresh the data at this frequency. Stop() and new consumers interrupt the wait.
+                    GetClock().WaitFor(lock, m_pushedSampleCondition, isIdle ? idlePollPeriod : k_PollPeriod, [&] {
+                        return !m_active || (isIdle && m_demand->GetGeneration() != demandGeneration);
+                    });
+                }
+
+                TraceLoggingWriteStop(sleep, "GazeUpdateLoop_Run_Sleep", TLArg(m_active.load(), "Active"));
+
+                if (!m_active) {
+                    break;
+                }
+            }
+
+            // Retrieve the data from the eye tracker and hand it to the host.
+            if (!isEventDriven) {
+                m_source->GetLatestSample(sample);
+
+                // The tracker runs slower than the polling, and returns the same sample until it has the next one.
+                if (sample.timeInSeconds == lastSampleTime) {
+                    continue;
+                }
+            }
+
+            if (!isTimeout) {
+                m_host.OnSample(sample.timeInSeconds);
+            }
+
+            // A timeout is not a sample from the tracker: replays and dropout statistics must not see it.
+            if (m_recorder.IsOpen() && !isTimeout) {
+                GazeRecordingRecord record{};
+                record.timeInSeconds = sample.timeInSeconds;
+                for (int eye = 0; eye < 2; eye++) {
+                    record.gazeTan[eye][0] = sample.gazeTan[eye].x;
+                    record.gazeTan[eye][1] = sample.gazeTan[eye].y;
+                }
+                record.flags = sample.isValid ? (uint32_t)GazeRecordingFlags_Valid : 0;
+                m_recorder.Write(record);
+            }
+
+            lastSampleTime = sample.timeInSeconds;
+
+            GazeSample gaze = MakeGazeSample(sample);
+            if (m_shadowPipeline) {
+                const GazeSample input = gaze;
+                m_pipeline.Process(gaze);
+                m_shadowPipeline->Push(input, gaze);
+            } else {
+                m_pipeline.Process(gaze);
+            }
+            TraceLoggingWriteTagged(local,
+                                    "GazeUpdateLoop_Gaze",
+                                    TLArg(gaze.isValid, "Valid"),
+                                    TLArg(gaze.yaw, "Yaw"),
+                                    TLArg(gaze.pitch, "Pitch"),
+                                    TLArg(gaze.angularVelocity, "AngularVelocity"),
+                                    TLArg(gaze.angularAcceleration, "AngularAcceleration"),
+                                    TLArg(gaze.isFixation, "Fixation"));
+            if (m_gazeExport.IsOpen()) {
+                m_gazeExport.Publish(gaze);
+            }
+            {
+                std::unique_lock lock(m_historyMutex);
+                m_history.Add(gaze);
+            }
+            if (m_sessionStore) {
+                std::unique_lock lock(m_sessionMutex);
+                m_sessionStore->Add(gaze);
+            }
+            m_regionTracker.Process(gaze);
+            if (gaze.isValid) {
+                float worldDirection[3];
+                const bool hasWorldDirection = m_host.ProcessWorldGaze(gaze, m_heatmap != nullptr, worldDirection);
+                if (m_heatmap) {
+                    std::unique_lock lock(m_heatmapMutex);
+                    m_heatmap->Add(gaze, hasWorldDirection ? worldDirection : nullptr);
+                }
+            }
+
+            // Fallback to identity.
+            static constexpr float k_Identity[3] = {0.f, 0.f, -1.f};
+            const float* const direction = gaze.isValid ? gaze.direction : k_Identity;
+            if (deadband.ShouldPublish(direction, gaze.isValid, GetClock().Now())) {
+                m_host.Publish(gaze.isValid, direction);
+            }
+
+            if (gaze.events) {
+                m_host.PublishEvents(gaze);
+            }
+
+            // The tracker reports invalid samples until it is calibrated and sees the eyes: only a valid gaze marks the
+            // end of the startup.
+            if (isFirstValidSample && gaze.isValid) {
+                const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - m_startTime);
+                TraceLoggingWriteTagged(
+                    local, "GazeUpdateLoop_FirstSample", TLArg(latency.count(), "StartToFirstSampleUs"));
+                Log("First valid eye gaze update %lld us after the start", (long long)latency.count());
+                MarkStartupEvent("FirstEyeTrackingUpdate");
+                ReportStartupTimeline();
+                isFirstValidSample = false;
+            }
+        }
+
+        GetClock().OnThreadExit();
+        if (isEventDriven) {
+            m_source->StopCallbacks();
+        }
+
+        m_pipeline.ReportStatistics();
+        if (m_shadowPipeline) {
+            m_shadowPipeline->Stop();
+            m_shadowPipeline->Report(m_pipeline);
+        }
+        if (m_gazeExport.IsOpen()) {
+            m_gazeExport.ReportStatistics();
+        }
+        if (m_demand) {
+            m_demand->ReportStatistics();
+        }
+
+        // In case no valid gaze update ever made it through.
+        ReportStartupTimeline();
+
+        TraceLoggingWriteTagged(local,
+                                "GazeUpdateLoop_Deadband",
+                                TLArg(deadband.GetPublishedCount(), "Published"),
+                                TLArg(deadband.GetSuppressedCount(), "Suppressed"),
+                                TLArg(deadband.GetSuppressedFraction(), "SuppressedFraction"));
+        Log("Published %llu gaze updates, suppressed %llu (%.1f%%)",
+            (unsigned long long)deadband.GetPublishedCount(),
+            (unsigned long long)deadband.GetSuppressedCount(),
+            deadband.GetSuppressedFraction() * 100.f);
+
+        if (m_heatmap) {
+            WriteHeatmap();
+        }
+        if (!m_settings.gazeRegionsFile.empty()) {
+            std::vector<GazeRegionTracker::Statistics> statistics;
+            m_regionTracker.GetStatistics(statistics);
+            const std::string path = m_settings.gazeRegionsFile + ".csv";
+            if (!WriteGazeRegionStatistics(statistics, path)) {
+                Log("Failed to write gaze region statistics to %s", path.c_str());
+            }
+        }
+
+        Log("Bye from GazeUpdateLoop::Run");
+
+        TraceLoggingWriteStop(local, "GazeUpdateLoop_Run");
+    }
+
+    bool GazeUpdateLoop::HandleDebugRequest(const char* request, std::string& response) {
+        // "gaze_history [seconds]" summarizes the gaze over the last seconds (default 60).
+        static constexpr char k_GazeHistoryRequest[] = "gaze_history";
+        if (!strncmp(request, k_GazeHistoryRequest, sizeof(k_GazeHistoryRequest) - 1)) {
+            const double seconds = std::max(atof(request + sizeof(k_GazeHistoryRequest) - 1), 0.0);
+            GazeSummary summary;
+            {
+                std::unique_lock lock(m_historyMutex);
+                const double endTime = m_history.GetLatestTime() + 0.001;
+                summary = m_history.Query(endTime - (seconds > 0.0 ? seconds : 60.0), endTime);
+            }
+            response = Format("samples=%u valid=%.3f yaw=%.4f/%.4f/%.4f pitch=%.4f/%.4f/%.4f velocity=%.1f/%.1f/%.1f",
+                              summary.sampleCount,
+                              summary.GetValidFraction(),
+                              summary.min[GazeSummary::Yaw],
+                              summary.GetMean(GazeSummary::Yaw),
+                              summary.max[GazeSummary::Yaw],
+                              summary.min[GazeSummary::Pitch],
+                              summary.GetMean(GazeSummary::Pitch),
+                              summary.max[GazeSummary::Pitch],
+                              summary.min[GazeSummary::AngularVelocity],
+                              summary.GetMean(GazeSummary::AngularVelocity),
+                              summary.max[GazeSummary::AngularVelocity]);
+            return true;
+        }
+
+        // "session_summary [seconds]" aggregates the session store over the last seconds (default: all of it).
+        static constexpr char k_SessionSummaryRequest[] = "session_summary";
+        if (!strncmp(request, k_SessionSummaryRequest, sizeof(k_SessionSummaryRequest) - 1)) {
+            if (!m_sessionStore) {
+                response = "error";
+                return true;
+            }
+            const double seconds = std::max(atof(request + sizeof(k_SessionSummaryRequest) - 1), 0.0);
+            GazeSessionSummary summary;
+            {
+                std::unique_lock lock(m_sessionMutex);
+                const double endTime = m_sessionStore->GetLatestTime() + 0.001;
+                summary = m_sessionStore->Summarize(seconds > 0.0 ? endTime - seconds : -DBL_MAX, endTime);
+            }
+            response = Format("samples=%u valid=%u yaw=%.4f pitch=%.4f fixation=%u saccade=%u",
+                              summary.sampleCount,
+                              summary.validCount,
+                              summary.GetMeanYaw(),
+                              summary.GetMeanPitch(),
+                              summary.classCount[GazeSessionClass_Fixation],
+                              summary.classCount[GazeSessionClass_Saccade]);
+            return true;
+        }
+
+        // "session_cone <yaw> <pitch> <radius> [seconds]" returns the time (seconds) spent by the gaze within radius of
+        // the yaw/pitch direction (degrees) over the last seconds (default: all of the session store).
+        static constexpr char k_SessionConeRequest[] = "session_cone ";
+        if (!strncmp(request, k_SessionConeRequest, sizeof(k_SessionConeRequest) - 1)) {
+            float yaw = 0.f, pitch = 0.f, radius = 0.f;
+            double seconds = 0.0;
+            const int count =
+                sscanf(request + sizeof(k_SessionConeRequest) - 1, "%f %f %f %lf", &yaw, &pitch, &radius, &seconds);
+            if (!m_sessionStore || count < 3) {
+                response = "error";
+                return true;
+            }
+            double time;
+            {
+                std::unique_lock lock(m_sessionMutex);
+                const double endTime = m_sessionStore->GetLatestTime() + 0.001;
+                time = m_sessionStore->GetTimeInCone(seconds > 0.0 ? endTime - seconds : -DBL_MAX,
+                                                     endTime,
+                                                     yaw / k_RadiansToDegrees,
+                                                     pitch / k_RadiansToDegrees,
+                                                     radius / k_RadiansToDegrees);
+            }
+            response = Format("%.3f", time);
+            return true;
+        }
+
+        // "session_export <path>" writes the session store in its columnar layout (see GazeSessionFileHeader).
+        static constexpr char k_SessionExportRequest[] = "session_export ";
+        if (!strncmp(request, k_SessionExportRequest, sizeof(k_SessionExportRequest) - 1)) {
+            const std::string path = request + sizeof(k_SessionExportRequest) - 1;
+            bool success = false;
+            if (m_sessionStore) {
+                // Write outside of the lock, which the update thread takes for every sample.
+                GazeSessionSnapshot snapshot;
+                {
+                    std::unique_lock lock(m_sessionMutex);
+                    m_sessionStore->TakeSnapshot(snapshot);
+                }
+                success = WriteGazeSession(snapshot, path);
+            }
+            response = success ? path : "error";
+            return true;
+        }
+
+        // "shadow" compares the shadow pipeline with the production one so far.
+        if (!strcmp(request, "shadow")) {
+            if (!m_shadowPipeline) {
+                response = "error";
+                return true;
+            }
+            const ShadowPipeline::Statistics statistics = m_shadowPipeline->GetStatistics();
+            response = Format("samples=%llu dropped=%llu divergence=%.3f/%.3f/%.3f/%.3f validity=%llu fixation=%llu "
+                              "events=%llu cost=%lld",
+                              (unsigned long long)statistics.samples,
+                              (unsigned long long)statistics.dropped,
+                              statistics.meanDivergence,
+                              statistics.p95Divergence,
+                              statistics.p99Divergence,
+                              statistics.maxDivergence,
+                              (unsigned long long)statistics.validityMismatches,
+                              (unsigned long long)statistics.fixationMismatches,
+                              (unsigned long long)statistics.eventMismatches,
+                              statistics.samples ? (long long)(statistics.candidateNs / statistics.samples) : 0ll);
+            return true;
+        }
+
+        // "gaze_heatmap" writes the heatmap accumulated so far.
+        if (!strcmp(request, "gaze_heatmap")) {
+            const bool success = m_heatmap && WriteHeatmap();
+            response = success ? m_settings.heatmapFile : "error";
+            return true;
+        }
+
+        // "gaze_regions_load <path>" replaces the regions of interest, "gaze_regions_stats <path>" writes their
+        // statistics.
+        static constexpr char k_LoadRegionsRequest[] = "gaze_regions_load ";
+        static constexpr char k_RegionStatisticsRequest[] = "gaze_regions_stats ";
+        if (!strncmp(request, k_LoadRegionsRequest, sizeof(k_LoadRegionsRequest) - 1)) {
+            const bool success = LoadRegions(request + sizeof(k_LoadRegionsRequest) - 1);
+            response = success ? std::to_string(m_regionTracker.GetRegionCount()) : "error";
+            return true;
+        }
+        if (!strncmp(request, k_RegionStatisticsRequest, sizeof(k_RegionStatisticsRequest) - 1)) {
+            std::vector<GazeRegionTracker::Statistics> statistics;
+            m_regionTracker.GetStatistics(statistics);
+            const bool success =
+                WriteGazeRegionStatistics(statistics, request + sizeof(k_RegionStatisticsRequest) - 1);
+            response = success ? "ok" : "error";
+            return true;
+        }
+
+        // "advance_time <seconds>" moves the virtual clock forward (see SetVirtualTime()).
+        static constexpr char k_AdvanceTimeRequest[] = "advance_time ";
+        if (!strncmp(request, k_AdvanceTimeRequest, sizeof(k_AdvanceTimeRequest) - 1)) {
+            VirtualClock* const clock = GetVirtualClock();
+            if (clock) {
+                clock->Advance(std::max(atof(request + sizeof(k_AdvanceTimeRequest) - 1), 0.0));
+                response = Format("%.6f", clock->Now());
+            } else {
+                response = "error";
+            }
+            return true;
+        }
+
+        // "subscribe <seconds>" holds the full rate (with the demandDrivenRate setting), "unsubscribe" releases it, and
+        // "demand" returns whether the rate is reduced and the processor time saved so far.
+        static constexpr char k_SubscribeRequest[] = "subscribe ";
+        if (!strncmp(request, k_SubscribeRequest, sizeof(k_SubscribeRequest) - 1)) {
+            const double seconds = std::max(atof(request + sizeof(k_SubscribeRequest) - 1), 0.0);
+            if (m_demand && seconds > 0.0) {
+                m_demand->Subscribe(seconds);
+            }
+            response = m_demand && seconds > 0.0 ? "ok" : "error";
+            return true;
+        }
+        if (!strcmp(request, "unsubscribe")) {
+            if (m_demand) {
+                m_demand->Unsubscribe();
+            }
+            response = m_demand ? "ok" : "error";
+            return true;
+        }
+        if (!strcmp(request, "demand")) {
+            if (!m_demand) {
+                response = "error";
+                return true;
+            }
+            const ConsumerDemand::Statistics statistics = m_demand->GetStatistics();
+            response = Format("idle=%d full=%.1f/%.3f idle=%.1f/%.3f saved=%.3f",
+                              m_demand->IsIdle() ? 1 : 0,
+                              statistics.fullSeconds,
+                              statistics.fullCpuSeconds,
+                              statistics.idleSeconds,
+                              statistics.idleCpuSeconds,
+                              statistics.savedCpuSeconds);
+            return true;
+        }
+
+        return false;
+    }
+
+    void GazeUpdateLoop::BuildPipeline(GazePipeline& pipeline, const GazeSettings& settings) {
+        if (settings.medianFilterWindow > 1) {
+            pipeline.AddStage(std::make_unique<MedianFilterStage>(settings.medianFilterWindow));
+        }
+        LoadPlugins(pipeline, settings.plugins, std::chrono::microseconds(settings.pluginBudgetUs));
+        if (settings.gazeDerivatives) {
+            // 35 ms at 200 Hz, quadratic fit.
+            pipeline.AddStage(std::make_unique<GazeDerivativeStage<7, 2>>());
+        }
+        if (settings.fixationDetector) {
+            FixationDetector::Parameters parameters;
+            parameters.dispersion = settings.fixationDispersion;
+            parameters.minDuration = std::max(settings.fixationMinDurationMs, 0) / 1000.0;
+            pipeline.AddStage(std::make_unique<FixationDetector>(parameters));
+        }
+        if (settings.gazeEvents) {
+            pipeline.AddStage(std::make_unique<GazeEventDetector>());
+        }
+    }
+
+    // Add a stage for each plugin of a list of "<path>[=<config>]" separated by semicolons.
+    void GazeUpdateLoop::LoadPlugins(GazePipeline& pipeline,
+                                     const std::string& plugins,
+                                     std::chrono::microseconds budget) {
+        size_t start = 0;
+        while (start < plugins.size()) {
+            size_t end = plugins.find(';', start);
+            if (end == std::string::npos) {
+                end = plugins.size();
+            }
+            const std::string entry = plugins.substr(start, end - start);
+            start = end + 1;
+            if (entry.empty()) {
+                continue;
+            }
+
+            const size_t separator = entry.find('=');
+            const std::string path = entry.substr(0, separator);
+            const std::string config = separator != std::string::npos ? entry.substr(separator + 1) : "";
+            std::unique_ptr<GazePluginStage> stage = GazePluginStage::Load(path, config, budget);
+            if (stage) {
+                pipeline.AddStage(std::move(stage));
+            }
+        }
+    }
+
+    bool GazeUpdateLoop::LoadRegions(const std::string& path) {
+        std::vector<GazeRegion> regions;
+        if (!LoadGazeRegions(path, regions)) {
+            Log("Failed to load gaze regions from %s", path.c_str());
+            return false;
+        }
+        Log("Loaded %zu gaze regions from %s", regions.size(), path.c_str());
+        m_regionTracker.SetRegions(std::move(regions));
+        return true;
+    }
+
+    // Snapshot the heatmap (briefly blocking the update thread) and write it to the files from the settings.
+    bool GazeUpdateLoop::WriteHeatmap() {
+        GazeHeatmapSnapshot snapshot;
+        uint64_t outOfRangeCount;
+        {
+            std::unique_lock lock(m_heatmapMutex);
+            m_heatmap->TakeSnapshot(snapshot);
+            outOfRangeCount = m_heatmap->GetOutOfRangeCount();
+        }
+        const bool success = WriteGazeHeatmap(snapshot, m_settings.heatmapFile);
+        Log("%s gaze heatmap of %llu samples (%llu out of range) to %s",
+            success ? "Wrote" : "Failed to write",
+            (unsigned long long)snapshot.sampleCount,
+            (unsigned long long)outOfRangeCount,
+            m_settings.heatmapFile.c_str());
+        return success;
+    }
+
+} // namespace eyetracking_core
@@ -0,0 +1,169 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "Arena.h"
+#include "ConsumerDemand.h"
+#include "EyeTrackerSource.h"
+#include "GazeExportChannel.h"
+#include "GazeHeatmap.h"
+#include "GazeHistory.h"
+#include "GazePipeline.h"
+#include "GazeRecording.h"
+#include "GazeRegionTracker.h"
+#include "GazeSessionStore.h"
+#include "GazeSettings.h"
+#include "ShadowPipeline.h"
+
+namespace eyetracking_core {
+
+    // The update thread of the driver. It takes the samples from the eye tracker (pushed by the source, or polled at a
+    // fixed rate), runs them through the processing pipeline, feeds the consumers enabled in the settings (recording,
+    // shadow pipeline, export, history, session store, regions, heatmap), and hands the gaze to the host, skipping the
+    // updates that barely moved (see PublishDeadband). The host only provides the glue to its runtime, eg: the OpenVR
+    // input component and events of the driver.
+    class GazeUpdateLoop {
+      public:
+        // How long without a pushed sample before we report the eye tracker as not tracking.
+        static constexpr double k_PushTimeout = 0.1;
+
+        // How often sources that cannot push samples are polled.
+        static constexpr double k_PollPeriod = 0.005;
+
+        // Highest rate of the eye tracker that the session store is sized for.
+        static constexpr double k_MaxSampleRate = 250.0;
+
+        // Enough for the recording buffer, the history, the heatmap and the shadow pipeline queue (about 1.4 MB),
+        // rounded up to a large page.
+        static constexpr size_t k_ArenaSize = 2 * 1024 * 1024;
+
+        // What the host does with the gaze. Called from the thread running Run().
+        class Host {
+          public:
+            virtual ~Host() = default;
+
+            // Deliver the gaze to the application. The direction is the identity when the gaze is invalid.
+            virtual void Publish(bool isValid, const float direction[3]) = 0;
+
+            // Deliver the events raised on a sample (see GazeEvents.h).
+            virtual void PublishEvents([[maybe_unused]] const GazeSample& gaze) {
+            }
+
+            // Called with every valid gaze before it is published, for the processing of the host in world space, eg:
+            // casting the gaze into the scene. Returns whether worldDirection was set to the direction of the gaze in
+            // world space (eg: from the pose of the headset), which the heatmap needs when needsWorldDirection is set.
+            virtual bool ProcessWorldGaze([[maybe_unused]] const GazeSample& gaze,
+                                          [[maybe_unused]] bool needsWorldDirection,
+                                          [[maybe_unused]] float worldDirection[3]) {
+                return false;
+            }
+
+            // The health of the loop: when it starts, every sample received from the tracker, and every pushed sample
+            // that was replaced before the loop could take it.
+            virtual void OnStart() {
+            }
+            virtual void OnSample([[maybe_unused]] double timeInSeconds) {
+            }
+            virtual void OnDroppedSample() {
+            }
+        };
+
+        GazeUpdateLoop(std::shared_ptr<EyeTrackerSource> source, Host& host, const GazeSettings& settings);
+        ~GazeUpdateLoop();
+
+        GazeUpdateLoop(const GazeUpdateLoop&) = delete;
+        GazeUpdateLoop& operator=(const GazeUpdateLoop&) = delete;
+
+        // Start() must be called before handing Run() to a thread, which then processes the samples until Stop().
+        // Stop() returns false when the loop was not started, otherwise the host must wait for Run() to return. The
+        // loop can be started again once stopped.
+        void Start();
+        void Run();
+        bool Stop();
+
+        // Answer a debug request forwarded by the host: gaze_history, session_summary, session_cone, session_export,
+        // shadow, gaze_heatmap, gaze_regions_load, gaze_regions_stats, advance_time, subscribe, unsubscribe and demand
+        // (see the README). Returns false for any other request.
+        bool HandleDebugRequest(const char* request, std::string& response);
+
+        // Only with the demandDrivenRate setting.
+        const ConsumerDemand* GetConsumerDemand() const {
+            return m_demand.get();
+        }
+
+      private:
+        void BuildPipeline(GazePipeline& pipeline, const GazeSettings& settings);
+        void LoadPlugins(GazePipeline& pipeline, const std::string& plugins, std::chrono::microseconds budget);
+        bool LoadRegions(const std::string& path);
+        bool WriteHeatmap();
+        void Wake();
+
+        const std::shared_ptr<EyeTrackerSource> m_source;
+        Host& m_host;
+        const GazeSettings m_settings;
+
+        std::atomic<bool> m_active = false;
+        std::chrono::steady_clock::time_point m_startTime;
+
+        // Backs the buffers below. Declared first, so that it outlives them.
+        Arena m_arena;
+        GazeRecordingWriter m_recorder;
+        GazePipeline m_pipeline;
+
+        // Only when enabled in the settings. Fed by the update thread, never used for what is published.
+        std::unique_ptr<ShadowPipeline> m_shadowPipeline;
+
+        // Written by the update thread, queried through HandleDebugRequest().
+        std::mutex m_historyMutex;
+        GazeHistory m_history;
+
+        GazeRegionTracker m_regionTracker;
+
+        // Only when enabled in the settings.
+        std::mutex m_sessionMutex;
+        std::unique_ptr<GazeSessionStore> m_sessionStore;
+
+        // Only when enabled in the settings.
+        std::mutex m_heatmapMutex;
+        std::unique_ptr<GazeHeatmap> m_heatmap;
+
+        GazeExportWriter m_gazeExport;
+
+        std::mutex m_pushedSampleMutex;
+        std::condition_variable m_pushedSampleCondition;
+        EyeTrackerSample m_pushedSample;
+        bool m_hasPushedSample = false;
+
+        // Only when enabled in the settings. Declared after the export and the condition it wakes up.
+        std::unique_ptr<ConsumerDemand> m_demand;
+    };
+
+} // namespace eyetracking_core
@@ -0,0 +1,94 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cmath>
+
+#include "MedianFilterStage.h"
+#include "Platform.h"
+
+namespace eyetracking_core {
+
+    RunningMedian::RunningMedian(size_t window) : m_window(std::clamp(window, (size_t)1, k_MaxWindow)) {
+    }
+
+    float RunningMedian::Update(float value) {
+        if (m_size == m_window) {
+            // Remove the oldest value from the sorted array.
+            const float oldest = m_ring[m_head];
+            float* const position = std::lower_bound(m_sorted, m_sorted + m_size, oldest);
+            std::copy(position + 1, m_sorted + m_size, position);
+            m_size--;
+
+            m_ring[m_head] = value;
+            m_head = (m_head + 1) % m_window;
+        } else {
+            m_ring[(m_head + m_size) % m_window] = value;
+        }
+
+        // Insert the new value in the sorted array.
+        float* const position = std::upper_bound(m_sorted, m_sorted + m_size, value);
+        std::copy_backward(position, m_sorted + m_size, m_sorted + m_size + 1);
+        *position = value;
+        m_size++;
+
+        return m_size % 2 ? m_sorted[m_size / 2] : (m_sorted[m_size / 2 - 1] + m_sorted[m_size / 2]) / 2.f;
+    }
+
+    void RunningMedian::Reset() {
+        m_head = m_size = 0;
+    }
+
+    MedianFilterStage::MedianFilterStage(size_t window)
+        : m_filters{{RunningMedian(window), RunningMedian(window)}, {RunningMedian(window), RunningMedian(window)}} {
+        if (window > RunningMedian::k_MaxWindow) {
+            Log("Median filter window %zu is too large, using %zu", window, RunningMedian::k_MaxWindow);
+        }
+    }
+
+    void MedianFilterStage::Process(GazeSample& sample) {
+        // A NaN would break the order of the sorted windows, and with it every later median.
+        for (int eye = 0; eye < 2 && sample.isValid; eye++) {
+            sample.isValid = std::isfinite(sample.gazeTan[eye].x) && std::isfinite(sample.gazeTan[eye].y);
+        }
+        if (!sample.isValid) {
+            // Do not let the values from before a tracking loss bleed into the next ones.
+            Reset();
+            return;
+        }
+
+        for (int eye = 0; eye < 2; eye++) {
+            sample.gazeTan[eye].x = m_filters[eye][0].Update(sample.gazeTan[eye].x);
+            sample.gazeTan[eye].y = m_filters[eye][1].Update(sample.gazeTan[eye].y);
+        }
+
+        UpdateGazeAngles(sample);
+    }
+
+    void MedianFilterStage::Reset() {
+        for (int eye = 0; eye < 2; eye++) {
+            m_filters[eye][0].Reset();
+            m_filters[eye][1].Reset();
+        }
+    }
+
+} // namespace eyetracking_core
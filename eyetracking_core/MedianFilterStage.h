@@ -0,0 +1,69 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+
+#include "GazePipeline.h"
+
+namespace eyetracking_core {
+
+    // Running median of the last N values of a single channel, for small N. The window is kept both in arrival order
+    // (a ring) and in sorted order: each update is a binary search plus a short move within a fixed-size array.
+    class RunningMedian {
+      public:
+        static constexpr size_t k_MaxWindow = 15;
+
+        explicit RunningMedian(size_t window = 3);
+
+        // Add a value and return the median of the window, or of the values seen so far if the window is not full.
+        float Update(float value);
+        void Reset();
+
+      private:
+        const size_t m_window;
+        float m_ring[k_MaxWindow]{};
+        float m_sorted[k_MaxWindow]{};
+        size_t m_head = 0;
+        size_t m_size = 0;
+    };
+
+    // Removes single-sample spikes (eg: reflections) from each eye's gaze, by replacing each axis with its median over
+    // a short window. Compared to low-pass filtering, this rejects outliers with little lag: (window - 1) / 2 samples.
+    // Samples that are not finite are marked invalid. The window is limited to RunningMedian::k_MaxWindow.
+    class MedianFilterStage : public GazeStage {
+      public:
+        explicit MedianFilterStage(size_t window);
+
+        const char* GetName() const override {
+            return "MedianFilterStage";
+        }
+
+        void Process(GazeSample& sample) override;
+        void Reset() override;
+
+      private:
+        RunningMedian m_filters[2][2]; // [eye][x/y]
+    };
+
+} // namespace eyetracking_core
@@ -0,0 +1,280 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "Platform.h"
+
+namespace {
+
+    std::atomic<eyetracking_core::LogSink> g_logSink = nullptr;
+
+} // namespace
+
+namespace eyetracking_core {
+
+    void SetLogSink(LogSink sink) {
+        g_logSink = sink;
+    }
+
+    void Log(const char* format, ...) {
+        char message[1024];
+        va_list args;
+        va_start(args, format);
+        vsnprintf(message, sizeof(message), format, args);
+        va_end(args);
+
+        const LogSink sink = g_logSink;
+        if (sink) {
+            sink(message);
+        } else {
+            fprintf(stderr, "%s\n", message);
+        }
+    }
+
+    FILE* OpenFile(const char* path, const char* mode) {
+#ifdef _WIN32
+        FILE* file = nullptr;
+        return fopen_s(&file, path, mode) ? nullptr : file;
+#else
+        return fopen(path, mode);
+#endif
+    }
+
+    void SetThreadName(const char* name) {
+#ifdef _WIN32
+        const std::wstring wideName(name, name + strlen(name));
+        SetThreadDescription(GetCurrentThread(), wideName.c_str());
+#elif defined(__APPLE__)
+        pthread_setname_np(name);
+#else
+        // Linux truncates the names to 15 characters.
+        char shortName[16];
+        snprintf(shortName, sizeof(shortName), "%s", name);
+        pthread_setname_np(pthread_self(), shortName);
+#endif
+    }
+
+    uint32_t GetSystemThreadId() {
+#ifdef _WIN32
+        return GetCurrentThreadId();
+#elif defined(__linux__)
+        return (uint32_t)syscall(SYS_gettid);
+#elif defined(__APPLE__)
+        uint64_t id = 0;
+        pthread_threadid_np(nullptr, &id);
+        return (uint32_t)id;
+#else
+        return (uint32_t)std::hash<std::thread::id>()(std::this_thread::get_id());
+#endif
+    }
+
+    double GetThreadCpuTime() {
+#ifdef _WIN32
+        FILETIME creation, exit, kernel, user;
+        GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user);
+        const auto toSeconds = [](const FILETIME& time) {
+            return (((uint64_t)time.dwHighDateTime << 32) | time.dwLowDateTime) * 100e-9;
+        };
+        return toSeconds(kernel) + toSeconds(user);
+#else
+        timespec time{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+        return time.tv_sec + time.tv_nsec * 1e-9;
+#endif
+    }
+
+    MappedFile::~MappedFile() {
+        Close();
+    }
+
+    bool MappedFile::Open(const char* path, bool sequential) {
+        Close();
+
+#ifdef _WIN32
+        const std::wstring widePath(path, path + strlen(path));
+        const DWORD flags = sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL;
+        const HANDLE file =
+            CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER size{};
+        const HANDLE mapping = GetFileSizeEx(file, &size) && size.QuadPart > 0 && (uint64_t)size.QuadPart <= SIZE_MAX
+                                   ? CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr)
+                                   : nullptr;
+        CloseHandle(file);
+        if (!mapping) {
+            return false;
+        }
+        const void* const data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (!data) {
+            return false;
+        }
+        m_size = (size_t)size.QuadPart;
+#else
+        const int file = open(path, O_RDONLY);
+        if (file < 0) {
+            return false;
+        }
+        struct stat status {};
+        void* data = MAP_FAILED;
+        if (!fstat(file, &status) && status.st_size > 0) {
+            data = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        }
+        close(file);
+        if (data == MAP_FAILED) {
+            return false;
+        }
+        if (sequential) {
+            madvise(data, (size_t)status.st_size, MADV_SEQUENTIAL);
+        }
+        m_size = (size_t)status.st_size;
+#endif
+        m_data = static_cast<const uint8_t*>(data);
+
+        return true;
+    }
+
+    void MappedFile::Close() {
+        if (m_data) {
+#ifdef _WIN32
+            UnmapViewOfFile(m_data);
+#else
+            munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+            m_data = nullptr;
+            m_size = 0;
+        }
+    }
+
+    SharedMemory::~SharedMemory() {
+        Close();
+    }
+
+    bool SharedMemory::Create(const char* name, size_t size) {
+        return Map(name, size, true);
+    }
+
+    bool SharedMemory::Open(const char* name) {
+        return Map(name, 0, false);
+    }
+
+    bool SharedMemory::Map(const char* name, size_t size, bool create) {
+        Close();
+
+#ifdef _WIN32
+        const std::wstring wideName(name, name + strlen(name));
+        const HANDLE mapping = create ? CreateFileMappingW(INVALID_HANDLE_VALUE,
+                                                           nullptr,
+                                                           PAGE_READWRITE,
+                                                           (DWORD)((uint64_t)size >> 32),
+                                                           (DWORD)size,
+                                                           wideName.c_str())
+                                      : OpenFileMappingW(FILE_MAP_READ | FILE_MAP_WRITE, FALSE, wideName.c_str());
+        if (!mapping) {
+            return false;
+        }
+        void* const data = MapViewOfFile(mapping, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, 0);
+        MEMORY_BASIC_INFORMATION info{};
+        if (!data || !VirtualQuery(data, &info, sizeof(info)) || info.RegionSize < size) {
+            if (data) {
+                UnmapViewOfFile(data);
+            }
+            CloseHandle(mapping);
+            return false;
+        }
+        m_mapping = mapping;
+        m_size = info.RegionSize;
+#else
+        const int file = shm_open(name, create ? O_RDWR | O_CREAT : O_RDWR, 0666);
+        if (file < 0) {
+            return false;
+        }
+        struct stat status {};
+        if (fstat(file, &status) || (create && (size_t)status.st_size < size && ftruncate(file, (off_t)size))) {
+            close(file);
+            return false;
+        }
+        const size_t mappedSize = create ? std::max((size_t)status.st_size, size) : (size_t)status.st_size;
+        void* data = MAP_FAILED;
+        if (mappedSize > 0) {
+            data = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+        }
+        close(file);
+        if (data == MAP_FAILED) {
+            return false;
+        }
+        snprintf(m_name, sizeof(m_name), "%s", name);
+        m_size = mappedSize;
+#endif
+        m_data = static_cast<uint8_t*>(data);
+        m_isCreator = create;
+
+        return true;
+    }
+
+    void SharedMemory::Close() {
+        if (!m_data) {
+            return;
+        }
+
+#ifdef _WIN32
+        UnmapViewOfFile(m_data);
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+#else
+        munmap(m_data, m_size);
+        if (m_isCreator) {
+            shm_unlink(m_name);
+        }
+#endif
+        m_data = nullptr;
+        m_size = 0;
+        m_isCreator = false;
+    }
+
+} // namespace eyetracking_core
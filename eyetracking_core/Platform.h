@@ -0,0 +1,119 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace eyetracking_core {
+
+    // The few services of the operating system and of the host application that the library needs.
+
+    // Messages from the library are formatted and passed to the sink set by the host (the driver forwards them to the
+    // SteamVR log). Without a sink, they are written to stderr.
+    using LogSink = void (*)(const char* message);
+    void SetLogSink(LogSink sink);
+    void Log(const char* format, ...);
+
+    // fopen(), without the deprecation warnings of the Microsoft CRT. Returns nullptr on failure.
+    FILE* OpenFile(const char* path, const char* mode);
+
+    // Name the calling thread, for debuggers and profilers.
+    void SetThreadName(const char* name);
+
+    // The identifier of the calling thread in the operating system, as shown by debuggers and profilers.
+    uint32_t GetSystemThreadId();
+
+    // The processor time (user and kernel) consumed by the calling thread so far, in seconds.
+    double GetThreadCpuTime();
+
+    // A read-only view of an entire file, paged in on demand by the operating system.
+    class MappedFile {
+      public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // sequential hints the operating system to read ahead aggressively.
+        bool Open(const char* path, bool sequential = false);
+        void Close();
+
+        const uint8_t* GetData() const {
+            return m_data;
+        }
+
+        size_t GetSize() const {
+            return m_size;
+        }
+
+      private:
+        const uint8_t* m_data = nullptr;
+        size_t m_size = 0;
+    };
+
+    // A named region of memory shared between processes: a file mapping backed by the paging file on Windows, a POSIX
+    // shared memory object on Linux.
+    class SharedMemory {
+      public:
+        SharedMemory() = default;
+        ~SharedMemory();
+
+        SharedMemory(const SharedMemory&) = delete;
+        SharedMemory& operator=(const SharedMemory&) = delete;
+
+        // Create the region (or open it if it already exists) with at least size bytes, zero-filled when created.
+        bool Create(const char* name, size_t size);
+
+        // Open a region created by another process.
+        bool Open(const char* name);
+
+        // The region is destroyed once every process closed it (on Linux, the name is removed when its creator closes
+        // it).
+        void Close();
+
+        uint8_t* GetData() const {
+            return m_data;
+        }
+
+        size_t GetSize() const {
+            return m_size;
+        }
+
+      private:
+        bool Map(const char* name, size_t size, bool create);
+
+        uint8_t* m_data = nullptr;
+        size_t m_size = 0;
+        bool m_isCreator = false;
+#ifdef _WIN32
+        void* m_mapping = nullptr;
+#else
+        char m_name[256]{};
+#endif
+    };
+
+} // namespace eyetracking_core
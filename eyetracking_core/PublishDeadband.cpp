@@ -0,0 +1,62 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cmath>
+
+#include "PublishDeadband.h"
+
+namespace eyetracking_core {
+
+    void PublishDeadband::Configure(float thresholdDegrees, double keepAliveSeconds) {
+        m_isEnabled = thresholdDegrees > 0.f;
+        m_cosThreshold = cosf(thresholdDegrees * 3.14159265f / 180.f);
+        m_keepAliveSeconds = keepAliveSeconds;
+        m_hasPublished = false;
+    }
+
+    bool PublishDeadband::ShouldPublish(const float direction[3], bool isValid, double now) {
+        bool publish = !m_isEnabled || !m_hasPublished || isValid != m_lastValid ||
+                       now - m_lastTime >= m_keepAliveSeconds;
+        if (!publish) {
+            // Compare against the last published direction rather than the previous sample, so that slow drifts are
+            // eventually published.
+            const float cosAngle = direction[0] * m_lastDirection[0] + direction[1] * m_lastDirection[1] +
+                                   direction[2] * m_lastDirection[2];
+            publish = cosAngle < m_cosThreshold;
+        }
+
+        if (publish) {
+            m_hasPublished = true;
+            m_lastDirection[0] = direction[0];
+            m_lastDirection[1] = direction[1];
+            m_lastDirection[2] = direction[2];
+            m_lastValid = isValid;
+            m_lastTime = now;
+            m_publishedCount++;
+        } else {
+            m_suppressedCount++;
+        }
+
+        return publish;
+    }
+
+} // namespace eyetracking_core
@@ -0,0 +1,71 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+
+namespace eyetracking_core {
+
+    // Decides whether a gaze update is worth publishing to SteamVR. Updates are skipped while the gaze direction stays
+    // within a small cone around the last published direction, unless the validity changed or no update was published
+    // for longer than the keep-alive period.
+    class PublishDeadband {
+      public:
+        // A threshold of 0 disables the deadband, and every update is published.
+        void Configure(float thresholdDegrees, double keepAliveSeconds);
+
+        // direction must be a unit vector. Updates the statistics and the last published state.
+        bool ShouldPublish(const float direction[3], bool isValid, double now);
+
+        void ResetStatistics() {
+            m_publishedCount = m_suppressedCount = 0;
+        }
+
+        uint64_t GetPublishedCount() const {
+            return m_publishedCount;
+        }
+
+        uint64_t GetSuppressedCount() const {
+            return m_suppressedCount;
+        }
+
+        float GetSuppressedFraction() const {
+            const uint64_t total = m_publishedCount + m_suppressedCount;
+            return total ? (float)m_suppressedCount / total : 0.f;
+        }
+
+      private:
+        bool m_isEnabled = false;
+        float m_cosThreshold = 1.f;
+        double m_keepAliveSeconds = 0.0;
+
+        bool m_hasPublished = false;
+        float m_lastDirection[3]{};
+        bool m_lastValid = false;
+        double m_lastTime = 0.0;
+
+        uint64_t m_publishedCount = 0;
+        uint64_t m_suppressedCount = 0;
+    };
+
+} // namespace eyetracking_core
@@ -0,0 +1,152 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Clock.h"
+#include "EyeTrackerSource.h"
+#include "GazeRecording.h"
+#include "Platform.h"
+#include "Tracing.h"
+
+namespace {
+    using namespace eyetracking_core;
+
+    // Plays back a recording, pushing samples with the same timing as when they were recorded. The playback starts
+    // over with the callbacks, so that no sample is played before the device is activated.
+    struct ReplayEyeTrackerSource : public PushEyeTrackerSource {
+        ReplayEyeTrackerSource(std::vector<GazeRecordingRecord> records, bool loop)
+            : m_records(std::move(records)), m_loop(loop) {
+        }
+
+        ~ReplayEyeTrackerSource() override {
+            StopThread();
+        }
+
+        const char* GetName() const override {
+            return "replay";
+        }
+
+        bool StartCallbacks(SampleCallback callback) override {
+            StopThread();
+            PushEyeTrackerSource::StartCallbacks(std::move(callback));
+            m_stop = false;
+            m_thread = std::thread(&ReplayEyeTrackerSource::ReplayThread, this);
+            return true;
+        }
+
+        void StopCallbacks() override {
+            StopThread();
+            PushEyeTrackerSource::StopCallbacks();
+        }
+
+        void StopThread() {
+            if (!m_thread.joinable()) {
+                return;
+            }
+
+            {
+                std::unique_lock lock(m_stopMutex);
+                m_stop = true;
+            }
+            m_stopCondition.notify_all();
+            m_thread.join();
+        }
+
+        void ReplayThread() {
+            TraceLocalActivity(local);
+            TraceLoggingWriteStart(local, "ReplayEyeTrackerSource_ReplayThread", TLArg(m_records.size(), "Records"));
+
+            SetThreadName("ReplayEyeTrackerSource_ReplayThread");
+
+            // Each loop starts one mean record interval after the last record of the previous one, so that the
+            // timestamps keep increasing across the seam.
+            const double firstTime = m_records.front().timeInSeconds;
+            const double duration = m_records.back().timeInSeconds - firstTime;
+            const double loopDuration = duration + duration / std::max(m_records.size() - 1, size_t(1));
+
+            uint32_t loops = 0;
+            const double startTime = GetClock().Now();
+            std::unique_lock lock(m_stopMutex);
+            do {
+                for (const GazeRecordingRecord& record : m_records) {
+                    const double deliveryTime =
+                        startTime + loops * loopDuration + record.timeInSeconds - firstTime;
+                    if (GetClock().WaitUntil(lock, m_stopCondition, deliveryTime, [&] { return m_stop; })) {
+                        break;
+                    }
+
+                    EyeTrackerSample sample;
+                    sample.timeInSeconds = record.timeInSeconds + loops * loopDuration;
+                    for (int eye = 0; eye < 2; eye++) {
+                        sample.gazeTan[eye].x = record.gazeTan[eye][0];
+                        sample.gazeTan[eye].y = record.gazeTan[eye][1];
+                    }
+                    sample.isValid = record.flags & GazeRecordingFlags_Valid;
+
+                    lock.unlock();
+                    Deliver(sample);
+                    lock.lock();
+                }
+                loops++;
+            } while (m_loop && !m_stop);
+            GetClock().OnThreadExit();
+
+            TraceLoggingWriteStop(local, "ReplayEyeTrackerSource_ReplayThread", TLArg(loops, "Loops"));
+        }
+
+        const std::vector<GazeRecordingRecord> m_records;
+        const bool m_loop;
+
+        std::mutex m_stopMutex;
+        std::condition_variable m_stopCondition;
+        bool m_stop = false;
+        std::thread m_thread;
+    };
+
+} // namespace
+
+namespace eyetracking_core {
+
+    std::shared_ptr<EyeTrackerSource> CreateReplayEyeTrackerSource(const std::string& path, bool loop) {
+        std::vector<GazeRecordingRecord> records;
+        if (!LoadGazeRecording(path, records) || records.empty()) {
+            Log("Failed to load recording: %s", path.c_str());
+            return nullptr;
+        }
+        if (loop && records.back().timeInSeconds <= records.front().timeInSeconds) {
+            // There would be no time between two loops.
+            Log("Recording is too short to loop: %s", path.c_str());
+            loop = false;
+        }
+
+        return std::make_shared<ReplayEyeTrackerSource>(std::move(records), loop);
+    }
+
+} // namespace eyetracking_core
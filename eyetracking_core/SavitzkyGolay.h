@@ -0,0 +1,272 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace eyetracking_core {
+
+    namespace savitzky_golay {
+
+        template <size_t N>
+        using Matrix = std::array<std::array<double, N>, N>;
+
+        // Pivots below this are treated as zero: the matrix is singular (or too close to it to be inverted).
+        constexpr double k_PivotEpsilon = 1e-9;
+
+        // Invert a small symmetric positive-definite matrix with Gauss-Jordan elimination. Usable at compile time.
+        // Returns false if the matrix is singular.
+        template <size_t N>
+        constexpr bool Invert(Matrix<N> m, Matrix<N>& inverse) {
+            inverse = {};
+            for (size_t i = 0; i < N; i++) {
+                inverse[i][i] = 1.0;
+            }
+            for (size_t column = 0; column < N; column++) {
+                // Partial pivoting.
+                size_t pivot = column;
+                for (size_t row = column + 1; row < N; row++) {
+                    const double candidate = m[row][column] < 0 ? -m[row][column] : m[row][column];
+                    const double current = m[pivot][column] < 0 ? -m[pivot][column] : m[pivot][column];
+                    if (candidate > current) {
+                        pivot = row;
+                    }
+                }
+                for (size_t k = 0; k < N; k++) {
+                    const double a = m[column][k];
+                    m[column][k] = m[pivot][k];
+                    m[pivot][k] = a;
+                    const double b = inverse[column][k];
+                    inverse[column][k] = inverse[pivot][k];
+                    inverse[pivot][k] = b;
+                }
+
+                const double scale = m[column][column];
+                if ((scale < 0 ? -scale : scale) < k_PivotEpsilon) {
+                    return false;
+                }
+                for (size_t k = 0; k < N; k++) {
+                    m[column][k] /= scale;
+                    inverse[column][k] /= scale;
+                }
+                for (size_t row = 0; row < N; row++) {
+                    if (row != column) {
+                        const double factor = m[row][column];
+                        for (size_t k = 0; k < N; k++) {
+                            m[row][k] -= factor * m[column][k];
+                            inverse[row][k] -= factor * inverse[column][k];
+                        }
+                    }
+                }
+            }
+            return true;
+        }
+
+        template <size_t Window, size_t Order>
+        using Weights = std::array<std::array<double, Window>, Order + 1>;
+
+        // Least-squares weights of a polynomial fit of the given order over the sample positions x, such that the
+        // polynomial's coefficient j is sum(weights[j][i] * value[i]). Returns false if the positions do not determine
+        // the polynomial (fewer than Order + 1 distinct positions).
+        template <size_t Window, size_t Order>
+        constexpr bool FitWeights(const std::array<double, Window>& x, Weights<Window, Order>& weights) {
+            // Normal equations: (A^T A) a = A^T v, with A[i][j] = x[i]^j.
+            Matrix<Order + 1> normal{};
+            for (size_t i = 0; i < Window; i++) {
+                double powers[2 * Order + 1]{};
+                powers[0] = 1.0;
+                for (size_t p = 1; p <= 2 * Order; p++) {
+                    powers[p] = powers[p - 1] * x[i];
+                }
+                for (size_t j = 0; j <= Order; j++) {
+                    for (size_t k = 0; k <= Order; k++) {
+                        normal[j][k] += powers[j + k];
+                    }
+                }
+            }
+            Matrix<Order + 1> inverse{};
+            if (!Invert<Order + 1>(normal, inverse)) {
+                return false;
+            }
+
+            weights = {};
+            for (size_t i = 0; i < Window; i++) {
+                double power = 1.0;
+                for (size_t k = 0; k <= Order; k++) {
+                    for (size_t j = 0; j <= Order; j++) {
+                        weights[j][i] += inverse[j][k] * power;
+                    }
+                    power *= x[i];
+                }
+            }
+            return true;
+        }
+
+        // Causal Savitzky-Golay coefficients for unit sample spacing: the samples are at positions -(Window - 1)..0
+        // and the derivatives are evaluated at the latest sample. Coefficient d is the d-th derivative (times d!).
+        template <size_t Window, size_t Order>
+        constexpr Weights<Window, Order> ComputeCausalCoefficients() {
+            std::array<double, Window> x{};
+            for (size_t i = 0; i < Window; i++) {
+                x[i] = (double)i - (double)(Window - 1);
+            }
+            Weights<Window, Order> coefficients{};
+            FitWeights<Window, Order>(x, coefficients);
+            double factorial = 1.0;
+            for (size_t d = 1; d <= Order; d++) {
+                factorial *= (double)d;
+                for (size_t i = 0; i < Window; i++) {
+                    coefficients[d][i] *= factorial;
+                }
+            }
+            return coefficients;
+        }
+
+    } // namespace savitzky_golay
+
+    // Causal Savitzky-Golay differentiator over Channels values sharing the same timestamps. It estimates the value,
+    // first and second derivative (when Order >= 2) at the latest sample.
+    //
+    // With regular sample intervals, the derivatives are dot products with coefficients computed at compile time. When
+    // the intervals vary by more than k_IrregularTolerance, the fit is solved at runtime from the actual timestamps,
+    // once for all the derivatives. Samples whose timestamp is not after the latest one are ignored, and if the runtime
+    // fit is still singular, the last good estimate is returned.
+    template <size_t Window, size_t Order, size_t Channels>
+    class SavitzkyGolayDifferentiator {
+        static_assert(Order >= 1 && Window > Order, "Window must hold more samples than the polynomial order");
+
+      public:
+        static constexpr double k_IrregularTolerance = 0.2;
+        static constexpr auto k_Coefficients = savitzky_golay::ComputeCausalCoefficients<Window, Order>();
+
+        // Returns false if the sample was ignored because its timestamp is not after the latest one.
+        bool Push(double time, const float (&values)[Channels]) {
+            if (m_size && !(time > m_times[m_head])) {
+                return false;
+            }
+            m_head = (m_head + 1) % Window;
+            m_times[m_head] = time;
+            for (size_t c = 0; c < Channels; c++) {
+                m_values[c][m_head] = values[c];
+            }
+            if (m_size < Window) {
+                m_size++;
+            }
+            return true;
+        }
+
+        void Reset() {
+            m_size = 0;
+            m_hasLastDerivatives = false;
+        }
+
+        bool IsReady() const {
+            return m_size == Window;
+        }
+
+        // Compute the derivatives of order 1 to Order for each channel, in units per second^order (derivatives[0] is
+        // left untouched). Returns false if not enough samples were pushed.
+        bool GetDerivatives(float (&derivatives)[Order + 1][Channels]) {
+            if (!IsReady()) {
+                return false;
+            }
+
+            // Samples in chronological order, the latest last. Push() keeps the timestamps increasing.
+            const size_t oldest = (m_head + 1) % Window;
+            const double meanInterval = (m_times[m_head] - m_times[oldest]) / (Window - 1);
+
+            bool isRegular = true;
+            for (size_t i = 1; i < Window && isRegular; i++) {
+                const double interval = m_times[(oldest + i) % Window] - m_times[(oldest + i - 1) % Window];
+                isRegular = std::abs(interval - meanInterval) <= k_IrregularTolerance * meanInterval;
+            }
+
+            const savitzky_golay::Weights<Window, Order>* weights = &k_Coefficients;
+            savitzky_golay::Weights<Window, Order> fitWeights{};
+            if (!isRegular) {
+                // Fit against the actual positions, in units of the mean interval to keep the system well-conditioned.
+                std::array<double, Window> x{};
+                for (size_t i = 0; i < Window; i++) {
+                    x[i] = (m_times[(oldest + i) % Window] - m_times[m_head]) / meanInterval;
+                }
+                m_irregularCount++;
+                if (!savitzky_golay::FitWeights<Window, Order>(x, fitWeights)) {
+                    m_singularCount++;
+                    if (!m_hasLastDerivatives) {
+                        return false;
+                    }
+                    std::copy(&m_lastDerivatives[1][0], &m_lastDerivatives[Order][0] + Channels, &derivatives[1][0]);
+                    return true;
+                }
+                double factorial = 1.0;
+                for (size_t d = 1; d <= Order; d++) {
+                    factorial *= (double)d;
+                    for (size_t i = 0; i < Window; i++) {
+                        fitWeights[d][i] *= factorial;
+                    }
+                }
+                weights = &fitWeights;
+            }
+
+            double scale = 1.0;
+            for (size_t d = 1; d <= Order; d++) {
+                scale /= meanInterval;
+                for (size_t c = 0; c < Channels; c++) {
+                    double sum = 0.0;
+                    for (size_t i = 0; i < Window; i++) {
+                        sum += (*weights)[d][i] * m_values[c][(oldest + i) % Window];
+                    }
+                    derivatives[d][c] = (float)(sum * scale);
+                }
+            }
+
+            std::copy(&derivatives[1][0], &derivatives[Order][0] + Channels, &m_lastDerivatives[1][0]);
+            m_hasLastDerivatives = true;
+            return true;
+        }
+
+        // Number of times the runtime fit was needed, and of times it was singular.
+        uint64_t GetIrregularCount() const {
+            return m_irregularCount;
+        }
+
+        uint64_t GetSingularCount() const {
+            return m_singularCount;
+        }
+
+      private:
+        double m_times[Window]{};
+        float m_values[Channels][Window]{};
+        size_t m_head = Window - 1;
+        size_t m_size = 0;
+        float m_lastDerivatives[Order + 1][Channels]{};
+        bool m_hasLastDerivatives = false;
+        uint64_t m_irregularCount = 0;
+        uint64_t m_singularCount = 0;
+    };
+
+} // namespace eyetracking_core
@@ -0,0 +1,347 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "SceneBvh.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    constexpr uint32_t k_BinCount = 12;
+    constexpr uint32_t k_MaxDepth = 64;
+
+    struct Bounds {
+        float min[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+        float max[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+        void Grow(const Bounds& other) {
+            for (int axis = 0; axis < 3; axis++) {
+                min[axis] = std::min(min[axis], other.min[axis]);
+                max[axis] = std::max(max[axis], other.max[axis]);
+            }
+        }
+
+        void Grow(const float point[3]) {
+            for (int axis = 0; axis < 3; axis++) {
+                min[axis] = std::min(min[axis], point[axis]);
+                max[axis] = std::max(max[axis], point[axis]);
+            }
+        }
+
+        float GetHalfArea() const {
+            const float x = max[0] - min[0], y = max[1] - min[1], z = max[2] - min[2];
+            return (x < 0.f) ? 0.f : x * y + y * z + z * x;
+        }
+    };
+
+    Bounds GetBounds(const GazeScenePrimitive& primitive) {
+        Bounds bounds;
+        bounds.Grow(&primitive.data[0]);
+        bounds.Grow(&primitive.data[3]);
+        if (primitive.type == GazeScenePrimitive_Triangle) {
+            bounds.Grow(&primitive.data[6]);
+        }
+        return bounds;
+    }
+
+    // Distance to the entry of the ray in the box, or FLT_MAX if it misses or the box is behind.
+    float IntersectBox(
+        const float min[3], const float max[3], const float origin[3], const float inverseDirection[3], float maxT) {
+        float tNear = 0.f, tFar = maxT;
+        for (int axis = 0; axis < 3; axis++) {
+            float t0 = (min[axis] - origin[axis]) * inverseDirection[axis];
+            float t1 = (max[axis] - origin[axis]) * inverseDirection[axis];
+            if (t0 > t1) {
+                std::swap(t0, t1);
+            }
+            // Written so that NaNs (origin on a slab of a flat box) do not reject the box.
+            tNear = t0 > tNear ? t0 : tNear;
+            tFar = t1 < tFar ? t1 : tFar;
+        }
+        return tNear <= tFar ? tNear : FLT_MAX;
+    }
+
+    // Moller-Trumbore, two-sided. Returns FLT_MAX on a miss.
+    float IntersectTriangle(const float* v, const float origin[3], const float direction[3]) {
+        const float e1[3] = {v[3] - v[0], v[4] - v[1], v[5] - v[2]};
+        const float e2[3] = {v[6] - v[0], v[7] - v[1], v[8] - v[2]};
+        const float p[3] = {direction[1] * e2[2] - direction[2] * e2[1],
+                            direction[2] * e2[0] - direction[0] * e2[2],
+                            direction[0] * e2[1] - direction[1] * e2[0]};
+        const float determinant = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+        if (std::abs(determinant) < 1e-12f) {
+            return FLT_MAX;
+        }
+        const float inverseDeterminant = 1.f / determinant;
+        const float s[3] = {origin[0] - v[0], origin[1] - v[1], origin[2] - v[2]};
+        const float u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * inverseDeterminant;
+        if (u < 0.f || u > 1.f) {
+            return FLT_MAX;
+        }
+        const float q[3] = {s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0]};
+        const float w = (direction[0] * q[0] + direction[1] * q[1] + direction[2] * q[2]) * inverseDeterminant;
+        if (w < 0.f || u + w > 1.f) {
+            return FLT_MAX;
+        }
+        const float t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * inverseDeterminant;
+        return t >= 0.f ? t : FLT_MAX;
+    }
+
+} // namespace
+
+namespace eyetracking_core {
+
+    SceneBvh::SceneBvh(const std::vector<GazeScenePrimitive>& primitives) : m_primitives(primitives) {
+        Build();
+    }
+
+    bool SceneBvh::HasSameTopology(const std::vector<GazeScenePrimitive>& primitives) const {
+        if (primitives.size() != m_primitives.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < m_primitives.size(); i++) {
+            const GazeScenePrimitive& primitive = primitives[m_order[i]];
+            if (primitive.id != m_primitives[i].id || primitive.type != m_primitives[i].type) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void SceneBvh::Refit(const std::vector<GazeScenePrimitive>& primitives) {
+        for (size_t i = 0; i < m_primitives.size(); i++) {
+            m_primitives[i] = primitives[m_order[i]];
+        }
+
+        // Children are always stored after their parent.
+        for (size_t index = m_nodes.size(); index > 0; index--) {
+            Node& node = m_nodes[index - 1];
+            if (node.count) {
+                UpdateLeafBounds(node);
+            } else {
+                const Node& left = m_nodes[node.first];
+                const Node& right = m_nodes[node.first + 1];
+                for (int axis = 0; axis < 3; axis++) {
+                    node.min[axis] = std::min(left.min[axis], right.min[axis]);
+                    node.max[axis] = std::max(left.max[axis], right.max[axis]);
+                }
+            }
+        }
+    }
+
+    SceneBvh::Hit SceneBvh::Intersect(const float origin[3], const float direction[3], float maxDistance) const {
+        Hit hit;
+        if (m_nodes.empty()) {
+            return hit;
+        }
+
+        const float inverseDirection[3] = {1.f / direction[0], 1.f / direction[1], 1.f / direction[2]};
+        float closest = maxDistance;
+
+        struct Entry {
+            uint32_t node;
+            float distance;
+        };
+        Entry stack[k_MaxDepth];
+        uint32_t stackSize = 0;
+
+        const float rootDistance = IntersectBox(m_nodes[0].min, m_nodes[0].max, origin, inverseDirection, closest);
+        if (rootDistance != FLT_MAX) {
+            stack[stackSize++] = {0, rootDistance};
+        }
+
+        while (stackSize) {
+            const Entry entry = stack[--stackSize];
+            if (entry.distance >= closest) {
+                continue;
+            }
+
+            const Node& node = m_nodes[entry.node];
+            if (node.count) {
+                for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                    const GazeScenePrimitive& primitive = m_primitives[i];
+                    const float distance =
+                        primitive.type == GazeScenePrimitive_Triangle
+                            ? IntersectTriangle(primitive.data, origin, direction)
+                            : IntersectBox(&primitive.data[0], &primitive.data[3], origin, inverseDirection, closest);
+                    if (distance < closest) {
+                        closest = distance;
+                        hit.objectId = primitive.id;
+                        hit.distance = distance;
+                    }
+                }
+                continue;
+            }
+
+            // Visit the nearest child first, so that the farther one can often be skipped.
+            Entry children[2] = {
+                {node.first,
+                 IntersectBox(m_nodes[node.first].min, m_nodes[node.first].max, origin, inverseDirection, closest)},
+                {node.first + 1,
+                 IntersectBox(
+                     m_nodes[node.first + 1].min, m_nodes[node.first + 1].max, origin, inverseDirection, closest)}};
+            if (children[0].distance < children[1].distance) {
+                std::swap(children[0], children[1]);
+            }
+            for (const Entry& child : children) {
+                if (child.distance < closest && stackSize < k_MaxDepth) {
+                    stack[stackSize++] = child;
+                }
+            }
+        }
+
+        return hit;
+    }
+
+    void SceneBvh::Build() {
+        const uint32_t count = (uint32_t)m_primitives.size();
+        m_nodes.clear();
+        m_order.resize(count);
+        if (!count) {
+            return;
+        }
+
+        std::vector<Bounds> bounds(count);
+        std::vector<float> centroids(3 * (size_t)count);
+        for (uint32_t i = 0; i < count; i++) {
+            m_order[i] = i;
+            bounds[i] = GetBounds(m_primitives[i]);
+            for (int axis = 0; axis < 3; axis++) {
+                centroids[3 * i + axis] = (bounds[i].min[axis] + bounds[i].max[axis]) / 2.f;
+            }
+        }
+
+        m_nodes.reserve(2 * (size_t)count);
+        m_nodes.push_back({{}, 0, {}, count});
+
+        uint32_t stack[k_MaxDepth];
+        uint32_t stackSize = 0;
+        stack[stackSize++] = 0;
+        while (stackSize) {
+            const uint32_t nodeIndex = stack[--stackSize];
+            const uint32_t first = m_nodes[nodeIndex].first;
+            const uint32_t nodeCount = m_nodes[nodeIndex].count;
+
+            Bounds nodeBounds, centroidBounds;
+            for (uint32_t i = first; i < first + nodeCount; i++) {
+                nodeBounds.Grow(bounds[m_order[i]]);
+                centroidBounds.Grow(&centroids[3 * m_order[i]]);
+            }
+            std::copy_n(nodeBounds.min, 3, m_nodes[nodeIndex].min);
+            std::copy_n(nodeBounds.max, 3, m_nodes[nodeIndex].max);
+            if (nodeCount <= 2 || stackSize + 2 > k_MaxDepth) {
+                continue;
+            }
+
+            // Binned SAH: bin the centroids along each axis, and evaluate the cost of splitting between each bin.
+            float bestCost = FLT_MAX;
+            int bestAxis = -1;
+            uint32_t bestSplit = 0;
+            for (int axis = 0; axis < 3; axis++) {
+                const float extent = centroidBounds.max[axis] - centroidBounds.min[axis];
+                if (extent <= 0.f) {
+                    continue;
+                }
+                const float scale = k_BinCount / extent;
+
+                Bounds binBounds[k_BinCount];
+                uint32_t binCounts[k_BinCount]{};
+                for (uint32_t i = first; i < first + nodeCount; i++) {
+                    const uint32_t index = m_order[i];
+                    const uint32_t bin = std::min(
+                        (uint32_t)((centroids[3 * index + axis] - centroidBounds.min[axis]) * scale), k_BinCount - 1);
+                    binBounds[bin].Grow(bounds[index]);
+                    binCounts[bin]++;
+                }
+
+                float rightCosts[k_BinCount]{};
+                Bounds right;
+                uint32_t rightCount = 0;
+                for (uint32_t bin = k_BinCount - 1; bin > 0; bin--) {
+                    right.Grow(binBounds[bin]);
+                    rightCount += binCounts[bin];
+                    rightCosts[bin] = rightCount * right.GetHalfArea();
+                }
+                Bounds left;
+                uint32_t leftCount = 0;
+                for (uint32_t bin = 0; bin < k_BinCount - 1; bin++) {
+                    left.Grow(binBounds[bin]);
+                    leftCount += binCounts[bin];
+                    const float cost = leftCount * left.GetHalfArea() + rightCosts[bin + 1];
+                    if (cost < bestCost) {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestSplit = bin;
+                    }
+                }
+            }
+
+            if (bestAxis < 0 || (bestCost >= nodeCount * nodeBounds.GetHalfArea() && nodeCount <= k_MaxLeafSize)) {
+                continue;
+            }
+
+            const float minCentroid = centroidBounds.min[bestAxis];
+            const float scale = k_BinCount / (centroidBounds.max[bestAxis] - minCentroid);
+            uint32_t* const middle =
+                std::partition(&m_order[first], &m_order[first] + nodeCount, [&](uint32_t index) {
+                    const uint32_t bin =
+                        std::min((uint32_t)((centroids[3 * index + bestAxis] - minCentroid) * scale), k_BinCount - 1);
+                    return bin <= bestSplit;
+                });
+            const uint32_t leftCount = (uint32_t)(middle - &m_order[first]);
+            if (leftCount == 0 || leftCount == nodeCount) {
+                continue;
+            }
+
+            const uint32_t leftIndex = (uint32_t)m_nodes.size();
+            m_nodes.push_back({{}, first, {}, leftCount});
+            m_nodes.push_back({{}, first + leftCount, {}, nodeCount - leftCount});
+            m_nodes[nodeIndex].first = leftIndex;
+            m_nodes[nodeIndex].count = 0;
+            stack[stackSize++] = leftIndex;
+            stack[stackSize++] = leftIndex + 1;
+        }
+
+        // Store the primitives in leaf order, so that each leaf reads contiguous memory.
+        std::vector<GazeScenePrimitive> ordered(count);
+        for (uint32_t i = 0; i < count; i++) {
+            ordered[i] = m_primitives[m_order[i]];
+        }
+        m_primitives.swap(ordered);
+    }
+
+    void SceneBvh::UpdateLeafBounds(Node& node) const {
+        Bounds bounds;
+        for (uint32_t i = node.first; i < node.first + node.count; i++) {
+            bounds.Grow(GetBounds(m_primitives[i]));
+        }
+        std::copy_n(bounds.min, 3, node.min);
+        std::copy_n(bounds.max, 3, node.max);
+    }
+
+} // namespace eyetracking_core
@@ -0,0 +1,81 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "GazeSceneProxy.h"
+
+namespace eyetracking_core {
+
+    // Bounding volume hierarchy over the primitives of a scene proxy, to find the first primitive hit by a ray in
+    // logarithmic time. Built with a binned surface area heuristic; when only the positions of the primitives change,
+    // Refit() recomputes the bounds in a linear pass instead of rebuilding the tree.
+    class SceneBvh {
+      public:
+        struct Hit {
+            uint32_t objectId = k_GazeSceneNoHit;
+            float distance = 0.f;
+        };
+
+        static constexpr uint32_t k_MaxLeafSize = 4;
+
+        explicit SceneBvh(const std::vector<GazeScenePrimitive>& primitives);
+
+        // Whether Refit() can be used with these primitives, ie: same ids and types in the same order.
+        bool HasSameTopology(const std::vector<GazeScenePrimitive>& primitives) const;
+
+        // Update the bounds after the primitives moved. Requires HasSameTopology().
+        void Refit(const std::vector<GazeScenePrimitive>& primitives);
+
+        // Find the closest primitive along the ray (direction need not be normalized; distances are in its units).
+        Hit Intersect(const float origin[3], const float direction[3], float maxDistance) const;
+
+        size_t GetPrimitiveCount() const {
+            return m_primitives.size();
+        }
+
+        size_t GetNodeCount() const {
+            return m_nodes.size();
+        }
+
+      private:
+        // A leaf (count > 0) holds primitives [first, first + count), an inner node has children first and first + 1.
+        struct Node {
+            float min[3];
+            uint32_t first;
+            float max[3];
+            uint32_t count;
+        };
+        static_assert(sizeof(Node) == 32);
+
+        void Build();
+        void UpdateLeafBounds(Node& node) const;
+
+        std::vector<Node> m_nodes;
+        std::vector<GazeScenePrimitive> m_primitives; // In leaf order.
+        std::vector<uint32_t> m_order;                 // Index in the source of each primitive in m_primitives.
+    };
+
+} // namespace eyetracking_core
@@ -0,0 +1,265 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <utility>
+
+#include "Clock.h"
+#include "Platform.h"
+#include "ShadowPipeline.h"
+#include "Tracing.h"
+
+namespace {
+    using namespace eyetracking_core;
+
+    constexpr float k_RadiansToDegrees = 57.2957795f;
+
+    GazeRecordingRecord MakeRecord(const GazeSample& sample) {
+        GazeRecordingRecord record{};
+        record.timeInSeconds = sample.timeInSeconds;
+        for (int eye = 0; eye < 2; eye++) {
+            record.gazeTan[eye][0] = sample.gazeTan[eye].x;
+            record.gazeTan[eye][1] = sample.gazeTan[eye].y;
+        }
+        record.flags = sample.isValid ? (uint32_t)GazeRecordingFlags_Valid : 0;
+        return record;
+    }
+
+    uint64_t GetTotalNs(const GazePipeline& pipeline) {
+        uint64_t total = 0;
+        for (size_t i = 0; i < pipeline.GetStageCount(); i++) {
+            total += pipeline.GetStatistics(i).total.count();
+        }
+        return total;
+    }
+
+} // namespace
+
+namespace eyetracking_core {
+
+    ShadowPipeline::ShadowPipeline(GazePipeline candidate, Arena* arena)
+        : m_candidate(std::move(candidate)), m_queue(k_QueueCapacity, arena), m_candidateRecorder(arena),
+          m_productionRecorder(arena) {
+    }
+
+    ShadowPipeline::~ShadowPipeline() {
+        Stop();
+    }
+
+    bool ShadowPipeline::OpenRecording(const std::string& path) {
+        return m_candidateRecorder.Open(path) && m_productionRecorder.Open(path + ".production");
+    }
+
+    void ShadowPipeline::Start() {
+        Stop();
+
+        m_candidate.Reset();
+        {
+            std::unique_lock lock(m_statisticsMutex);
+            m_samples = m_comparedCount = 0;
+            m_divergenceSum = 0.0;
+            m_maxDivergence = 0.f;
+            std::fill(std::begin(m_divergenceHistogram), std::end(m_divergenceHistogram), 0);
+            m_validityMismatches = m_fixationMismatches = m_eventMismatches = 0;
+            m_candidateNs = 0;
+        }
+        m_dropped = 0;
+
+        m_stop = false;
+        m_thread = std::thread(&ShadowPipeline::ShadowThread, this);
+    }
+
+    void ShadowPipeline::Stop() {
+        if (!m_thread.joinable()) {
+            return;
+        }
+
+        {
+            std::unique_lock lock(m_stopMutex);
+            m_stop = true;
+        }
+        m_stopCondition.notify_all();
+        m_thread.join();
+    }
+
+    void ShadowPipeline::ShadowThread() {
+        TraceLocalActivity(local);
+        TraceLoggingWriteStart(local, "ShadowPipeline_ShadowThread");
+
+        SetThreadName("ShadowPipeline_ShadowThread");
+
+        std::unique_lock lock(m_stopMutex);
+        while (true) {
+            // Wake up periodically rather than per sample, so that the update thread never has to signal us.
+            const bool stop = GetClock().WaitFor(lock, m_stopCondition, k_DrainInterval, [&] { return m_stop; });
+
+            lock.unlock();
+            size_t count;
+            do {
+                count = 0;
+                Entry entry;
+                while (count < k_BatchSize && m_queue.TryPop(entry)) {
+                    m_candidateBatch[count] = entry.input;
+                    m_productionBatch[count] = entry.production;
+                    count++;
+                }
+                if (count) {
+                    ProcessBatch(count);
+                }
+            } while (count == k_BatchSize);
+            lock.lock();
+
+            if (stop) {
+                break;
+            }
+        }
+        GetClock().OnThreadExit();
+
+        TraceLoggingWriteStop(local, "ShadowPipeline_ShadowThread");
+    }
+
+    void ShadowPipeline::ProcessBatch(size_t count) {
+        const auto start = std::chrono::steady_clock::now();
+        m_candidate.ProcessBatch(m_candidateBatch, count);
+        const auto duration = std::chrono::steady_clock::now() - start;
+
+        std::unique_lock lock(m_statisticsMutex);
+        m_samples += count;
+        m_candidateNs += std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        for (size_t i = 0; i < count; i++) {
+            const GazeSample& candidate = m_candidateBatch[i];
+            const GazeSample& production = m_productionBatch[i];
+
+            if (candidate.isValid != production.isValid) {
+                m_validityMismatches++;
+            } else if (candidate.isValid) {
+                // Unlike acos() of the dot product, which reads up to 0.04 degrees for a direction against itself,
+                // atan2() of the cross and dot products is exact for identical directions and accurate for small
+                // angles.
+                const float* const a = candidate.direction;
+                const float* const b = production.direction;
+                const float cross[3] = {
+                    a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+                const float dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+                const float divergence =
+                    atan2f(std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]), dot) *
+                    k_RadiansToDegrees;
+                m_comparedCount++;
+                m_divergenceSum += divergence;
+                m_maxDivergence = std::max(m_maxDivergence, divergence);
+                m_divergenceHistogram[std::min((size_t)(divergence / k_DivergenceBinWidth), k_DivergenceBins)]++;
+            }
+            if (candidate.isFixation != production.isFixation) {
+                m_fixationMismatches++;
+            }
+            if (candidate.events != production.events) {
+                m_eventMismatches++;
+            }
+        }
+        lock.unlock();
+
+        if (m_candidateRecorder.IsOpen()) {
+            for (size_t i = 0; i < count; i++) {
+                m_candidateRecorder.Write(MakeRecord(m_candidateBatch[i]));
+                m_productionRecorder.Write(MakeRecord(m_productionBatch[i]));
+            }
+        }
+    }
+
+    ShadowPipeline::Statistics ShadowPipeline::GetStatistics() const {
+        Statistics statistics;
+        statistics.dropped = m_dropped.load(std::memory_order_relaxed);
+
+        std::unique_lock lock(m_statisticsMutex);
+        statistics.samples = m_samples;
+        statistics.comparedCount = m_comparedCount;
+        statistics.meanDivergence = m_comparedCount ? (float)(m_divergenceSum / m_comparedCount) : 0.f;
+        statistics.maxDivergence = m_maxDivergence;
+        statistics.validityMismatches = m_validityMismatches;
+        statistics.fixationMismatches = m_fixationMismatches;
+        statistics.eventMismatches = m_eventMismatches;
+        statistics.candidateNs = m_candidateNs;
+
+        // The upper edge of the bin where each percentile falls.
+        const struct {
+            float fraction;
+            float* value;
+        } percentiles[] = {{0.50f, &statistics.p50Divergence},
+                           {0.95f, &statistics.p95Divergence},
+                           {0.99f, &statistics.p99Divergence}};
+        uint64_t cumulated = 0;
+        size_t next = 0;
+        for (size_t bin = 0; bin <= k_DivergenceBins && next < std::size(percentiles); bin++) {
+            cumulated += m_divergenceHistogram[bin];
+            while (next < std::size(percentiles) && m_comparedCount &&
+                   cumulated >= percentiles[next].fraction * m_comparedCount) {
+                *percentiles[next].value = bin < k_DivergenceBins ? (bin + 1) * k_DivergenceBinWidth : m_maxDivergence;
+                next++;
+            }
+        }
+
+        return statistics;
+    }
+
+    void ShadowPipeline::Report(const GazePipeline& production) const {
+        const Statistics statistics = GetStatistics();
+        const uint64_t productionNs = GetTotalNs(production);
+        const uint64_t productionSamples = production.GetStageCount() ? production.GetStatistics(0).samples : 0;
+        const long long productionAverage = productionSamples ? (long long)(productionNs / productionSamples) : 0;
+        const long long candidateAverage =
+            statistics.samples ? (long long)(statistics.candidateNs / statistics.samples) : 0;
+
+        TraceLoggingWrite(TraceProvider,
+                          "ShadowPipeline_Statistics",
+                          TLArg(statistics.samples, "Samples"),
+                          TLArg(statistics.dropped, "Dropped"),
+                          TLArg(statistics.meanDivergence, "MeanDivergence"),
+                          TLArg(statistics.p95Divergence, "P95Divergence"),
+                          TLArg(statistics.maxDivergence, "MaxDivergence"),
+                          TLArg(statistics.validityMismatches, "ValidityMismatches"),
+                          TLArg(statistics.fixationMismatches, "FixationMismatches"),
+                          TLArg(statistics.eventMismatches, "EventMismatches"),
+                          TLArg(candidateAverage, "CandidateAverageNs"),
+                          TLArg(productionAverage, "ProductionAverageNs"));
+        Log("Shadow pipeline: %llu samples (%llu dropped), divergence %.3f mean, %.3f p50, %.3f p95, %.3f p99, "
+            "%.3f max degrees",
+            (unsigned long long)statistics.samples,
+            (unsigned long long)statistics.dropped,
+            statistics.meanDivergence,
+            statistics.p50Divergence,
+            statistics.p95Divergence,
+            statistics.p99Divergence,
+            statistics.maxDivergence);
+        Log("Shadow pipeline: %llu validity, %llu fixation and %llu event mismatches",
+            (unsigned long long)statistics.validityMismatches,
+            (unsigned long long)statistics.fixationMismatches,
+            (unsigned long long)statistics.eventMismatches);
+        Log("Shadow pipeline: %lld ns per sample, production %lld ns per sample", candidateAverage, productionAverage);
+
+        // Batches amortize the timing of the candidate, so its maximum is per batch rather than per sample.
+        Log("Shadow pipeline stages:");
+        m_candidate.ReportStatistics();
+    }
+
+} // namespace eyetracking_core
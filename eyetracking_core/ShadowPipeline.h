@@ -0,0 +1,143 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "Arena.h"
+#include "GazePipeline.h"
+#include "GazeRecording.h"
+#include "SpscQueue.h"
+
+namespace eyetracking_core {
+
+    // Runs a candidate pipeline on the same samples as the production pipeline, to compare their outputs and their
+    // cost on real sessions before switching over. Only the production outputs are used by the caller.
+    //
+    // The update thread hands each sample (before and after the production pipeline) over a lock-free queue, and never
+    // waits: when the shadow thread falls behind and the queue is full, samples are dropped (and counted). The shadow
+    // thread drains the queue in batches, runs them through the candidate, and accumulates the divergence.
+    class ShadowPipeline {
+      public:
+        // About 4 s at 250 Hz.
+        static constexpr size_t k_QueueCapacity = 1024;
+        static constexpr size_t k_BatchSize = 64;
+        static constexpr double k_DrainInterval = 0.01;
+
+        // Angular divergence histogram, for the percentiles. The last bin collects everything above.
+        static constexpr size_t k_DivergenceBins = 1000;
+        static constexpr float k_DivergenceBinWidth = 0.01f; // degrees
+
+        struct Statistics {
+            uint64_t samples = 0;
+            uint64_t dropped = 0;
+
+            // Divergence of the gaze direction (degrees), over the samples that are valid in both pipelines.
+            uint64_t comparedCount = 0;
+            float meanDivergence = 0.f;
+            float maxDivergence = 0.f;
+            float p50Divergence = 0.f;
+            float p95Divergence = 0.f;
+            float p99Divergence = 0.f;
+
+            uint64_t validityMismatches = 0;
+            uint64_t fixationMismatches = 0;
+            uint64_t eventMismatches = 0;
+
+            // Time spent in the candidate pipeline.
+            uint64_t candidateNs = 0;
+        };
+
+        // The queue is carved from the arena when one is given.
+        explicit ShadowPipeline(GazePipeline candidate, Arena* arena = nullptr);
+        ~ShadowPipeline();
+
+        ShadowPipeline(const ShadowPipeline&) = delete;
+        ShadowPipeline& operator=(const ShadowPipeline&) = delete;
+
+        // Record the outputs of the candidate to path, and those of the production pipeline next to it (with a
+        // ".production" suffix), so that they can be compared with recording_diff. Must be called while stopped.
+        bool OpenRecording(const std::string& path);
+
+        // Forget the previous samples and statistics, and start the shadow thread.
+        void Start();
+
+        // Process the samples still queued, then stop the shadow thread.
+        void Stop();
+
+        // Called by the producer (the update thread) only, with the sample as it entered the production pipeline and
+        // as it came out of it.
+        void Push(const GazeSample& input, const GazeSample& production) {
+            if (!m_queue.TryPush({input, production})) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        Statistics GetStatistics() const;
+
+        // Log the divergence, and the cost of each stage of the candidate next to the production one. Must be called
+        // while stopped.
+        void Report(const GazePipeline& production) const;
+
+      private:
+        struct Entry {
+            GazeSample input;
+            GazeSample production;
+        };
+
+        void ShadowThread();
+        void ProcessBatch(size_t count);
+
+        GazePipeline m_candidate;
+        SpscQueue<Entry> m_queue;
+        std::atomic<uint64_t> m_dropped = 0;
+
+        // Only touched by the shadow thread.
+        GazeSample m_candidateBatch[k_BatchSize];
+        GazeSample m_productionBatch[k_BatchSize];
+        GazeRecordingWriter m_candidateRecorder;
+        GazeRecordingWriter m_productionRecorder;
+
+        mutable std::mutex m_statisticsMutex;
+        uint64_t m_samples = 0;
+        uint64_t m_comparedCount = 0;
+        double m_divergenceSum = 0.0;
+        float m_maxDivergence = 0.f;
+        uint64_t m_divergenceHistogram[k_DivergenceBins + 1]{};
+        uint64_t m_validityMismatches = 0;
+        uint64_t m_fixationMismatches = 0;
+        uint64_t m_eventMismatches = 0;
+        uint64_t m_candidateNs = 0;
+
+        std::mutex m_stopMutex;
+        std::condition_variable m_stopCondition;
+        bool m_stop = false;
+        std::thread m_thread;
+    };
+
+} // namespace eyetracking_core
@@ -0,0 +1,96 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include "Arena.h"
+
+namespace eyetracking_core {
+
+    // A bounded lock-free queue between exactly one producer thread and one consumer thread. Neither side ever waits
+    // on the other: pushing to a full queue fails, and it is up to the producer to count the loss.
+    //
+    // The producer and the consumer each keep a copy of the other side's index, so that they only touch the other
+    // side's cache line when the queue looks full (or empty) from their copy.
+    template <typename T>
+    class SpscQueue {
+      public:
+        // The capacity is rounded up to a power of two.
+        explicit SpscQueue(size_t capacity, Arena* arena = nullptr)
+            : m_entries(RoundUp(capacity), arena), m_mask(m_entries.size() - 1) {
+        }
+
+        size_t GetCapacity() const {
+            return m_entries.size();
+        }
+
+        // Producer side.
+        bool TryPush(const T& value) {
+            const size_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_producerHead == m_entries.size()) {
+                m_producerHead = m_head.load(std::memory_order_acquire);
+                if (tail - m_producerHead == m_entries.size()) {
+                    return false;
+                }
+            }
+            m_entries[tail & m_mask] = value;
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer side.
+        bool TryPop(T& value) {
+            const size_t head = m_head.load(std::memory_order_relaxed);
+            if (head == m_consumerTail) {
+                m_consumerTail = m_tail.load(std::memory_order_acquire);
+                if (head == m_consumerTail) {
+                    return false;
+                }
+            }
+            value = m_entries[head & m_mask];
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+      private:
+        static size_t RoundUp(size_t capacity) {
+            size_t result = 1;
+            while (result < capacity) {
+                result <<= 1;
+            }
+            return result;
+        }
+
+        ArenaArray<T> m_entries;
+        const size_t m_mask;
+
+        alignas(Arena::k_SliceAlignment) std::atomic<size_t> m_head = 0;
+        size_t m_consumerTail = 0;
+
+        alignas(Arena::k_SliceAlignment) std::atomic<size_t> m_tail = 0;
+        size_t m_producerHead = 0;
+    };
+
+} // namespace eyetracking_core
@@ -0,0 +1,126 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <mutex>
+
+#include "Platform.h"
+#include "StartupTimeline.h"
+#include "Tracing.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    struct Entry {
+        const char* name;
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::duration duration; // Negative for an instantaneous event.
+        uint32_t threadId;
+    };
+
+    // Startup has only a few dozen steps, anything past this is dropped.
+    constexpr size_t k_MaxEntries = 64;
+
+    std::chrono::steady_clock::time_point g_origin = std::chrono::steady_clock::now();
+    std::mutex g_mutex;
+    Entry g_entries[k_MaxEntries];
+    size_t g_entryCount = 0;
+    bool g_isReported = false;
+
+    void Record(const char* name,
+                std::chrono::steady_clock::time_point start,
+                std::chrono::steady_clock::duration duration) {
+        std::unique_lock lock(g_mutex);
+        if (!g_isReported && g_entryCount < k_MaxEntries) {
+            g_entries[g_entryCount++] = {name, start, duration, GetSystemThreadId()};
+        }
+    }
+
+    double ToMilliseconds(std::chrono::steady_clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+} // namespace
+
+namespace eyetracking_core {
+
+    void InitializeStartupTimeline() {
+        g_origin = std::chrono::steady_clock::now();
+    }
+
+    void MarkStartupEvent(const char* name) {
+        Record(name, std::chrono::steady_clock::now(), std::chrono::steady_clock::duration(-1));
+    }
+
+    StartupStep::StartupStep(const char* name) : m_name(name), m_start(std::chrono::steady_clock::now()) {
+    }
+
+    StartupStep::~StartupStep() {
+        Record(m_name, m_start, std::chrono::steady_clock::now() - m_start);
+    }
+
+    void ReportStartupTimeline() {
+        std::unique_lock lock(g_mutex);
+        if (g_isReported) {
+            return;
+        }
+        g_isReported = true;
+
+        // Steps are recorded when they end, so nested steps come before their parent.
+        std::stable_sort(g_entries, g_entries + g_entryCount, [](const Entry& a, const Entry& b) {
+            return a.start < b.start;
+        });
+
+        Log("Startup timeline (ms since the host was loaded):");
+        for (size_t i = 0; i < g_entryCount; i++) {
+            const Entry& entry = g_entries[i];
+
+            // Indent the steps running within another step of the same thread.
+            int depth = 0;
+            for (size_t j = 0; j < i; j++) {
+                const Entry& parent = g_entries[j];
+                if (parent.threadId == entry.threadId && parent.duration.count() >= 0 &&
+                    entry.start + std::max(entry.duration, std::chrono::steady_clock::duration::zero()) <=
+                        parent.start + parent.duration) {
+                    depth++;
+                }
+            }
+
+            const double offset = ToMilliseconds(entry.start - g_origin);
+            const bool isEvent = entry.duration.count() < 0;
+            TraceLoggingWrite(TraceProvider,
+                              "StartupTimeline",
+                              TLArg(entry.name, "Step"),
+                              TLArg(offset, "OffsetMs"),
+                              TLArg(isEvent ? 0.0 : ToMilliseconds(entry.duration), "DurationMs"),
+                              TLArg(depth, "Depth"),
+                              TLArg(entry.threadId, "ThreadId"));
+            if (isEvent) {
+                Log("  %10.3f  %*s%s", offset, 2 * depth, "", entry.name);
+            } else {
+                Log("  %10.3f  %*s%s: %.3f ms", offset, 2 * depth, "", entry.name, ToMilliseconds(entry.duration));
+            }
+        }
+    }
+
+} // namespace eyetracking_core
@@ -0,0 +1,57 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace eyetracking_core {
+
+    // Records the steps between the host loading the library (eg: vrserver loading the driver) and the first gaze
+    // update, to be reported as one timeline. Recording stops once the timeline is reported. Step names must be string
+    // literals.
+
+    // Set the origin of the timeline, eg: when the DLL of the driver is loaded.
+    void InitializeStartupTimeline();
+
+    // Record an instantaneous event.
+    void MarkStartupEvent(const char* name);
+
+    // Record a step, from construction to destruction.
+    class StartupStep {
+      public:
+        explicit StartupStep(const char* name);
+        ~StartupStep();
+
+        StartupStep(const StartupStep&) = delete;
+        StartupStep& operator=(const StartupStep&) = delete;
+
+      private:
+        const char* const m_name;
+        const std::chrono::steady_clock::time_point m_start;
+    };
+
+    // Log and trace the timeline recorded so far. Only the first call has an effect.
+    void ReportStartupTimeline();
+
+} // namespace eyetracking_core
@@ -0,0 +1,155 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+
+#include "Clock.h"
+#include "EyeTrackerSource.h"
+#include "Platform.h"
+#include "Tracing.h"
+
+namespace {
+    using namespace eyetracking_core;
+
+    // Generates plausible eye movements: fixations of random duration, joined by short saccades, with a little noise
+    // and the occasional blink. The random sequence is seeded with a constant so that every run is identical.
+    struct SyntheticEyeTrackerSource : public PushEyeTrackerSource {
+        static constexpr auto k_Period = std::chrono::milliseconds(5);
+        static constexpr double k_SaccadeDuration = 0.04;
+        static constexpr double k_BlinkDuration = 0.15;
+
+        ~SyntheticEyeTrackerSource() override {
+            StopThread();
+        }
+
+        const char* GetName() const override {
+            return "synthetic";
+        }
+
+        // The generator starts over with the callbacks, so that no sample is generated before the device is activated.
+        bool StartCallbacks(SampleCallback callback) override {
+            StopThread();
+            PushEyeTrackerSource::StartCallbacks(std::move(callback));
+            m_stop = false;
+            m_thread = std::thread(&SyntheticEyeTrackerSource::GeneratorThread, this);
+            return true;
+        }
+
+        void StopCallbacks() override {
+            StopThread();
+            PushEyeTrackerSource::StopCallbacks();
+        }
+
+        void StopThread() {
+            if (!m_thread.joinable()) {
+                return;
+            }
+
+            {
+                std::unique_lock lock(m_stopMutex);
+                m_stop = true;
+            }
+            m_stopCondition.notify_all();
+            m_thread.join();
+        }
+
+        void GeneratorThread() {
+            TraceLocalActivity(local);
+            TraceLoggingWriteStart(local, "SyntheticEyeTrackerSource_GeneratorThread");
+
+            SetThreadName("SyntheticEyeTrackerSource_GeneratorThread");
+
+            std::mt19937 random(1234);
+            std::uniform_real_distribution<float> targetDistribution(-0.35f, 0.35f);
+            std::uniform_real_distribution<double> fixationDistribution(0.2, 0.6);
+            std::uniform_real_distribution<double> blinkDistribution(0.0, 1.0);
+            std::normal_distribution<float> noiseDistribution(0.f, 0.002f);
+
+            EyeGazeTan from{}, to{};
+            double now = 0.0;
+            double saccadeStart = 0.0;
+            double nextSaccade = fixationDistribution(random);
+            double blinkEnd = 0.0;
+
+            const double startTime = GetClock().Now();
+            std::unique_lock lock(m_stopMutex);
+            for (uint64_t tick = 1;; tick++) {
+                const double deadline = startTime + std::chrono::duration<double>(tick * k_Period).count();
+                if (GetClock().WaitUntil(lock, m_stopCondition, deadline, [&] { return m_stop; })) {
+                    break;
+                }
+                now = std::chrono::duration<double>(tick * k_Period).count();
+
+                if (now >= nextSaccade) {
+                    from = to;
+                    to = {targetDistribution(random), targetDistribution(random)};
+                    saccadeStart = now;
+                    nextSaccade = now + k_SaccadeDuration + fixationDistribution(random);
+
+                    // Roughly one blink every 4 seconds, following a saccade.
+                    if (blinkDistribution(random) < 0.1) {
+                        blinkEnd = now + k_BlinkDuration;
+                    }
+                }
+
+                // Smoothstep between the previous and next target during a saccade.
+                const float progress = (float)std::clamp((now - saccadeStart) / k_SaccadeDuration, 0.0, 1.0);
+                const float weight = progress * progress * (3.f - 2.f * progress);
+
+                EyeTrackerSample sample;
+                sample.timeInSeconds = now;
+                sample.isValid = now >= blinkEnd;
+                for (int eye = 0; eye < 2; eye++) {
+                    sample.gazeTan[eye].x = from.x + (to.x - from.x) * weight + noiseDistribution(random);
+                    sample.gazeTan[eye].y = from.y + (to.y - from.y) * weight + noiseDistribution(random);
+                }
+
+                lock.unlock();
+                Deliver(sample);
+                lock.lock();
+            }
+            GetClock().OnThreadExit();
+
+            TraceLoggingWriteStop(local, "SyntheticEyeTrackerSource_GeneratorThread", TLArg(now, "Duration"));
+        }
+
+        std::mutex m_stopMutex;
+        std::condition_variable m_stopCondition;
+        bool m_stop = false;
+        std::thread m_thread;
+    };
+
+} // namespace
+
+namespace eyetracking_core {
+
+    std::shared_ptr<EyeTrackerSource> CreateSyntheticEyeTrackerSource() {
+        return std::make_shared<SyntheticEyeTrackerSource>();
+    }
+
+} // namespace eyetracking_core
@@ -20,8 +20,23 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+
 #pragma once
 
+// TraceLogging on Windows. The provider is defined by the host (see driver_shim/dllmain.cpp), so that the events of
+// the library are captured along with those of the host. On other platforms, the trace macros compile to nothing.
+#ifdef _WIN32
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <TraceLoggingActivity.h>
+#include <TraceLoggingProvider.h>
+
 TRACELOGGING_DECLARE_PROVIDER(TraceProvider);
 
 #define IsTraceEnabled() TraceLoggingProviderEnabled(TraceProvider, 0, 0)
@@ -30,3 +45,18 @@ TRACELOGGING_DECLARE_PROVIDER(TraceProvider);
 
 #define TLArg(var, ...) TraceLoggingValue(var, ##__VA_ARGS__)
 #define TLPArg(var, ...) TraceLoggingPointer(var, ##__VA_ARGS__)
+
+#else
+
+#define IsTraceEnabled() false
+
+#define TraceLocalActivity(activity)
+#define TraceLoggingWrite(...) ((void)0)
+#define TraceLoggingWriteStart(...) ((void)0)
+#define TraceLoggingWriteStop(...) ((void)0)
+#define TraceLoggingWriteTagged(...) ((void)0)
+
+#define TLArg(...)
+#define TLPArg(...)
+
+#endif
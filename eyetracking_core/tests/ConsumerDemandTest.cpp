@@ -0,0 +1,233 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Run the update loop on the virtual clock with demandDrivenRate, against a real reader of the export: the rate must
+// drop once no reader was seen for k_HeartbeatTimeout, a read must bring the full rate back within one poll period,
+// and the time and processor time must be accounted to the right rate.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Clock.h"
+#include "ConsumerDemand.h"
+#include "GazeExportChannel.h"
+#include "GazeUpdateLoop.h"
+#include "Platform.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    constexpr double k_PollPeriod = GazeUpdateLoop::k_PollPeriod;
+    constexpr double k_IdlePollPeriod = 0.1;
+
+    // Processor time burnt by each update, so that idling visibly saves some.
+    constexpr double k_UpdateCost = 0.0002;
+
+    bool g_success = true;
+
+    void Check(const char* name, bool condition) {
+        printf("%s: %s\n", name, condition ? "ok" : "FAILED");
+        g_success &= condition;
+    }
+
+    // Polled, and stamps a new sample at every poll, like the PVR source while it does not track.
+    class PolledSource final : public EyeTrackerSource {
+      public:
+        const char* GetName() const override {
+            return "polled";
+        }
+
+        bool GetLatestSample(EyeTrackerSample& sample) override {
+            sample = {};
+            sample.timeInSeconds = 1.0 + GetClock().Now();
+            return false;
+        }
+    };
+
+    struct Update {
+        double time;
+        double cpuTime;
+    };
+
+    class Host final : public GazeUpdateLoop::Host {
+      public:
+        void Publish(bool, const float*) override {
+        }
+
+        void OnStart() override {
+            Record();
+        }
+
+        void OnSample(double) override {
+            const double cpuTime = Record();
+            while (GetThreadCpuTime() - cpuTime < k_UpdateCost) {
+            }
+        }
+
+        std::vector<Update> GetUpdates() {
+            std::unique_lock lock(m_mutex);
+            return m_updates;
+        }
+
+      private:
+        double Record() {
+            const double cpuTime = GetThreadCpuTime();
+            std::unique_lock lock(m_mutex);
+            m_updates.push_back({GetClock().Now(), cpuTime});
+            return cpuTime;
+        }
+
+        std::mutex m_mutex;
+        std::vector<Update> m_updates;
+    };
+
+    // The loop decides the rate at each update, and waits for that long.
+    bool IsFull(const std::vector<Update>& updates, size_t index) {
+        return updates[index + 1].time - updates[index].time < k_PollPeriod + 1e-9;
+    }
+
+    // The first update at or after time.
+    const Update* FindUpdate(const std::vector<Update>& updates, double time) {
+        for (const Update& update : updates) {
+            if (update.time >= time) {
+                return &update;
+            }
+        }
+        return nullptr;
+    }
+
+    // Wait (in real time) for the loop to process the sample polled at time, and to wait on the clock again.
+    void WaitForUpdate(VirtualClock& clock, Host& host, double time) {
+        const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (host.GetUpdates().back().time < time && std::chrono::steady_clock::now() < timeout) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        clock.WaitForWaiters(1);
+    }
+
+} // namespace
+
+int main() {
+    SetVirtualTime(true);
+    VirtualClock& clock = *GetVirtualClock();
+
+    GazeSettings settings;
+    settings.gazeExport = true;
+    settings.demandDrivenRate = true;
+    settings.idlePollPeriodMs = (int32_t)(k_IdlePollPeriod * 1000);
+
+    Host host;
+    GazeUpdateLoop loop(std::make_shared<PolledSource>(), host, settings);
+    const ConsumerDemand* const demand = loop.GetConsumerDemand();
+    GazeExportReader reader;
+    if (!demand || !reader.Open()) {
+        printf("Failed to open the export\n");
+        return 1;
+    }
+
+    loop.Start();
+    std::thread thread([&] { loop.Run(); });
+    clock.WaitForWaiters(1);
+
+    // Nothing ever read the export.
+    clock.Advance(ConsumerDemand::k_HeartbeatTimeout - k_PollPeriod);
+    Check("Full rate until the heartbeat timeout", !demand->IsIdle());
+    clock.Advance(2 * k_PollPeriod);
+    Check("Idle after the heartbeat timeout", demand->IsIdle());
+    clock.Advance(k_IdlePollPeriod);
+    std::vector<Update> updates = host.GetUpdates();
+    size_t firstIdle = 0;
+    while (firstIdle + 1 < updates.size() && IsFull(updates, firstIdle)) {
+        firstIdle++;
+    }
+    Check("Idle entered at the heartbeat timeout",
+          updates[firstIdle].time > ConsumerDemand::k_HeartbeatTimeout - 1e-9 &&
+              updates[firstIdle].time < ConsumerDemand::k_HeartbeatTimeout + k_PollPeriod);
+
+    clock.Advance(3.0);
+    const size_t idleCount = host.GetUpdates().size() - updates.size();
+    Check("Keep-alive rate while idle", idleCount >= 29 && idleCount <= 31);
+
+    // Read in the middle of a keep-alive period: the watcher of the export wakes the loop up, without the clock moving.
+    clock.Advance(k_IdlePollPeriod / 2);
+    const double readTime = clock.Now();
+    GazeExportSample sample;
+    uint32_t sequence;
+    reader.Read(sample, sequence);
+    WaitForUpdate(clock, host, readTime);
+    clock.Advance(k_PollPeriod);
+    updates = host.GetUpdates();
+    const Update* const wake = FindUpdate(updates, readTime);
+    const Update* const next = FindUpdate(updates, readTime + k_PollPeriod / 2);
+    Check("Full rate within one poll period of a read",
+          wake && wake->time < readTime + k_PollPeriod && next && next->time < wake->time + k_PollPeriod + 1e-9);
+
+    // The reader goes away again.
+    clock.Advance(ConsumerDemand::k_HeartbeatTimeout + 2 * k_IdlePollPeriod);
+    Check("Idle after the reader is gone", demand->IsIdle());
+
+    const ConsumerDemand::Statistics statistics = demand->GetStatistics();
+    loop.Stop();
+    thread.join();
+
+    // Each interval between two updates is spent at the rate decided by the first one.
+    updates = host.GetUpdates();
+    double fullSeconds = 0.0, fullCpuSeconds = 0.0, idleSeconds = 0.0, idleCpuSeconds = 0.0;
+    for (size_t i = 0; i + 1 < updates.size(); i++) {
+        const double seconds = updates[i + 1].time - updates[i].time;
+        const double cpuSeconds = updates[i + 1].cpuTime - updates[i].cpuTime;
+        (IsFull(updates, i) ? fullSeconds : idleSeconds) += seconds;
+        (IsFull(updates, i) ? fullCpuSeconds : idleCpuSeconds) += cpuSeconds;
+    }
+    const double savedCpuSeconds = std::max(idleSeconds * fullCpuSeconds / fullSeconds - idleCpuSeconds, 0.0);
+
+    printf("Expected: %.3f s at full rate (%.4f s CPU), %.3f s idle (%.4f s CPU), %.4f s CPU saved\n",
+           fullSeconds,
+           fullCpuSeconds,
+           idleSeconds,
+           idleCpuSeconds,
+           savedCpuSeconds);
+    printf("Measured: %.3f s at full rate (%.4f s CPU), %.3f s idle (%.4f s CPU), %.4f s CPU saved\n",
+           statistics.fullSeconds,
+           statistics.fullCpuSeconds,
+           statistics.idleSeconds,
+           statistics.idleCpuSeconds,
+           statistics.savedCpuSeconds);
+    Check("Time at each rate",
+          std::abs(statistics.fullSeconds - fullSeconds) < 1e-9 &&
+              std::abs(statistics.idleSeconds - idleSeconds) < 1e-9);
+    Check("Processor time at each rate",
+          std::abs(statistics.fullCpuSeconds - fullCpuSeconds) < 0.002 &&
+              std::abs(statistics.idleCpuSeconds - idleCpuSeconds) < 0.002);
+    Check("Processor time saved",
+          savedCpuSeconds > 0.0 && std::abs(statistics.savedCpuSeconds - savedCpuSeconds) < 0.002);
+
+    printf("%s\n", g_success ? "Passed" : "Failed");
+    return g_success ? 0 : 1;
+}
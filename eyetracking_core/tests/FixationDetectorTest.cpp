@@ -0,0 +1,233 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Check the incremental FixationDetector against a direct implementation of the same I-DT rules, which recomputes the
+// dispersion and the centroid over every sample of the window or of the fixation, on a synthetic stream of fixations,
+// saccades, blinks and stream rate changes. Also check that a stream too fast for the window is reported.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <random>
+
+#include "FixationDetector.h"
+#include "Platform.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    constexpr float k_RadiansToDegrees = 180.f / 3.14159265f;
+
+    struct Point {
+        double time;
+        float yaw;   // Degrees.
+        float pitch; // Degrees.
+    };
+
+    float GetDispersion(const std::deque<Point>& points) {
+        float minYaw = points.front().yaw, maxYaw = minYaw;
+        float minPitch = points.front().pitch, maxPitch = minPitch;
+        for (const Point& point : points) {
+            minYaw = std::min(minYaw, point.yaw);
+            maxYaw = std::max(maxYaw, point.yaw);
+            minPitch = std::min(minPitch, point.pitch);
+            maxPitch = std::max(maxPitch, point.pitch);
+        }
+        return (maxYaw - minYaw) + (maxPitch - minPitch);
+    }
+
+    // O(n) per sample.
+    class ReferenceDetector {
+      public:
+        explicit ReferenceDetector(const FixationDetector::Parameters& parameters)
+            : m_parameters(parameters),
+              m_capacity((size_t)std::ceil(parameters.minDuration * parameters.maxSampleRate) + 1) {
+        }
+
+        void Process(GazeSample& sample) {
+            if (!sample.isValid) {
+                m_window.clear();
+                m_fixation.clear();
+                return;
+            }
+
+            const Point current{
+                sample.timeInSeconds, sample.yaw * k_RadiansToDegrees, sample.pitch * k_RadiansToDegrees};
+            if (!m_fixation.empty()) {
+                m_fixation.push_back(current);
+                if (GetDispersion(m_fixation) > m_parameters.dispersion) {
+                    m_fixation.clear();
+                    m_window = {current};
+                }
+            } else {
+                m_window.push_back(current);
+                if (m_window.size() > m_capacity) {
+                    m_window.pop_front();
+                }
+                while (GetDispersion(m_window) > m_parameters.dispersion) {
+                    m_window.pop_front();
+                }
+                if (m_window.back().time - m_window.front().time >= m_parameters.minDuration) {
+                    m_fixation.swap(m_window);
+                    m_window.clear();
+                }
+            }
+
+            sample.isFixation = !m_fixation.empty();
+            if (sample.isFixation) {
+                double yawSum = 0.0, pitchSum = 0.0;
+                for (const Point& point : m_fixation) {
+                    yawSum += point.yaw;
+                    pitchSum += point.pitch;
+                }
+                sample.fixationYaw = (float)(yawSum / m_fixation.size()) / k_RadiansToDegrees;
+                sample.fixationPitch = (float)(pitchSum / m_fixation.size()) / k_RadiansToDegrees;
+                sample.fixationDuration = (float)(current.time - m_fixation.front().time);
+            }
+        }
+
+      private:
+        const FixationDetector::Parameters m_parameters;
+        const size_t m_capacity;
+        std::deque<Point> m_window;
+        std::deque<Point> m_fixation;
+    };
+
+    uint32_t g_logCount = 0;
+
+    void CountLog(const char* message) {
+        printf("%s\n", message);
+        g_logCount++;
+    }
+
+    // Feed a still gaze at the given rate, and return the number of samples in fixation.
+    uint64_t CountStillFixations(FixationDetector& detector, double rate, uint64_t count) {
+        uint64_t fixations = 0;
+        for (uint64_t i = 0; i < count; i++) {
+            GazeSample sample;
+            sample.timeInSeconds = i / rate;
+            sample.isValid = true;
+            detector.Process(sample);
+            fixations += sample.isFixation;
+        }
+        return fixations;
+    }
+
+} // namespace
+
+int main() {
+    FixationDetector::Parameters parameters;
+    parameters.dispersion = 1.f;
+    parameters.minDuration = 0.1;
+    parameters.maxSampleRate = 250.f;
+
+    FixationDetector detector(parameters);
+    ReferenceDetector reference(parameters);
+
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> targetDistribution(-0.4f, 0.4f);
+    std::uniform_real_distribution<double> durationDistribution(0.02, 0.5);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::normal_distribution<float> noiseDistribution(0.f, 0.001f);
+
+    // Mostly 200 Hz, with stretches faster than maxSampleRate to exercise the bounded window.
+    float targetYaw = 0.f, targetPitch = 0.f;
+    double time = 0.0, nextTarget = 0.0, period = 0.005;
+    bool isBlinking = false;
+    uint64_t fixations = 0, mismatches = 0;
+    const uint64_t count = 2000000;
+    for (uint64_t i = 0; i < count; i++) {
+        if (time >= nextTarget) {
+            targetYaw = targetDistribution(random);
+            targetPitch = targetDistribution(random);
+            nextTarget = time + durationDistribution(random);
+            isBlinking = uniform(random) < 0.05;
+            period = uniform(random) < 0.1 ? 0.001 : 0.005;
+        }
+        time += period;
+
+        GazeSample sample;
+        sample.timeInSeconds = time;
+        sample.isValid = !isBlinking;
+        sample.yaw = targetYaw + noiseDistribution(random);
+        sample.pitch = targetPitch + noiseDistribution(random);
+
+        GazeSample expected = sample;
+        detector.Process(sample);
+        reference.Process(expected);
+
+        // The centroids only differ by the rounding of the running sums.
+        const bool isCentroidMismatch = std::abs(sample.fixationYaw - expected.fixationYaw) > 1e-5f ||
+                                        std::abs(sample.fixationPitch - expected.fixationPitch) > 1e-5f;
+        const bool isMismatch =
+            sample.isFixation != expected.isFixation ||
+            (sample.isFixation && (isCentroidMismatch || sample.fixationDuration != expected.fixationDuration));
+        if (isMismatch && mismatches++ < 10) {
+            printf("Mismatch at sample %llu (t=%.3f): fixation %d/%d yaw %.6f/%.6f pitch %.6f/%.6f "
+                   "duration %.4f/%.4f\n",
+                   (unsigned long long)i,
+                   time,
+                   sample.isFixation,
+                   expected.isFixation,
+                   sample.fixationYaw,
+                   expected.fixationYaw,
+                   sample.fixationPitch,
+                   expected.fixationPitch,
+                   sample.fixationDuration,
+                   expected.fixationDuration);
+        }
+        fixations += sample.isFixation;
+    }
+
+    printf("%llu samples, %llu in fixation, %llu mismatches\n",
+           (unsigned long long)count,
+           (unsigned long long)fixations,
+           (unsigned long long)mismatches);
+    bool success = !mismatches;
+
+    // At maxSampleRate, the window spans exactly minDuration once full.
+    SetLogSink(CountLog);
+    FixationDetector atRate(parameters);
+    const uint64_t atRateFixations = CountStillFixations(atRate, parameters.maxSampleRate, 1000);
+    printf("At %.0f Hz: %llu in fixation, %llu truncated\n",
+           parameters.maxSampleRate,
+           (unsigned long long)atRateFixations,
+           (unsigned long long)atRate.GetTruncatedCount());
+    success &= atRateFixations == 1000 - (uint64_t)std::llround(parameters.minDuration * parameters.maxSampleRate) &&
+               !atRate.GetTruncatedCount() && !g_logCount;
+
+    // Twice as fast, the full window only spans half of minDuration: no fixation, reported once.
+    FixationDetector tooFast(parameters);
+    const uint64_t tooFastFixations = CountStillFixations(tooFast, parameters.maxSampleRate * 2, 1000);
+    printf("At %.0f Hz: %llu in fixation, %llu truncated\n",
+           parameters.maxSampleRate * 2,
+           (unsigned long long)tooFastFixations,
+           (unsigned long long)tooFast.GetTruncatedCount());
+    const uint64_t capacity = (uint64_t)std::ceil(parameters.minDuration * parameters.maxSampleRate) + 1;
+    success &= !tooFastFixations && tooFast.GetTruncatedCount() == 1000 - capacity && g_logCount == 1;
+    SetLogSink(nullptr);
+
+    printf("%s\n", success ? "Passed" : "Failed");
+    return success ? 0 : 1;
+}
@@ -0,0 +1,251 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Check the recovery of the export after the driver stopped in the middle of a publish, and the ring of recent samples:
+// an overrun and a lap during a copy on a single thread, then concurrent readers (one of them too slow to keep up)
+// against a writer publishing as fast as it can. Every reader must see each sample at most once, in order, never torn,
+// and account for every sample it did not read.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "GazeExportChannel.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    bool g_success = true;
+
+    void Check(const char* name, bool condition) {
+        printf("%s: %s\n", name, condition ? "ok" : "FAILED");
+        g_success &= condition;
+    }
+
+    // Every field is derived from the number of the sample, so that a sample mixing two writes is detected.
+    GazeSample MakeSample(uint64_t index) {
+        GazeSample sample;
+        sample.timeInSeconds = (double)index;
+        sample.isValid = true;
+        sample.yaw = (float)(index % 65536);
+        sample.pitch = -sample.yaw;
+        sample.gazeTan[1].y = sample.yaw;
+        sample.events = (uint32_t)index;
+        return sample;
+    }
+
+    bool IsIntact(const GazeExportSample& sample) {
+        const uint64_t index = (uint64_t)sample.timeInSeconds;
+        const float value = (float)(index % 65536);
+        return sample.yaw == value && sample.pitch == -value && sample.gazeTan[1][1] == value &&
+               sample.events == (uint32_t)index;
+    }
+
+    // The driver stopped between the two increments of the sequence: readers give up, until the driver restarts.
+    void TestRecovery() {
+        GazeExportWriter writer;
+        GazeExportReader reader;
+        SharedMemory memory;
+        if (!writer.Open() || !reader.Open() || !memory.Open(k_GazeExportName)) {
+            Check("Open the export", false);
+            return;
+        }
+        writer.Publish(MakeSample(1));
+
+        GazeExportSample exported;
+        uint32_t sequence = 0;
+        Check("Read", reader.Read(exported, sequence) && sequence == 2 && exported.timeInSeconds == 1.0);
+
+        GazeExportHeader* const header = reinterpret_cast<GazeExportHeader*>(memory.GetData());
+        header->sequence.fetch_add(1);
+        Check("Read while the sequence is odd fails", !reader.Read(exported, sequence));
+        Check("Wait while the sequence is odd times out", !reader.Wait(sequence, 0.01));
+
+        // The driver restarts while the export is still mapped by the reader.
+        GazeExportWriter restarted;
+        if (!restarted.Open()) {
+            Check("Open the export again", false);
+            return;
+        }
+        Check("Read after the restart",
+              reader.Read(exported, sequence) && sequence == 4 && !(exported.flags & GazeExportFlags_Valid));
+        restarted.Publish(MakeSample(2));
+        Check("Read the next sample",
+              reader.Read(exported, sequence) && sequence == 6 && (exported.flags & GazeExportFlags_Valid));
+    }
+
+    void TestRingOverrun() {
+        GazeExportWriter writer;
+        GazeExportReader reader;
+        if (!writer.Open() || !reader.Open()) {
+            Check("Open the export", false);
+            return;
+        }
+
+        // A reader more than a ring behind skips to the oldest sample still there.
+        const uint64_t published = 3 * GazeExportWriter::k_RingCapacity + 10;
+        for (uint64_t i = 0; i < published; i++) {
+            writer.Publish(MakeSample(i));
+        }
+        std::vector<GazeExportSample> samples(published);
+        uint64_t cursor = 0, missed = 0;
+        const size_t read = reader.ReadRing(cursor, samples.data(), samples.size(), missed);
+        bool isInOrder = true;
+        for (size_t i = 0; i < read; i++) {
+            isInOrder &= IsIntact(samples[i]) && samples[i].timeInSeconds == (double)(missed + i);
+        }
+        printf("Overrun: %zu read, %llu missed\n", read, (unsigned long long)missed);
+        Check("Overrun", read == GazeExportWriter::k_RingCapacity && missed == published - read && isInOrder &&
+                             cursor == published);
+    }
+
+    void TestRingLap() {
+        GazeExportWriter writer;
+        GazeExportReader reader;
+        SharedMemory memory;
+        if (!writer.Open() || !reader.Open() || !memory.Open(k_GazeExportName)) {
+            Check("Open the export", false);
+            return;
+        }
+
+        // The reader is a full ring behind, and the writer starts overwriting its next sample while it copies: that
+        // sample is lost, the others are read.
+        const uint64_t capacity = GazeExportWriter::k_RingCapacity;
+        const uint64_t published = 2 * capacity;
+        for (uint64_t i = 0; i < published; i++) {
+            writer.Publish(MakeSample(i));
+        }
+        GazeExportHeader* const header = reinterpret_cast<GazeExportHeader*>(memory.GetData());
+        GazeExportSlot* const slots = reinterpret_cast<GazeExportSlot*>(header + 1);
+        slots[published % capacity].sequence.store(2 * published + 1);
+
+        std::vector<GazeExportSample> samples(capacity);
+        uint64_t cursor = published - capacity, missed = 0;
+        const size_t read = reader.ReadRing(cursor, samples.data(), samples.size(), missed);
+        bool isInOrder = true;
+        for (size_t i = 0; i < read; i++) {
+            isInOrder &= IsIntact(samples[i]) && samples[i].timeInSeconds == (double)(published - capacity + 1 + i);
+        }
+        printf("Lap during the copy: %zu read, %llu missed\n", read, (unsigned long long)missed);
+        Check("Lap during the copy", read == capacity - 1 && missed == 1 && isInOrder && cursor == published);
+    }
+
+    struct ReaderResult {
+        uint64_t read = 0;
+        uint64_t missed = 0;
+        uint64_t torn = 0;
+        uint64_t outOfOrder = 0;
+    };
+
+    void TestRingConcurrent() {
+        GazeExportWriter writer;
+        if (!writer.Open()) {
+            Check("Open the export", false);
+            return;
+        }
+
+        const uint64_t published = 2000000;
+        const size_t readerCount = 8;
+        std::atomic<bool> isDone = false;
+        std::vector<ReaderResult> results(readerCount);
+        std::vector<std::thread> readers;
+        std::atomic<size_t> readyCount = 0;
+        for (size_t r = 0; r < readerCount; r++) {
+            readers.emplace_back([&, r] {
+                // The last reader sleeps after each batch, and is lapped over and over.
+                const bool isSlow = r == readerCount - 1;
+                GazeExportReader reader;
+                if (!reader.Open()) {
+                    return;
+                }
+                ReaderResult& result = results[r];
+                GazeExportSample samples[64];
+                uint64_t cursor = 0, next = 0;
+                readyCount++;
+                while (true) {
+                    const bool wasDone = isDone;
+                    uint64_t missed = 0;
+                    const size_t read = reader.ReadRing(cursor, samples, std::size(samples), missed);
+                    next += missed;
+                    result.missed += missed;
+                    for (size_t i = 0; i < read; i++) {
+                        if (!IsIntact(samples[i])) {
+                            result.torn++;
+                        } else if (samples[i].timeInSeconds != (double)next) {
+                            result.outOfOrder++;
+                        }
+                        next++;
+                    }
+                    result.read += read;
+                    if (!read) {
+                        if (wasDone) {
+                            break;
+                        }
+                        reader.WaitRing(cursor, 0.001);
+                    } else if (isSlow) {
+                        std::this_thread::sleep_for(std::chrono::microseconds(500));
+                    }
+                }
+            });
+        }
+        while (readyCount < readerCount) {
+            std::this_thread::yield();
+        }
+
+        for (uint64_t i = 0; i < published; i++) {
+            writer.Publish(MakeSample(i));
+        }
+        isDone = true;
+        for (std::thread& reader : readers) {
+            reader.join();
+        }
+
+        bool isCorrect = true;
+        for (size_t r = 0; r < readerCount; r++) {
+            const ReaderResult& result = results[r];
+            printf("Reader %zu: %llu read, %llu missed, %llu torn, %llu out of order\n",
+                   r,
+                   (unsigned long long)result.read,
+                   (unsigned long long)result.missed,
+                   (unsigned long long)result.torn,
+                   (unsigned long long)result.outOfOrder);
+            isCorrect &= result.read + result.missed == published && !result.torn && !result.outOfOrder;
+        }
+        Check("Concurrent readers", isCorrect);
+        Check("Slow reader lapped", results[readerCount - 1].missed > 0);
+    }
+
+} // namespace
+
+int main() {
+    TestRecovery();
+    TestRingOverrun();
+    TestRingLap();
+    TestRingConcurrent();
+
+    printf("%s\n", g_success ? "Passed" : "Failed");
+    return g_success ? 0 : 1;
+}
@@ -0,0 +1,144 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Check the decay weighting of GazeHeatmap against closed-form values, including across renormalizations, the yaw wrap
+// of the world layer, and the samples that cannot be binned.
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <numeric>
+
+#include "GazeHeatmap.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    constexpr float k_DegreesToRadians = 3.14159265f / 180.f;
+
+    bool g_success = true;
+
+    void Check(const char* name, double actual, double expected, double tolerance) {
+        const bool isCorrect = std::abs(actual - expected) <= tolerance;
+        printf("%s: %.7g (expected %.7g)%s\n", name, actual, expected, isCorrect ? "" : " FAILED");
+        g_success &= isCorrect;
+    }
+
+    GazeSample MakeSample(double time, float yawDegrees, float pitchDegrees) {
+        GazeSample sample;
+        sample.timeInSeconds = time;
+        sample.isValid = true;
+        sample.yaw = yawDegrees * k_DegreesToRadians;
+        sample.pitch = pitchDegrees * k_DegreesToRadians;
+        return sample;
+    }
+
+    float GetCell(const GazeHeatmapGrid& grid, float yawDegrees, float pitchDegrees) {
+        const uint32_t column = (uint32_t)std::floor((yawDegrees + grid.maxYaw) / GazeHeatmap::k_CellSize);
+        const uint32_t row = (uint32_t)std::floor((grid.maxPitch - pitchDegrees) / GazeHeatmap::k_CellSize);
+        return grid.cells[(size_t)row * grid.width + column];
+    }
+
+    double GetTotal(const GazeHeatmapGrid& grid) {
+        return std::accumulate(grid.cells.begin(), grid.cells.end(), 0.0);
+    }
+
+} // namespace
+
+int main() {
+    GazeHeatmapSnapshot snapshot;
+
+    // With a half-life of 1 s, each sample weighs 2^-(age in seconds) at the time of the snapshot.
+    {
+        GazeHeatmap heatmap(1.0);
+        heatmap.Add(MakeSample(10.0, 10.f, 5.f), nullptr);
+        heatmap.Add(MakeSample(11.0, 10.f, 5.f), nullptr);
+        heatmap.Add(MakeSample(11.5, -20.f, -5.f), nullptr);
+        heatmap.Add(MakeSample(12.0, -20.f, -5.f), nullptr);
+        heatmap.TakeSnapshot(snapshot);
+        Check("Decay, first cell", GetCell(snapshot.head, 10.f, 5.f), 0.25 + 0.5, 1e-6);
+        Check("Decay, second cell", GetCell(snapshot.head, -20.f, -5.f), std::pow(2.0, -0.5) + 1.0, 1e-6);
+        Check("Decay, total", GetTotal(snapshot.head), 0.25 + 0.5 + std::pow(2.0, -0.5) + 1.0, 1e-6);
+    }
+
+    // With a half-life of 10 ms over 2 s, the weight passes k_MaxWeight (2^20) every 200 ms: the grid is renormalized
+    // 9 times, and the total is still the geometric series sum(2^-k).
+    {
+        GazeHeatmap heatmap(0.01);
+        const int count = 201;
+        for (int i = 0; i < count; i++) {
+            heatmap.Add(MakeSample(i * 0.01, i % 2 ? 30.f : -30.f, 0.f), nullptr);
+        }
+        heatmap.TakeSnapshot(snapshot);
+        // The last sample (i = 200) is on the left: the left cell holds 1 + 1/4 + ..., the right one 1/2 + 1/8 + ...
+        Check("Renormalized, left cell", GetCell(snapshot.head, -30.f, 0.f), 4.0 / 3.0, 1e-5);
+        Check("Renormalized, right cell", GetCell(snapshot.head, 30.f, 0.f), 2.0 / 3.0, 1e-5);
+        Check("Renormalized, total", GetTotal(snapshot.head), 2.0, 1e-5);
+    }
+
+    // Without decay, each sample counts for 1. Straight behind is yaw 180°, the same cell as -180°: the first column
+    // of the world layer. The poles belong to the outermost rows.
+    {
+        GazeHeatmap heatmap;
+        const float behind[3] = {0.f, 0.f, 1.f};
+        const float behindLeft[3] = {-0.001f, 0.f, 1.f};
+        const float behindRight[3] = {0.001f, 0.f, 1.f};
+        const float up[3] = {0.f, 1.f, 0.f};
+        heatmap.Add(MakeSample(0.0, 0.f, 0.f), behind);
+        heatmap.Add(MakeSample(0.1, 0.f, 0.f), behindLeft);
+        heatmap.Add(MakeSample(0.2, 0.f, 0.f), behindRight);
+        heatmap.Add(MakeSample(0.3, 0.f, 0.f), up);
+        heatmap.TakeSnapshot(snapshot);
+        const GazeHeatmapGrid& world = snapshot.world;
+        const size_t equator = world.height / 2;
+        Check("Wrap, first column", world.cells[equator * world.width], 2.0, 0.0);
+        Check("Wrap, last column", world.cells[equator * world.width + world.width - 1], 1.0, 0.0);
+        Check("Wrap, top row", std::accumulate(world.cells.begin(), world.cells.begin() + world.width, 0.0), 1.0, 0.0);
+        Check("Wrap, total", GetTotal(world), 4.0, 0.0);
+    }
+
+    // Samples outside of the head grid, or with NaN angles, are counted and not binned.
+    {
+        GazeHeatmap heatmap(1.0);
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        const float forward[3] = {0.f, 0.f, -1.f};
+        const float nanDirection[3] = {nan, 0.f, -1.f};
+        heatmap.Add(MakeSample(0.0, 70.f, 0.f), forward);
+        heatmap.Add(MakeSample(0.1, 0.f, -61.f), nullptr);
+        heatmap.Add(MakeSample(0.2, nan, 0.f), nanDirection);
+        heatmap.Add(MakeSample(0.3, 0.f, nan), nullptr);
+        heatmap.Add(MakeSample(0.4, 1e30f, 0.f), nullptr);
+        heatmap.Add(MakeSample(0.5, 0.f, 0.f), nullptr);
+        GazeSample invalid = MakeSample(0.6, 0.f, 0.f);
+        invalid.isValid = false;
+        heatmap.Add(invalid, nullptr);
+        heatmap.TakeSnapshot(snapshot);
+        Check("Out of range", (double)heatmap.GetOutOfRangeCount(), 5.0, 0.0);
+        Check("Samples", (double)heatmap.GetSampleCount(), 6.0, 0.0);
+        Check("Head total", GetTotal(snapshot.head), 1.0, 1e-6);
+        Check("World total", GetTotal(snapshot.world), std::pow(2.0, -0.5), 1e-6);
+    }
+
+    printf("%s\n", g_success ? "Passed" : "Failed");
+    return g_success ? 0 : 1;
+}
@@ -0,0 +1,213 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Check GazeHistory::Query against a scan of every sample ever added. The ranges are random, but their edges are
+// retained exactly by some level (so that no rounding to coarser buckets applies): they cross the boundaries between
+// levels, the rings of every level wrap around many times, and the stream has gaps and invalid samples.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "GazeHistory.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    constexpr int64_t k_TicksPerSecond = 1000000;
+    constexpr size_t k_LevelCount = 3;
+    constexpr int64_t k_LevelWidths[k_LevelCount] = {k_TicksPerSecond / 100, k_TicksPerSecond / 10, k_TicksPerSecond};
+
+    // GazeHistory floors timestamps to microseconds: give it the middle of the tick, so that it gets the same tick.
+    double ToSeconds(int64_t ticks) {
+        return (ticks + 0.5) / k_TicksPerSecond;
+    }
+
+    int64_t FloorDiv(int64_t value, int64_t divisor) {
+        const int64_t quotient = value / divisor;
+        return (value % divisor < 0) ? quotient - 1 : quotient;
+    }
+
+    // Every sample, and what each level of the history retains, by the same rules as GazeHistory.
+    class Reference {
+      public:
+        void Add(int64_t ticks, const GazeSample& sample) {
+            const int64_t rawLimit = ticks - k_TicksPerSecond;
+            while (m_rawFirst < m_samples.size() && (m_samples.size() - m_rawFirst == GazeHistory::k_MaxRawSamples ||
+                                                     m_samples[m_rawFirst].ticks < rawLimit)) {
+                m_rawStartTicks = m_samples[m_rawFirst].ticks + 1;
+                m_rawFirst++;
+            }
+            for (size_t level = 0; level < k_LevelCount; level++) {
+                const int64_t index = FloorDiv(ticks, k_LevelWidths[level]);
+                m_oldestIndex[level] = m_samples.empty()
+                                           ? index
+                                           : std::max(m_oldestIndex[level],
+                                                      index - (int64_t)GazeHistory::k_BucketsPerLevel + 1);
+            }
+            m_samples.push_back({ticks, sample});
+        }
+
+        GazeSummary Summarize(int64_t start, int64_t end) const {
+            GazeSummary result;
+            auto it = std::lower_bound(
+                m_samples.begin(), m_samples.end(), start, [](const Entry& entry, int64_t ticks) {
+                    return entry.ticks < ticks;
+                });
+            for (; it != m_samples.end() && it->ticks < end; ++it) {
+                result.Add(it->sample);
+            }
+            return result;
+        }
+
+        int64_t GetLatestTicks() const {
+            return m_samples.back().ticks;
+        }
+
+        // The raw samples are complete from this time.
+        int64_t GetRawStartTicks() const {
+            return m_rawStartTicks;
+        }
+
+        int64_t GetOldestIndex(size_t level) const {
+            return m_oldestIndex[level];
+        }
+
+      private:
+        struct Entry {
+            int64_t ticks;
+            GazeSample sample;
+        };
+
+        std::vector<Entry> m_samples;
+        size_t m_rawFirst = 0;
+        int64_t m_rawStartTicks = INT64_MIN;
+        int64_t m_oldestIndex[k_LevelCount]{};
+    };
+
+    bool IsEqual(const GazeSummary& a, const GazeSummary& b) {
+        if (a.sampleCount != b.sampleCount || a.validCount != b.validCount) {
+            return false;
+        }
+        for (int channel = 0; channel < GazeSummary::ChannelCount; channel++) {
+            // The sums only differ by the order of the additions.
+            if (a.count[channel] != b.count[channel] ||
+                (a.count[channel] && (a.min[channel] != b.min[channel] || a.max[channel] != b.max[channel] ||
+                                      std::abs(a.sum[channel] - b.sum[channel]) > 1e-6))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace
+
+int main() {
+    GazeHistory history;
+    Reference reference;
+
+    std::mt19937 random(42);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::uniform_real_distribution<float> angleDistribution(-0.5f, 0.5f);
+
+    // About 120 Hz with jitter, for about 40 minutes: the 1 s level, retaining about 17 minutes, wraps twice.
+    const uint64_t count = 300000;
+    const int64_t gapTicks[] = {k_TicksPerSecond / 2, 20 * k_TicksPerSecond, 300 * k_TicksPerSecond};
+    int64_t ticks = 1234567;
+    bool isValid = true;
+    uint64_t queries = 0, mismatches = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        ticks += 8000 + (int64_t)(uniform(random) * 1000);
+        if (uniform(random) < 0.0005) {
+            ticks += gapTicks[(size_t)(uniform(random) * std::size(gapTicks))];
+        }
+        if (uniform(random) < 0.01) {
+            isValid = !isValid || uniform(random) < 0.2;
+        }
+
+        GazeSample sample;
+        sample.timeInSeconds = ToSeconds(ticks);
+        sample.isValid = isValid;
+        sample.yaw = angleDistribution(random);
+        sample.pitch = angleDistribution(random);
+        sample.hasDerivatives = uniform(random) < 0.7;
+        sample.angularVelocity = sample.hasDerivatives ? (float)(uniform(random) * 500.0) : 0.f;
+        history.Add(sample);
+        reference.Add(ticks, sample);
+
+        if (i % 200) {
+            continue;
+        }
+        const int64_t latest = reference.GetLatestTicks();
+        const int64_t rawStart = std::max(reference.GetRawStartTicks(), latest - 2 * k_TicksPerSecond);
+        for (int query = 0; query < 20; query++) {
+            // Start from the raw samples, or from a bucket of a level. End in the raw samples, or on a bucket.
+            const size_t level = (size_t)(uniform(random) * (k_LevelCount + 1));
+            int64_t start, end;
+            if (level == 0) {
+                start = rawStart + (int64_t)(uniform(random) * (latest - rawStart + 1));
+                end = start + (int64_t)(uniform(random) * (latest + 20000 - start));
+            } else {
+                const int64_t width = k_LevelWidths[level - 1];
+                const int64_t oldestIndex = reference.GetOldestIndex(level - 1);
+                const int64_t latestIndex = FloorDiv(latest, width);
+                const int64_t startIndex = oldestIndex + (int64_t)(uniform(random) * (latestIndex - oldestIndex + 1));
+                start = startIndex * width;
+                const int64_t endMin = std::max(start, rawStart + k_LevelWidths[0]);
+                if (uniform(random) < 0.5 && endMin <= latest) {
+                    end = endMin + (int64_t)(uniform(random) * (latest + 20000 - endMin));
+                } else {
+                    end = (startIndex + (int64_t)(uniform(random) * (latestIndex - startIndex + 2))) * width;
+                }
+            }
+
+            const GazeSummary actual = history.Query(ToSeconds(start), ToSeconds(end));
+            const GazeSummary expected = reference.Summarize(start, end);
+            queries++;
+            if (!IsEqual(actual, expected) && mismatches++ < 10) {
+                printf("Mismatch at sample %llu, level %zu, [%.6f, %.6f) latest %.6f: %u/%u samples, %u/%u valid, "
+                       "yaw mean %.6f/%.6f\n",
+                       (unsigned long long)i,
+                       level,
+                       start / (double)k_TicksPerSecond,
+                       end / (double)k_TicksPerSecond,
+                       latest / (double)k_TicksPerSecond,
+                       actual.sampleCount,
+                       expected.sampleCount,
+                       actual.validCount,
+                       expected.validCount,
+                       actual.GetMean(GazeSummary::Yaw),
+                       expected.GetMean(GazeSummary::Yaw));
+            }
+        }
+    }
+
+    printf("%llu samples, %llu queries, %llu mismatches\n",
+           (unsigned long long)count,
+           (unsigned long long)queries,
+           (unsigned long long)mismatches);
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,108 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Load the sample plugin through GazePluginStage, and check that the samples round-trip through it, that the driver
+// recomputes the gaze angles, and that failing or slow plugins are disabled.
+//
+// Usage: gaze_plugin_test <path to the sample plugin>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+#include "GazePluginStage.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    GazeSample MakeSample(double time, float x, float y) {
+        EyeTrackerSample sample;
+        sample.timeInSeconds = time;
+        sample.isValid = true;
+        for (auto& gazeTan : sample.gazeTan) {
+            gazeTan = {x, y};
+        }
+        return MakeGazeSample(sample);
+    }
+
+    bool Check(bool condition, const char* description) {
+        printf("%s: %s\n", description, condition ? "ok" : "FAILED");
+        return condition;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s <path to the sample plugin>\n", argv[0]);
+        return 2;
+    }
+    const std::string path = argv[1];
+    const auto budget = std::chrono::microseconds(500);
+
+    bool success = true;
+    success &= Check(!GazePluginStage::Load(path + ".missing", "", budget), "Missing library is rejected");
+
+    const auto stage = GazePluginStage::Load(path, "0.25", budget);
+    success &= Check(stage != nullptr, "Plugin loads");
+    if (!stage) {
+        return 1;
+    }
+
+    GazeSample samples[300];
+    for (int i = 0; i < 300; i++) {
+        samples[i] = MakeSample(i * 0.005, 0.f, 0.1f);
+    }
+    samples[1].isValid = false;
+    stage->ProcessBatch(samples, 300);
+    const GazeSample expected = MakeSample(0.0, 0.25f, 0.1f);
+    bool isOffset = true;
+    for (int i = 0; i < 300; i++) {
+        if (i == 1) {
+            continue;
+        }
+        isOffset &= samples[i].gazeTan[0].x == 0.25f && samples[i].gazeTan[1].x == 0.25f &&
+                    std::abs(samples[i].yaw - expected.yaw) < 1e-6f &&
+                    std::abs(samples[i].pitch - expected.pitch) < 1e-6f;
+    }
+    success &= Check(isOffset, "Samples are processed and the angles recomputed");
+    success &= Check(!samples[1].isValid && samples[1].gazeTan[0].x == 0.f, "Invalid samples are left untouched");
+    success &= Check(!stage->IsDisabled(), "Plugin within budget stays enabled");
+    stage->Reset();
+
+    const auto failing = GazePluginStage::Load(path, "fail", budget);
+    GazeSample sample = MakeSample(0.0, 0.f, 0.f);
+    if (failing) {
+        failing->Process(sample);
+    }
+    success &= Check(failing && failing->IsDisabled() && sample.gazeTan[0].x == 0.f, "Failing plugin is disabled");
+
+    const auto overBudget = GazePluginStage::Load(path, "0", std::chrono::microseconds(0));
+    for (uint64_t i = 0; overBudget && i < GazePluginStage::k_EvaluationWindow; i++) {
+        sample = MakeSample(i * 0.005, 0.f, 0.f);
+        overBudget->Process(sample);
+    }
+    success &= Check(overBudget && overBudget->IsDisabled(), "Plugin over budget is disabled");
+
+    return success ? 0 : 1;
+}
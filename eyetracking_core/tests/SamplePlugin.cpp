@@ -0,0 +1,77 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// A minimal plugin (see GazePluginApi.h) for the plugin test: it offsets the horizontal gaze of both eyes by the
+// amount given in its configuration, and fails on a configuration of "fail".
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "GazePluginApi.h"
+
+namespace {
+
+    struct SamplePlugin {
+        float offset;
+        bool shouldFail;
+    };
+
+    void* Create(const char* config) {
+        return new (std::nothrow) SamplePlugin{(float)atof(config), strcmp(config, "fail") == 0};
+    }
+
+    void Destroy(void* instance) {
+        delete static_cast<SamplePlugin*>(instance);
+    }
+
+    int32_t Process(void* instance, GazePluginSample* samples, uint32_t count) {
+        const SamplePlugin* const plugin = static_cast<SamplePlugin*>(instance);
+        if (plugin->shouldFail) {
+            return -1;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            for (int eye = 0; eye < 2; eye++) {
+                samples[i].gazeTan[eye][0] += plugin->offset;
+            }
+        }
+        return 0;
+    }
+
+    void Reset(void*) {
+    }
+
+    const GazePluginInterface k_Interface = {
+        GAZE_PLUGIN_ABI_VERSION,
+        sizeof(GazePluginSample),
+        "Sample",
+        Create,
+        Destroy,
+        Process,
+        Reset,
+    };
+
+} // namespace
+
+extern "C" GAZE_PLUGIN_EXPORT const GazePluginInterface* GazePlugin_GetInterface(uint32_t hostAbiVersion) {
+    return hostAbiVersion == GAZE_PLUGIN_ABI_VERSION ? &k_Interface : nullptr;
+}
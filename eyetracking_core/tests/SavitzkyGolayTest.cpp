@@ -0,0 +1,113 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Check the derivatives of the Savitzky-Golay differentiator on a known quadratic, sampled regularly, irregularly, and
+// with the repeated timestamps of a source polled faster than it produces samples.
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "SavitzkyGolay.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    // Position, velocity and acceleration of the quadratic at time t.
+    constexpr double k_A = 3.0, k_B = -40.0, k_C = 250.0;
+
+    bool Check(const char* name, const std::vector<double>& times) {
+        SavitzkyGolayDifferentiator<7, 2, 1> differentiator;
+        uint32_t checked = 0, failures = 0;
+        for (double time : times) {
+            differentiator.Push(time, {(float)(k_A + k_B * time + 0.5 * k_C * time * time)});
+
+            float derivatives[3][1];
+            if (!differentiator.GetDerivatives(derivatives)) {
+                continue;
+            }
+            checked++;
+            const double velocity = k_B + k_C * time;
+            const bool isCorrect = std::isfinite(derivatives[1][0]) && std::isfinite(derivatives[2][0]) &&
+                                   std::abs(derivatives[1][0] - velocity) < 0.05 &&
+                                   std::abs(derivatives[2][0] - k_C) < 5.0;
+            if (!isCorrect && failures++ < 5) {
+                printf("%s: t=%.4f velocity %.4f (expected %.4f) acceleration %.4f (expected %.4f)\n",
+                       name,
+                       time,
+                       derivatives[1][0],
+                       velocity,
+                       derivatives[2][0],
+                       k_C);
+            }
+        }
+
+        printf("%s: %u estimates, %u failures, %llu irregular fits, %llu singular\n",
+               name,
+               checked,
+               failures,
+               (unsigned long long)differentiator.GetIrregularCount(),
+               (unsigned long long)differentiator.GetSingularCount());
+        return checked > 0 && !failures;
+    }
+
+} // namespace
+
+int main() {
+    std::mt19937 random(7);
+    std::uniform_real_distribution<double> jitter(0.0, 1.0);
+
+    // 200 Hz.
+    std::vector<double> regular;
+    for (int i = 0; i < 200; i++) {
+        regular.push_back(i * 0.005);
+    }
+
+    // Intervals between 1 and 10 ms.
+    std::vector<double> irregular;
+    double time = 0.0;
+    for (int i = 0; i < 200; i++) {
+        time += 0.001 + 0.009 * jitter(random);
+        irregular.push_back(time);
+    }
+
+    // A 120 Hz tracker polled every 5 ms: most samples are seen twice, some three times.
+    std::vector<double> repeated;
+    for (int i = 0; i < 200; i++) {
+        repeated.push_back(std::floor(i * 0.005 * 120.0) / 120.0);
+    }
+
+    // Two distinct positions cannot determine a quadratic.
+    savitzky_golay::Weights<7, 2> weights{};
+    bool success = !savitzky_golay::FitWeights<7, 2>({-1.0, -1.0, -1.0, -1.0, 0.0, 0.0, 0.0}, weights) &&
+                   savitzky_golay::FitWeights<7, 2>({-2.0, -2.0, -2.0, -1.0, -1.0, 0.0, 0.0}, weights) &&
+                   !savitzky_golay::FitWeights<7, 2>({0.0, 0.0, 0.0, -1.0, -1.0, -1.0, -1.0}, weights);
+    if (!success) {
+        printf("singular: the fit did not detect a singular system\n");
+    }
+    success = Check("regular", regular) && success;
+    success = Check("irregular", irregular) && success;
+    success = Check("repeated", repeated) && success;
+    return success ? 0 : 1;
+}
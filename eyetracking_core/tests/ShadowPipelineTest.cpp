@@ -0,0 +1,253 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Check the lock-free queue between two threads, then the divergence statistics of ShadowPipeline: against a candidate
+// identical to the production pipeline, and against a median filter compared with a direct computation.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "MedianFilterStage.h"
+#include "ShadowPipeline.h"
+#include "SpscQueue.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    bool g_success = true;
+
+    void Check(const char* name, bool condition) {
+        printf("%s: %s\n", name, condition ? "ok" : "FAILED");
+        g_success &= condition;
+    }
+
+    // Push a sequence from one thread and pop it from another, with a consumer that pauses now and then so that the
+    // queue fills up. Every value must come out in order, and the values missing must be exactly the failed pushes.
+    void TestQueue() {
+        SpscQueue<uint64_t> queue(1000);
+        Check("Queue capacity rounded up", queue.GetCapacity() == 1024);
+
+        uint64_t value;
+        bool isFillCorrect = true;
+        for (uint64_t i = 0; i < queue.GetCapacity(); i++) {
+            isFillCorrect &= queue.TryPush(i);
+        }
+        isFillCorrect &= !queue.TryPush(queue.GetCapacity());
+        for (uint64_t i = 0; i < queue.GetCapacity(); i++) {
+            isFillCorrect &= queue.TryPop(value) && value == i;
+        }
+        isFillCorrect &= !queue.TryPop(value);
+        Check("Queue fills up and drains in order", isFillCorrect);
+
+        const uint64_t count = 2000000;
+        uint64_t dropped = 0;
+        std::thread producer([&] {
+            for (uint64_t i = 0; i < count; i++) {
+                if (!queue.TryPush(i)) {
+                    dropped++;
+                }
+                // Like the update thread, which produces in bursts.
+                if (i % 64 == 0) {
+                    std::this_thread::yield();
+                }
+            }
+            // The end marker must not be dropped.
+            while (!queue.TryPush(count)) {
+                std::this_thread::yield();
+            }
+        });
+
+        uint64_t popped = 0, missing = 0, outOfOrder = 0;
+        uint64_t expected = 0;
+        while (true) {
+            if (!queue.TryPop(value)) {
+                std::this_thread::yield();
+                continue;
+            }
+            if (value < expected) {
+                outOfOrder++;
+            } else {
+                missing += value - expected;
+            }
+            expected = value + 1;
+            if (value == count) {
+                break;
+            }
+            popped++;
+            if (popped % 200000 == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        producer.join();
+
+        printf("Queue: %llu pushed, %llu popped, %llu dropped, %llu missing, %llu out of order\n",
+               (unsigned long long)count,
+               (unsigned long long)popped,
+               (unsigned long long)dropped,
+               (unsigned long long)missing,
+               (unsigned long long)outOfOrder);
+        Check("Queue between threads", !outOfOrder && dropped && missing == dropped && popped + dropped == count);
+    }
+
+    GazeSample MakeInput(std::mt19937& random, double time) {
+        std::normal_distribution<float> noise(0.f, 0.005f);
+        std::uniform_real_distribution<float> uniform(0.f, 1.f);
+
+        EyeTrackerSample sample;
+        sample.timeInSeconds = time;
+        sample.isValid = true;
+        for (int eye = 0; eye < 2; eye++) {
+            sample.gazeTan[eye].x = 0.1f + noise(random);
+            sample.gazeTan[eye].y = -0.05f + noise(random);
+            if (uniform(random) < 0.02f) {
+                // A single-sample spike, that the median removes.
+                sample.gazeTan[eye].x += 0.05f;
+            }
+        }
+        return MakeGazeSample(sample);
+    }
+
+    // Feed the inputs through production and the shadow, in chunks that the shadow thread drains before the next one,
+    // so that nothing is dropped.
+    ShadowPipeline::Statistics Run(GazePipeline& production,
+                                   GazePipeline candidate,
+                                   const std::vector<GazeSample>& inputs,
+                                   std::vector<GazeSample>* outputs) {
+        ShadowPipeline shadow(std::move(candidate));
+        shadow.Start();
+        for (size_t i = 0; i < inputs.size(); i++) {
+            GazeSample sample = inputs[i];
+            production.Process(sample);
+            shadow.Push(inputs[i], sample);
+            if (outputs) {
+                outputs->push_back(sample);
+            }
+            if ((i + 1) % 512 == 0) {
+                while (shadow.GetStatistics().samples < i + 1) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+        }
+        shadow.Stop();
+        return shadow.GetStatistics();
+    }
+
+    void TestIdentical(const std::vector<GazeSample>& inputs) {
+        GazePipeline production;
+        production.AddStage(std::make_unique<MedianFilterStage>(5));
+        GazePipeline candidate;
+        candidate.AddStage(std::make_unique<MedianFilterStage>(5));
+
+        const ShadowPipeline::Statistics statistics = Run(production, std::move(candidate), inputs, nullptr);
+        printf("Identical: %llu samples, %llu dropped, %llu compared, %g max divergence\n",
+               (unsigned long long)statistics.samples,
+               (unsigned long long)statistics.dropped,
+               (unsigned long long)statistics.comparedCount,
+               statistics.maxDivergence);
+        Check("Identical candidate, all compared",
+              statistics.samples == inputs.size() && !statistics.dropped && statistics.comparedCount == inputs.size());
+        Check("Identical candidate, no divergence",
+              statistics.maxDivergence == 0.f && statistics.meanDivergence == 0.f &&
+                  statistics.p99Divergence == ShadowPipeline::k_DivergenceBinWidth);
+        Check("Identical candidate, no mismatch",
+              !statistics.validityMismatches && !statistics.fixationMismatches && !statistics.eventMismatches);
+    }
+
+    // The upper edge of the bin holding the value at the given fraction, as ShadowPipeline computes it.
+    float GetBinEdge(const std::vector<double>& sorted, float fraction) {
+        size_t rank = 1;
+        while (rank < sorted.size() && rank < fraction * sorted.size()) {
+            rank++;
+        }
+        const size_t bin = std::min((size_t)(sorted[rank - 1] / ShadowPipeline::k_DivergenceBinWidth),
+                                    ShadowPipeline::k_DivergenceBins);
+        return (bin + 1) * ShadowPipeline::k_DivergenceBinWidth;
+    }
+
+    void TestMedian(const std::vector<GazeSample>& inputs) {
+        // Production is the raw gaze, the candidate filters it.
+        GazePipeline production;
+        GazePipeline candidate;
+        candidate.AddStage(std::make_unique<MedianFilterStage>(5));
+        const ShadowPipeline::Statistics statistics = Run(production, std::move(candidate), inputs, nullptr);
+
+        MedianFilterStage filter(5);
+        std::vector<double> divergences;
+        double sum = 0.0;
+        for (const GazeSample& input : inputs) {
+            GazeSample filtered = input;
+            filter.Process(filtered);
+            double dot = 0.0;
+            for (int j = 0; j < 3; j++) {
+                dot += (double)filtered.direction[j] * input.direction[j];
+            }
+            const double divergence = std::acos(std::clamp(dot, -1.0, 1.0)) * 180.0 / 3.14159265358979;
+            divergences.push_back(divergence);
+            sum += divergence;
+        }
+        std::sort(divergences.begin(), divergences.end());
+        const float p50 = GetBinEdge(divergences, 0.50f);
+        const float p95 = GetBinEdge(divergences, 0.95f);
+        const double mean = sum / divergences.size();
+
+        printf("Median: %llu compared, mean %.4f (expected %.4f), p50 %.2f (expected %.2f), p95 %.2f (expected %.2f), "
+               "max %.4f (expected %.4f)\n",
+               (unsigned long long)statistics.comparedCount,
+               statistics.meanDivergence,
+               mean,
+               statistics.p50Divergence,
+               p50,
+               statistics.p95Divergence,
+               p95,
+               statistics.maxDivergence,
+               divergences.back());
+        Check("Median candidate, all compared", !statistics.dropped && statistics.comparedCount == inputs.size());
+        Check("Median candidate, divergence",
+              statistics.meanDivergence > 0.f && std::abs(statistics.meanDivergence - mean) < 1e-3 &&
+                  std::abs(statistics.maxDivergence - divergences.back()) < 1e-3 && statistics.maxDivergence < 5.f);
+        Check("Median candidate, percentiles", statistics.p50Divergence == p50 && statistics.p95Divergence == p95);
+        Check("Median candidate, no validity mismatch", !statistics.validityMismatches);
+    }
+
+} // namespace
+
+int main() {
+    TestQueue();
+
+    std::mt19937 random(42);
+    std::vector<GazeSample> inputs;
+    for (int i = 0; i < 20000; i++) {
+        inputs.push_back(MakeInput(random, i * 0.004));
+    }
+    TestIdentical(inputs);
+    TestMedian(inputs);
+
+    printf("%s\n", g_success ? "Passed" : "Failed");
+    return g_success ? 0 : 1;
+}
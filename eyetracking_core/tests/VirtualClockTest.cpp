@@ -0,0 +1,172 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Run the synthetic source and a polling thread on the virtual clock twice, and check that both runs observe exactly
+// the same samples at exactly the same steps. Also check that threads exiting after their last wait do not hold the
+// clock back.
+
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Clock.h"
+#include "EyeTrackerSource.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    constexpr double k_Duration = 10.0;
+    constexpr double k_PollPeriod = 0.003;
+    constexpr double k_PollOffset = 0.0005; // Away from the deadlines of the source, whose threads would run together.
+
+    // FNV-1a.
+    struct Digest {
+        uint64_t value = 14695981039346656037ull;
+        uint64_t count = 0;
+
+        void Add(double data) {
+            uint8_t bytes[sizeof(data)];
+            memcpy(bytes, &data, sizeof(data));
+            for (uint8_t byte : bytes) {
+                value = (value ^ byte) * 1099511628211ull;
+            }
+            count++;
+        }
+    };
+
+    struct Run {
+        Digest delivered;
+        Digest polled;
+        uint32_t lateDeliveries = 0;
+        uint32_t latePolls = 0;
+    };
+
+    Run RunOnce(VirtualClock& clock) {
+        Run run;
+        const double startTime = clock.Now();
+
+        const std::shared_ptr<EyeTrackerSource> source = CreateSyntheticEyeTrackerSource();
+        source->StartCallbacks([&](const EyeTrackerSample& sample) {
+            const double elapsed = clock.Now() - startTime;
+            run.lateDeliveries += std::abs(elapsed - sample.timeInSeconds) > 1e-9;
+            run.delivered.Add(sample.timeInSeconds);
+            run.delivered.Add(sample.gazeTan[0].x);
+            run.delivered.Add(sample.gazeTan[1].y);
+        });
+
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool stop = false;
+        std::thread poller([&] {
+            std::unique_lock lock(mutex);
+            for (uint64_t tick = 0;; tick++) {
+                const double deadline = startTime + tick * k_PollPeriod + k_PollOffset;
+                if (clock.WaitUntil(lock, condition, deadline, [&] { return stop; })) {
+                    break;
+                }
+                run.latePolls += clock.Now() != deadline;
+                EyeTrackerSample sample;
+                if (source->GetLatestSample(sample)) {
+                    run.polled.Add((double)tick);
+                    run.polled.Add(sample.timeInSeconds);
+                }
+            }
+            clock.OnThreadExit();
+        });
+
+        clock.WaitForWaiters(2);
+        clock.AdvanceTo(startTime + k_Duration);
+
+        {
+            std::unique_lock lock(mutex);
+            stop = true;
+        }
+        condition.notify_all();
+        poller.join();
+        source->StopCallbacks();
+        return run;
+    }
+
+    // Threads that sleep once and exit, one after the other.
+    double RunExitingThreads(VirtualClock& clock, size_t count) {
+        const double startTime = clock.Now();
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < count; i++) {
+            threads.emplace_back([&clock, startTime, i] {
+                clock.SleepUntil(startTime + (i + 1) * 0.01);
+                clock.OnThreadExit();
+            });
+        }
+        clock.WaitForWaiters(count);
+
+        const auto start = std::chrono::steady_clock::now();
+        clock.AdvanceTo(startTime + 1.0);
+        const auto duration = std::chrono::steady_clock::now() - start;
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        return std::chrono::duration<double>(duration).count();
+    }
+
+} // namespace
+
+int main() {
+    SetVirtualTime(true);
+    VirtualClock& clock = *GetVirtualClock();
+
+    bool success = true;
+    const Run first = RunOnce(clock);
+    const Run second = RunOnce(clock);
+    for (const Run* run : {&first, &second}) {
+        printf("Delivered %llu samples (digest %016llx), polled %llu (digest %016llx), %u late deliveries, %u late "
+               "polls\n",
+               (unsigned long long)run->delivered.count / 3,
+               (unsigned long long)run->delivered.value,
+               (unsigned long long)run->polled.count / 2,
+               (unsigned long long)run->polled.value,
+               run->lateDeliveries,
+               run->latePolls);
+        success &= run->delivered.count / 3 == (uint64_t)std::llround(k_Duration / 0.005);
+        success &= run->polled.count > 0 && !run->lateDeliveries && !run->latePolls;
+    }
+    if (first.delivered.value != second.delivered.value || first.polled.value != second.polled.value ||
+        first.polled.count != second.polled.count) {
+        printf("The runs differ\n");
+        success = false;
+    }
+
+    // Each of them would otherwise hold the clock for VirtualClock::k_BusyTimeout.
+    const size_t exitingCount = 20;
+    const double exitDuration = RunExitingThreads(clock, exitingCount);
+    printf("%zu exiting threads advanced in %.3f s\n", exitingCount, exitDuration);
+    success &= exitDuration < std::chrono::duration<double>(VirtualClock::k_BusyTimeout).count() * exitingCount / 2;
+
+    printf("%s\n", success ? "Passed" : "Failed");
+    return success ? 0 : 1;
+}
@@ -0,0 +1,168 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Measure the cost per sample of the state walked by the update thread (gaze history and heatmap) when its buffers
+// are carved from an arena on regular pages, from an arena on huge pages, or allocated from the heap among unrelated
+// allocations. Each layout is timed back to back (warm), and with the TLB and caches evicted before every sample by
+// touching one byte per page of a large buffer (cold), like when the update thread wakes up after vrserver did other
+// work. Huge pages need reserved pages (vm.nr_hugepages), otherwise that layout is skipped.
+//
+// Usage: arena_bench [--samples <n>]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Arena.h"
+#include "GazeHeatmap.h"
+#include "GazeHistory.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    // Like the driver (see HmdShimDriver).
+    constexpr size_t k_ArenaSize = 2 * 1024 * 1024;
+    constexpr size_t k_EvictionSize = 64 * 1024 * 1024;
+    constexpr size_t k_PageSize = 4096;
+
+    volatile uint8_t g_sink;
+
+    double Now() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    struct State {
+        explicit State(Arena* arena) : history(arena), heatmap(60.0, arena) {
+        }
+
+        void Add(const GazeSample& sample) {
+            history.Add(sample);
+            heatmap.Add(sample, sample.direction);
+        }
+
+        GazeHistory history;
+        GazeHeatmap heatmap;
+    };
+
+    std::vector<GazeSample> MakeSamples(size_t count) {
+        std::mt19937 random(1234);
+        std::normal_distribution<float> stepDistribution(0.f, 0.002f);
+        std::vector<GazeSample> samples(count);
+        EyeTrackerSample sample;
+        sample.isValid = true;
+        for (size_t i = 0; i < count; i++) {
+            sample.timeInSeconds = i * 0.005;
+            for (auto& gazeTan : sample.gazeTan) {
+                gazeTan.x = std::clamp(gazeTan.x + stepDistribution(random), -0.5f, 0.5f);
+                gazeTan.y = std::clamp(gazeTan.y + stepDistribution(random), -0.5f, 0.5f);
+            }
+            samples[i] = MakeGazeSample(sample);
+        }
+        return samples;
+    }
+
+    // Returns the average time per sample, warm and cold, in nanoseconds.
+    std::pair<double, double> Measure(State& state,
+                                      const std::vector<GazeSample>& samples,
+                                      std::vector<uint8_t>& eviction) {
+        const size_t half = samples.size() / 2;
+        double start = Now();
+        for (size_t i = 0; i < half; i++) {
+            state.Add(samples[i]);
+        }
+        const double warm = (Now() - start) / half;
+
+        // Only a fraction of the samples are measured cold, the eviction is slow.
+        const size_t coldCount = std::min(samples.size() - half, (size_t)20000);
+        double cold = 0.0;
+        uint8_t sum = 0;
+        for (size_t i = 0; i < coldCount; i++) {
+            for (size_t offset = 0; offset < eviction.size(); offset += k_PageSize) {
+                sum += eviction[offset]++;
+            }
+            start = Now();
+            state.Add(samples[half + i]);
+            cold += Now() - start;
+        }
+        g_sink = sum;
+        return {warm * 1e9, cold / coldCount * 1e9};
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t sampleCount = 1000000;
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+        if (argument == "--samples" && i + 1 < argc) {
+            sampleCount = (size_t)std::max(atoll(argv[++i]), 2ll);
+        } else {
+            fprintf(stderr, "Usage: %s [--samples <n>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    const std::vector<GazeSample> samples = MakeSamples(sampleCount);
+    std::vector<uint8_t> eviction(k_EvictionSize, 1);
+
+    printf("layout        used (KB)  warm (ns)  cold (ns)\n");
+
+    {
+        Arena arena(k_ArenaSize, false);
+        State state(&arena);
+        const auto [warm, cold] = Measure(state, samples, eviction);
+        printf("arena         %9zu  %9.1f  %9.1f\n", arena.GetUsed() / 1024, warm, cold);
+    }
+
+    {
+        Arena arena(k_ArenaSize, true);
+        if (arena.HasLargePages()) {
+            State state(&arena);
+            const auto [warm, cold] = Measure(state, samples, eviction);
+            printf("huge pages    %9zu  %9.1f  %9.1f\n", arena.GetUsed() / 1024, warm, cold);
+        } else {
+            printf("huge pages    (not available)\n");
+        }
+    }
+
+    {
+        // Unrelated allocations made before and in between, like in a long running vrserver.
+        std::vector<std::unique_ptr<char[]>> clutter;
+        for (int i = 0; i < 64; i++) {
+            clutter.emplace_back(new char[16 * 1024]);
+        }
+        auto state = std::make_unique<State>(nullptr);
+        for (int i = 0; i < 64; i++) {
+            clutter.emplace_back(new char[16 * 1024]);
+        }
+        const auto [warm, cold] = Measure(*state, samples, eviction);
+        printf("heap          %9s  %9.1f  %9.1f\n", "-", warm, cold);
+    }
+
+    return 0;
+}
@@ -0,0 +1,257 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Measure how fast readers of the shared memory export (see GazeExport.h) get new samples: the latency between the
+// publication of a sample and the reader having it, the samples missed, and the CPU time the readers burn, either
+// blocking on the notification or polling at a fixed interval. With --ring, the readers consume every sample from the
+// ring in batches instead of the latest sample only, and --rate 0 publishes as fast as possible, to measure the
+// throughput of the ring.
+//
+// The writer and the readers run as threads of this process by default, but go through the named shared memory just
+// like separate processes would. Run one instance with --writer and others with --reader to measure across processes
+// (not while the driver exports the gaze).
+//
+// Usage: gaze_export_bench [--readers <n>] [--rate <hz>] [--seconds <s>] [--poll <ms>] [--ring] [--batch <n>]
+//                          [--writer | --reader]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "GazeExportChannel.h"
+#include "Platform.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    struct Options {
+        int readers = 4;
+        double rate = 200.0;       // 0 publishes as fast as possible.
+        double seconds = 10.0;
+        double pollInterval = 0.0; // 0 waits for the notification.
+        bool ring = false;
+        size_t batch = 256;
+        bool writer = true;
+        bool reader = true;
+    };
+
+    // Latencies in 1 us bins up to 10 ms, the last bin collects everything above.
+    struct LatencyHistogram {
+        static constexpr size_t k_Bins = 10000;
+
+        std::vector<uint64_t> bins = std::vector<uint64_t>(k_Bins + 1);
+        uint64_t count = 0;
+        double max = 0.0;
+
+        void Add(double latency) {
+            bins[std::min((size_t)(std::max(latency, 0.0) * 1e6), k_Bins)]++;
+            count++;
+            max = std::max(max, latency);
+        }
+
+        double GetPercentile(double fraction) const {
+            uint64_t cumulated = 0;
+            for (size_t bin = 0; bin < k_Bins; bin++) {
+                cumulated += bins[bin];
+                if (cumulated > fraction * count) {
+                    return (bin + 1) * 1e-6;
+                }
+            }
+            return max;
+        }
+    };
+
+    struct ReaderStatistics {
+        LatencyHistogram latencies;
+        uint64_t missed = 0;
+        double cpuSeconds = 0.0;
+    };
+
+    double Now() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void WriterThread(const Options& options, GazeExportWriter& writer, std::atomic<bool>& done) {
+        const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(options.rate > 0.0 ? 1.0 / options.rate : 0.0));
+        const auto start = std::chrono::steady_clock::now();
+        const auto end = start + std::chrono::duration<double>(options.seconds);
+        auto next = start;
+        GazeSample sample;
+        sample.isValid = true;
+        double publishTime = 0.0;
+        while (true) {
+            if (options.rate > 0.0) {
+                std::this_thread::sleep_until(next);
+                next += period;
+                if (next > end) {
+                    break;
+                }
+            } else if ((writer.GetPublishedCount() & 1023) == 0 && std::chrono::steady_clock::now() > end) {
+                break;
+            }
+
+            sample.timeInSeconds = Now();
+            writer.Publish(sample);
+            publishTime += Now() - sample.timeInSeconds;
+        }
+        done = true;
+
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const uint64_t published = writer.GetPublishedCount();
+        printf("Writer: %llu samples (%.0f per second), %.0f ns per publication, %llu with readers waiting\n",
+               (unsigned long long)published,
+               published / elapsed,
+               published ? publishTime / published * 1e9 : 0.0,
+               (unsigned long long)writer.GetSignaledCount());
+    }
+
+    void ReaderThread(const Options& options, std::atomic<bool>& done, ReaderStatistics& statistics) {
+        GazeExportReader reader;
+        while (!reader.Open()) {
+            if (done) {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        const double cpuStart = GetThreadCpuTime();
+        std::vector<GazeExportSample> samples(options.batch);
+        uint32_t sequence = 0;
+        reader.Read(samples[0], sequence);
+        uint64_t cursor = reader.GetRingHead();
+        while (!done) {
+            if (options.pollInterval > 0.0) {
+                std::this_thread::sleep_for(std::chrono::duration<double>(options.pollInterval));
+            } else if (options.ring ? !reader.WaitRing(cursor, 0.1) : !reader.Wait(sequence, 0.1)) {
+                continue;
+            }
+
+            if (options.ring) {
+                // Catch up in batches.
+                size_t count;
+                while ((count = reader.ReadRing(cursor, samples.data(), samples.size(), statistics.missed))) {
+                    const double now = Now();
+                    for (size_t i = 0; i < count; i++) {
+                        statistics.latencies.Add(now - samples[i].timeInSeconds);
+                    }
+                }
+            } else {
+                uint32_t current;
+                if (!reader.Read(samples[0], current) || current == sequence) {
+                    continue;
+                }
+                statistics.latencies.Add(Now() - samples[0].timeInSeconds);
+                statistics.missed += (current - sequence) / 2 - 1;
+                sequence = current;
+            }
+        }
+        statistics.cpuSeconds = GetThreadCpuTime() - cpuStart;
+    }
+
+    bool ParseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            const std::string argument = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (argument == "--readers" && hasValue) {
+                options.readers = std::max(atoi(argv[++i]), 0);
+            } else if (argument == "--rate" && hasValue) {
+                options.rate = atof(argv[++i]);
+            } else if (argument == "--seconds" && hasValue) {
+                options.seconds = atof(argv[++i]);
+            } else if (argument == "--poll" && hasValue) {
+                options.pollInterval = atof(argv[++i]) / 1000.0;
+            } else if (argument == "--ring") {
+                options.ring = true;
+            } else if (argument == "--batch" && hasValue) {
+                options.batch = (size_t)std::max(atoi(argv[++i]), 1);
+            } else if (argument == "--writer") {
+                options.reader = false;
+            } else if (argument == "--reader") {
+                options.writer = false;
+            } else {
+                return false;
+            }
+        }
+        return options.rate >= 0.0 && options.seconds > 0.0 && (options.writer || options.reader);
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        fprintf(stderr,
+                "Usage: %s [--readers <n>] [--rate <hz>] [--seconds <s>] [--poll <ms>] [--ring] [--batch <n>] "
+                "[--writer | --reader]\n",
+                argv[0]);
+        return 2;
+    }
+
+    GazeExportWriter writer;
+    if (options.writer && !writer.Open()) {
+        fprintf(stderr, "Failed to create the gaze export\n");
+        return 1;
+    }
+
+    std::atomic<bool> done = false;
+    std::vector<ReaderStatistics> statistics(options.reader ? options.readers : 0);
+    std::vector<std::thread> readers;
+    for (ReaderStatistics& readerStatistics : statistics) {
+        readers.emplace_back(ReaderThread, std::cref(options), std::ref(done), std::ref(readerStatistics));
+    }
+    if (options.writer) {
+        WriterThread(options, writer, done);
+    } else {
+        std::this_thread::sleep_for(std::chrono::duration<double>(options.seconds));
+        done = true;
+    }
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    uint64_t totalSamples = 0;
+    for (size_t i = 0; i < statistics.size(); i++) {
+        const ReaderStatistics& reader = statistics[i];
+        printf("Reader %zu: %llu samples, %llu missed, latency p50 %.1f us, p99 %.1f us, max %.1f us, "
+               "CPU %.2f ms/s\n",
+               i,
+               (unsigned long long)reader.latencies.count,
+               (unsigned long long)reader.missed,
+               reader.latencies.GetPercentile(0.5) * 1e6,
+               reader.latencies.GetPercentile(0.99) * 1e6,
+               reader.latencies.max * 1e6,
+               reader.cpuSeconds / options.seconds * 1e3);
+        totalSamples += reader.latencies.count;
+    }
+    if (!statistics.empty()) {
+        printf("Readers: %.0f samples per second in total\n", totalSamples / options.seconds);
+    }
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Measure the lookup of the regions of interest containing the gaze (see gazeRegionsFile), through the grid index of
+// GazeRegionSet against testing every region, and the cost of GazeRegionTracker::Process() per sample, for 10 to
+// 100000 regions scattered over the field of view. Both lookups must find the same hits.
+//
+// Usage: gaze_region_bench [--queries <n>]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "GazeRegionTracker.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    constexpr float k_DegreesToRadians = 3.14159265f / 180.f;
+
+    double Now() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // The more regions, the smaller they are, so that the gaze is in a few of them at a time like with real layouts.
+    std::vector<GazeRegion> MakeRegions(size_t count, std::mt19937& random) {
+        std::uniform_real_distribution<float> yawDistribution(-50.f, 50.f);
+        std::uniform_real_distribution<float> pitchDistribution(-40.f, 40.f);
+        const float maxSize = std::clamp(50.f / std::sqrt((float)count), 0.1f, 5.f);
+        std::uniform_real_distribution<float> sizeDistribution(maxSize / 10.f, maxSize);
+        std::vector<GazeRegion> regions(count);
+        for (size_t i = 0; i < count; i++) {
+            GazeRegion& region = regions[i];
+            region.id = (uint32_t)i;
+            region.shape = i % 2 ? GazeRegion::Circle : GazeRegion::Rectangle;
+            region.yaw = yawDistribution(random);
+            region.pitch = pitchDistribution(random);
+            region.halfWidth = sizeDistribution(random);
+            region.halfHeight = sizeDistribution(random);
+        }
+        return regions;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t queries = 1000000;
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+        if (argument == "--queries" && i + 1 < argc) {
+            queries = (size_t)std::max(atoll(argv[++i]), 1ll);
+        } else {
+            fprintf(stderr, "Usage: %s [--queries <n>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> yawDistribution(-55.f, 55.f);
+    std::uniform_real_distribution<float> pitchDistribution(-45.f, 45.f);
+    std::vector<std::pair<float, float>> points(queries);
+    for (auto& point : points) {
+        point = {yawDistribution(random), pitchDistribution(random)};
+    }
+
+    printf("regions  grid      build (ms)  grid (ns)  linear (ns)  tracker (ns)  hits/query\n");
+    bool success = true;
+    for (size_t count : {10, 100, 1000, 10000, 100000}) {
+        const std::vector<GazeRegion> regions = MakeRegions(count, random);
+
+        double start = Now();
+        const GazeRegionSet set(regions);
+        const double buildTime = Now() - start;
+
+        uint64_t gridHits = 0;
+        start = Now();
+        for (const auto& [yaw, pitch] : points) {
+            set.ForEachHit(yaw, pitch, [&](uint32_t) { gridHits++; });
+        }
+        const double gridTime = (Now() - start) / points.size();
+
+        // The linear scan is slow with many regions: only run it on enough points to be measured.
+        const size_t linearQueries = std::min(points.size(), std::max((size_t)1000, (size_t)20000000 / count));
+        uint64_t linearHits = 0, gridHitsSubset = 0;
+        start = Now();
+        for (size_t i = 0; i < linearQueries; i++) {
+            for (const GazeRegion& region : regions) {
+                linearHits += GazeRegionSet::Contains(region, points[i].first, points[i].second);
+            }
+        }
+        const double linearTime = (Now() - start) / linearQueries;
+        for (size_t i = 0; i < linearQueries; i++) {
+            set.ForEachHit(points[i].first, points[i].second, [&](uint32_t) { gridHitsSubset++; });
+        }
+        if (linearHits != gridHitsSubset) {
+            printf("Mismatch with %zu regions: %llu hits through the grid, %llu by testing every region\n",
+                   count,
+                   (unsigned long long)gridHitsSubset,
+                   (unsigned long long)linearHits);
+            success = false;
+        }
+
+        GazeRegionTracker tracker;
+        tracker.SetRegions(regions);
+        GazeSample sample;
+        sample.isValid = true;
+        start = Now();
+        for (size_t i = 0; i < points.size(); i++) {
+            sample.timeInSeconds = i * 0.005;
+            sample.yaw = points[i].first * k_DegreesToRadians;
+            sample.pitch = points[i].second * k_DegreesToRadians;
+            tracker.Process(sample);
+        }
+        const double trackerTime = (Now() - start) / points.size();
+
+        printf("%7zu  %4ux%-4u  %10.2f  %9.1f  %11.1f  %12.1f  %10.2f\n",
+               count,
+               set.GetColumnCount(),
+               set.GetRowCount(),
+               buildTime * 1e3,
+               gridTime * 1e9,
+               linearTime * 1e9,
+               trackerTime * 1e9,
+               (double)gridHits / points.size());
+    }
+    return success ? 0 : 1;
+}
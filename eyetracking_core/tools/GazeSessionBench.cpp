@@ -0,0 +1,200 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Compare the queries of the columnar session store (see GazeSessionStore) with the same queries over an array of
+// rows shaped like the samples of the tracker (time, per-eye gaze tangents and a validity flag), for a session in
+// cache (100000 samples) and one that is not (1000000 samples by default), at 200 Hz with 5% of invalid samples. Both
+// must agree on the results.
+//
+// Usage: gaze_session_bench [--samples <n>]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "GazeSessionStore.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    constexpr int k_Repeats = 20;
+    constexpr float k_ConeYaw = 0.1f;
+    constexpr float k_ConePitch = -0.05f;
+    constexpr float k_ConeRadius = 0.2f;
+
+    struct Row {
+        double timeInSeconds;
+        float gazeTan[2][2]; // [eye][x/y]
+        uint32_t isValid;
+    };
+
+    double Now() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void MeanGazeTan(const std::vector<Row>& rows, float (&mean)[2][2]) {
+        double sums[2][2]{};
+        uint64_t validCount = 0;
+        for (const Row& row : rows) {
+            if (row.isValid) {
+                for (int eye = 0; eye < 2; eye++) {
+                    sums[eye][0] += row.gazeTan[eye][0];
+                    sums[eye][1] += row.gazeTan[eye][1];
+                }
+                validCount++;
+            }
+        }
+        for (int eye = 0; eye < 2; eye++) {
+            mean[eye][0] = validCount ? (float)(sums[eye][0] / validCount) : 0.f;
+            mean[eye][1] = validCount ? (float)(sums[eye][1] / validCount) : 0.f;
+        }
+    }
+
+    double TimeInCone(const std::vector<Row>& rows) {
+        const float axis[3] = {std::sin(k_ConeYaw) * std::cos(k_ConePitch),
+                               std::sin(k_ConePitch),
+                               -std::cos(k_ConeYaw) * std::cos(k_ConePitch)};
+        const float cosRadius = std::cos(k_ConeRadius);
+        double total = 0.0;
+        for (size_t i = 0; i + 1 < rows.size(); i++) {
+            const Row& row = rows[i];
+            if (!row.isValid) {
+                continue;
+            }
+            const float gazeX = (row.gazeTan[0][0] + row.gazeTan[1][0]) * 0.5f;
+            const float gazeY = (row.gazeTan[0][1] + row.gazeTan[1][1]) * 0.5f;
+            const float scaleX = std::sqrt(1.f + gazeX * gazeX);
+            const float scaleY = std::sqrt(1.f + gazeY * gazeY);
+            const float dot = ((gazeX * axis[0] - axis[2]) / scaleX + gazeY * axis[1]) / scaleY;
+            if (dot >= cosRadius) {
+                const double duration = rows[i + 1].timeInSeconds - row.timeInSeconds;
+                total += std::min(duration, (double)GazeSessionStore::k_MaxSampleGap);
+            }
+        }
+        return total;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t sampleCount = 1000000;
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+        if (argument == "--samples" && i + 1 < argc) {
+            sampleCount = (size_t)std::max(atoll(argv[++i]), 2ll);
+        } else {
+            fprintf(stderr, "Usage: %s [--samples <n>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    // Sizes in bytes per sample, times in nanoseconds per sample.
+    printf("samples  row size  column size  row mean  column mean  row cone  column cone\n");
+    bool success = true;
+    for (size_t count : {std::min(sampleCount, (size_t)100000), sampleCount}) {
+        std::mt19937 random(1234);
+        std::normal_distribution<float> stepDistribution(0.f, 0.01f);
+        std::uniform_real_distribution<float> validDistribution(0.f, 1.f);
+
+        std::vector<Row> rows(count);
+        GazeSessionStore store(count / GazeSessionChunk::k_Samples + 1);
+        EyeTrackerSample sample;
+        for (size_t i = 0; i < count; i++) {
+            sample.timeInSeconds = i * 0.005;
+            sample.isValid = validDistribution(random) >= 0.05f;
+            for (auto& gazeTan : sample.gazeTan) {
+                gazeTan.x = std::clamp(gazeTan.x + stepDistribution(random), -0.5f, 0.5f);
+                gazeTan.y = std::clamp(gazeTan.y + stepDistribution(random), -0.5f, 0.5f);
+            }
+            store.Add(MakeGazeSample(sample));
+
+            Row& row = rows[i];
+            row.timeInSeconds = sample.timeInSeconds;
+            for (int eye = 0; eye < 2; eye++) {
+                row.gazeTan[eye][0] = sample.isValid ? sample.gazeTan[eye].x : 0.f;
+                row.gazeTan[eye][1] = sample.isValid ? sample.gazeTan[eye].y : 0.f;
+            }
+            row.isValid = sample.isValid;
+        }
+        const double endTime = count * 0.005;
+
+        float rowMean[2][2];
+        double start = Now();
+        for (int repeat = 0; repeat < k_Repeats; repeat++) {
+            MeanGazeTan(rows, rowMean);
+        }
+        const double rowMeanTime = (Now() - start) / k_Repeats / count;
+
+        GazeSessionSummary summary;
+        start = Now();
+        for (int repeat = 0; repeat < k_Repeats; repeat++) {
+            summary = store.Summarize(0.0, endTime);
+        }
+        const double columnMeanTime = (Now() - start) / k_Repeats / count;
+
+        double rowCone = 0.0;
+        start = Now();
+        for (int repeat = 0; repeat < k_Repeats; repeat++) {
+            rowCone = TimeInCone(rows);
+        }
+        const double rowConeTime = (Now() - start) / k_Repeats / count;
+
+        double columnCone = 0.0;
+        start = Now();
+        for (int repeat = 0; repeat < k_Repeats; repeat++) {
+            columnCone = store.GetTimeInCone(0.0, endTime, k_ConeYaw, k_ConePitch, k_ConeRadius);
+        }
+        const double columnConeTime = (Now() - start) / k_Repeats / count;
+
+        for (int eye = 0; eye < 2; eye++) {
+            if (std::abs(summary.meanGazeTan[eye].x - rowMean[eye][0]) > 1e-5f ||
+                std::abs(summary.meanGazeTan[eye].y - rowMean[eye][1]) > 1e-5f) {
+                printf("Mismatch of the mean gaze of eye %d with %zu samples\n", eye, count);
+                success = false;
+            }
+        }
+        // The columns store float time offsets within each chunk.
+        if (std::abs(columnCone - rowCone) > 1e-3 * std::max(rowCone, 1.0)) {
+            printf("Mismatch of the time in cone with %zu samples: %.4f s in rows, %.4f s in columns\n",
+                   count,
+                   rowCone,
+                   columnCone);
+            success = false;
+        }
+
+        printf("%7zu  %8zu  %11.1f  %8.2f  %11.2f  %8.2f  %11.2f\n",
+               count,
+               sizeof(Row),
+               (double)sizeof(GazeSessionChunk) / GazeSessionChunk::k_Samples,
+               rowMeanTime * 1e9,
+               columnMeanTime * 1e9,
+               rowConeTime * 1e9,
+               columnConeTime * 1e9);
+    }
+    return success ? 0 : 1;
+}
@@ -0,0 +1,410 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// Accelerated soak test: runs the update loop of the driver (see GazeUpdateLoop) for a day of virtual time (see
+// VirtualClock), in a few minutes, with every optional feature that needs no external file enabled. A mock host stands
+// in for vrserver: every hour, it activates the loop for 50 minutes, then deactivates it and stays in standby for 10
+// minutes. The eye tracker is a stub driven sample by sample at 120 Hz, pushing its samples during the even hours and
+// polled during the odd ones. Every 7 minutes it loses the eyes for 1.5 seconds, then stops responding for another 1.5
+// seconds, before recovering. The heatmap is written to gaze_soak_heatmap-*.pfm in the working directory.
+//
+// At the end of every active period, the resident memory, threads and file descriptors of the process and the depth
+// of the session store are sampled. It fails when one of them keeps growing, using the same rule as the HealthMonitor
+// of the driver over the hours of either mode: the lowest value of the most recent quarter exceeds the highest value
+// of the oldest quarter by more than a tolerance (this needs at least 10 hours). It also fails when an hour does not
+// process exactly the same samples as the others, when a sample is dropped or processed at a different time than its
+// timestamp (later than the polling period when polled), or when the gaze is not valid again after the last failure of
+// the hour. The process metrics are only available on Linux. The loop logs the startup timeline up to the first valid
+// gaze.
+//
+// Usage: gaze_soak [--hours <n>]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+#include "Clock.h"
+#include "EyeTrackerSource.h"
+#include "GazeUpdateLoop.h"
+#include "StartupTimeline.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    constexpr int k_ActiveMinutes = 50;
+    constexpr int k_MinutesPerHour = 60;
+    constexpr double k_SampleRate = 120.0;
+    constexpr int k_FailureInterval = 7;      // Minutes.
+    constexpr double k_ErrorDuration = 1.5;   // Seconds of invalid samples.
+    constexpr double k_StallDuration = 1.5;   // Seconds without samples, following the errors.
+    constexpr double k_MaxClockOffset = 1e-6; // Seconds.
+
+    double Now() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    enum Metric { ResidentMemory, ThreadCount, FileCount, StoredSamples, MetricCount };
+
+    struct MetricInfo {
+        const char* name;
+        double tolerance;
+    };
+
+    constexpr MetricInfo k_Metrics[MetricCount] = {
+        {"Resident memory (KB)", 4096},
+        {"Threads", 0},
+        {"File descriptors", 0},
+        {"Stored samples", 0},
+    };
+
+#ifdef __linux__
+    size_t CountEntries(const char* path) {
+        DIR* const directory = opendir(path);
+        if (!directory) {
+            return 0;
+        }
+        size_t count = 0;
+        while (const dirent* entry = readdir(directory)) {
+            count += entry->d_name[0] != '.';
+        }
+        closedir(directory);
+        return count;
+    }
+#endif
+
+    void SampleProcess(double (&values)[MetricCount]) {
+#ifdef __linux__
+        long pages = 0, residentPages = 0;
+        if (FILE* file = fopen("/proc/self/statm", "r")) {
+            if (fscanf(file, "%ld %ld", &pages, &residentPages) != 2) {
+                residentPages = 0;
+            }
+            fclose(file);
+        }
+        values[ResidentMemory] = residentPages * (sysconf(_SC_PAGESIZE) / 1024.0);
+        values[ThreadCount] = (double)CountEntries("/proc/self/task");
+        // Minus the descriptor of the directory being listed.
+        values[FileCount] = (double)CountEntries("/proc/self/fd") - 1;
+#else
+        values[ResidentMemory] = values[ThreadCount] = values[FileCount] = 0;
+#endif
+    }
+
+    // Parse a "<key>=<value>" field of the response to a debug request.
+    double GetField(const std::string& response, const char* key) {
+        const size_t position = response.find(std::string(key) + "=");
+        return position != std::string::npos ? atof(response.c_str() + position + strlen(key) + 1) : -1.0;
+    }
+
+    // A tracker that fails and recovers every k_FailureInterval. The soak hands it each sample, at the time of the
+    // sample, and chooses whether it pushes them.
+    class FlakyEyeTrackerSource final : public PushEyeTrackerSource {
+      public:
+        const char* GetName() const override {
+            return "flaky";
+        }
+
+        bool GetLatestSample(EyeTrackerSample& sample) override {
+            std::unique_lock lock(m_mutex);
+            sample = m_latestSample;
+            return sample.isValid;
+        }
+
+        bool SupportsCallback() const override {
+            return m_isPushed;
+        }
+
+        // Like a new session of the tracker: the timestamps and the failures start over, and nothing is returned
+        // before the first sample.
+        void Restart(bool isPushed) {
+            std::unique_lock lock(m_mutex);
+            m_isPushed = isPushed;
+            m_latestSample = {};
+        }
+
+        // Returns false when the tracker is not responding.
+        bool Tick(double time, uint64_t index) {
+            const double failureTime = std::fmod(time, k_FailureInterval * 60.0);
+            if (failureTime >= k_ErrorDuration && failureTime < k_ErrorDuration + k_StallDuration) {
+                return false;
+            }
+
+            // Fixations on a few targets, with a little jitter.
+            static constexpr EyeGazeTan k_Targets[] = {{-0.2f, 0.1f}, {0.15f, -0.05f}, {0.05f, 0.2f}, {-0.1f, -0.15f}};
+            const EyeGazeTan& target = k_Targets[(index / 60) % std::size(k_Targets)];
+            const float jitter = 0.002f * std::sin(index * 1.7f);
+
+            EyeTrackerSample sample;
+            sample.timeInSeconds = time;
+            sample.isValid = failureTime >= k_ErrorDuration;
+            for (int eye = 0; eye < 2; eye++) {
+                sample.gazeTan[eye] = {target.x + jitter, target.y - jitter};
+            }
+            {
+                std::unique_lock lock(m_mutex);
+                m_latestSample = sample;
+            }
+            Deliver(sample);
+            return true;
+        }
+
+      private:
+        std::mutex m_mutex;
+        EyeTrackerSample m_latestSample;
+        bool m_isPushed = true;
+    };
+
+    // What vrserver and the driver around the loop would do.
+    class MockHost final : public GazeUpdateLoop::Host {
+      public:
+        void Publish([[maybe_unused]] bool isValid, [[maybe_unused]] const float direction[3]) override {
+        }
+
+        // Looking straight ahead.
+        bool ProcessWorldGaze(const GazeSample& gaze, bool, float worldDirection[3]) override {
+            std::copy_n(gaze.direction, 3, worldDirection);
+            return true;
+        }
+
+        void OnSample(double timeInSeconds) override {
+            {
+                std::unique_lock lock(m_mutex);
+                const double offset = GetClock().Now() - m_activationTime - timeInSeconds;
+                const double maxOffset = k_MaxClockOffset + (m_isPushed ? 0.0 : GazeUpdateLoop::k_PollPeriod);
+                if (offset < -k_MaxClockOffset || offset > maxOffset) {
+                    m_lateCount++;
+                }
+                m_sampleCount++;
+            }
+            m_sampleCondition.notify_all();
+        }
+
+        void OnDroppedSample() override {
+            std::unique_lock lock(m_mutex);
+            m_droppedCount++;
+        }
+
+        void Activate(double time, bool isPushed) {
+            std::unique_lock lock(m_mutex);
+            m_activationTime = time;
+            m_isPushed = isPushed;
+        }
+
+        // A pushed sample wakes up the loop without the virtual clock knowing: wait for the loop to take it before
+        // moving the time forward, so that it is processed at its timestamp.
+        void WaitForSamples(uint64_t count) {
+            std::unique_lock lock(m_mutex);
+            m_sampleCondition.wait(lock, [&] { return m_sampleCount >= count; });
+        }
+
+        uint64_t GetSampleCount() {
+            std::unique_lock lock(m_mutex);
+            return m_sampleCount;
+        }
+
+        uint64_t GetDroppedCount() {
+            std::unique_lock lock(m_mutex);
+            return m_droppedCount;
+        }
+
+        uint64_t GetLateCount() {
+            std::unique_lock lock(m_mutex);
+            return m_lateCount;
+        }
+
+      private:
+        std::mutex m_mutex;
+        std::condition_variable m_sampleCondition;
+        double m_activationTime = 0.0;
+        bool m_isPushed = true;
+        uint64_t m_sampleCount = 0;
+        uint64_t m_droppedCount = 0;
+        uint64_t m_lateCount = 0;
+    };
+
+    GazeSettings GetSoakSettings() {
+        GazeSettings settings;
+        settings.deadbandAngle = 0.5f;
+        settings.medianFilterWindow = 3;
+        settings.gazeDerivatives = true;
+        settings.gazeEvents = true;
+        settings.fixationDetector = true;
+        settings.heatmapFile = "gaze_soak_heatmap";
+        settings.heatmapHalfLife = 60.f;
+        settings.sessionStoreMinutes = 10;
+        settings.shadowPipeline = "medianFilterWindow=5";
+        settings.gazeExport = true;
+        settings.demandDrivenRate = true;
+        return settings;
+    }
+
+    // See HealthMonitor::CheckDrift() in the driver.
+    bool IsGrowing(const std::vector<double>& series, double tolerance) {
+        const size_t quarter = series.size() / 4;
+        if (!quarter) {
+            return false;
+        }
+        const double oldestMax = *std::max_element(series.begin(), series.begin() + quarter);
+        const double recentMin = *std::min_element(series.end() - quarter, series.end());
+        return recentMin - oldestMax > tolerance;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int hours = 24;
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+        if (argument == "--hours" && i + 1 < argc) {
+            hours = std::max(atoi(argv[++i]), 1);
+        } else {
+            fprintf(stderr, "Usage: %s [--hours <n>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    InitializeStartupTimeline();
+    SetVirtualTime(true);
+    VirtualClock& clock = *GetVirtualClock();
+    const auto source = std::make_shared<FlakyEyeTrackerSource>();
+    MockHost host;
+    GazeUpdateLoop loop(source, host, GetSoakSettings());
+
+    // The first hour of each mode warms up the allocator and the caches: only the following ones are checked. The
+    // modes are checked separately, since the timeouts of the pushed samples are stored too. Indexed by isPushed.
+    std::vector<double> series[2][MetricCount];
+    std::vector<uint64_t> hourlyCounts;
+    bool success = true;
+
+    printf("hour  source  memory (KB)  threads  files  stored  samples  real (s)\n");
+    const double start = Now();
+    for (int hour = 0; hour < hours; hour++) {
+        const bool isPushed = hour % 2 == 0;
+        const double activationTime = clock.Now();
+        const uint64_t processedBefore = host.GetSampleCount();
+
+        // Activate.
+        source->Restart(isPushed);
+        host.Activate(activationTime, isPushed);
+        loop.Start();
+        std::thread thread([&] { loop.Run(); });
+        // The loop and the shadow pipeline.
+        clock.WaitForWaiters(2);
+
+        uint64_t delivered = 0;
+        for (uint64_t index = 1;; index++) {
+            const double time = index / k_SampleRate;
+            if (time >= k_ActiveMinutes * 60.0) {
+                break;
+            }
+            clock.AdvanceTo(activationTime + time);
+            if (source->Tick(time, index) && isPushed) {
+                host.WaitForSamples(processedBefore + ++delivered);
+                // Then for the loop to wait for the next one, so that its timeout is the same at every run. The shadow
+                // pipeline waits too.
+                clock.WaitForWaiters(2);
+            }
+        }
+        clock.AdvanceTo(activationTime + k_ActiveMinutes * 60.0);
+
+        double values[MetricCount]{};
+        SampleProcess(values);
+        std::string response;
+        loop.HandleDebugRequest("session_summary", response);
+        values[StoredSamples] = GetField(response, "samples");
+        loop.HandleDebugRequest("gaze_history 1", response);
+        if (GetField(response, "valid") != 1.0) {
+            printf("The gaze did not recover from the tracking failures during hour %d: %s\n", hour, response.c_str());
+            success = false;
+        }
+
+        // Deactivate, and stay in standby for the rest of the hour.
+        if (loop.Stop()) {
+            thread.join();
+        }
+        clock.AdvanceTo(activationTime + k_MinutesPerHour * 60.0);
+
+        if (hour > 1) {
+            for (int metric = 0; metric < MetricCount; metric++) {
+                series[isPushed][metric].push_back(values[metric]);
+            }
+        }
+        hourlyCounts.push_back(host.GetSampleCount() - processedBefore);
+
+        printf("%4d  %6s  %11.0f  %7.0f  %5.0f  %6.0f  %7llu  %8.1f\n",
+               hour,
+               isPushed ? "pushed" : "polled",
+               values[ResidentMemory],
+               values[ThreadCount],
+               values[FileCount],
+               values[StoredSamples],
+               (unsigned long long)hourlyCounts.back(),
+               Now() - start);
+        fflush(stdout);
+    }
+
+    for (const bool isPushed : {true, false}) {
+        for (int metric = 0; metric < MetricCount; metric++) {
+            const std::vector<double>& values = series[isPushed][metric];
+            if (IsGrowing(values, k_Metrics[metric].tolerance)) {
+                printf("%s keeps growing with the samples %s: %.0f -> %.0f\n",
+                       k_Metrics[metric].name,
+                       isPushed ? "pushed" : "polled",
+                       values.front(),
+                       values.back());
+                success = false;
+            }
+        }
+    }
+    if (std::any_of(hourlyCounts.begin(), hourlyCounts.end(), [&](uint64_t count) {
+            return count != hourlyCounts.front();
+        })) {
+        printf("The number of samples processed per hour changed\n");
+        success = false;
+    }
+    if (host.GetDroppedCount()) {
+        printf("%llu pushed samples were dropped\n", (unsigned long long)host.GetDroppedCount());
+        success = false;
+    }
+    if (host.GetLateCount()) {
+        printf("%llu samples were processed away from their timestamp\n", (unsigned long long)host.GetLateCount());
+        success = false;
+    }
+
+    printf("%s after %d hours of virtual time\n", success ? "Passed" : "Failed", hours);
+    return success ? 0 : 1;
+}
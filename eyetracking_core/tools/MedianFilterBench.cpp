@@ -0,0 +1,130 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Measure the cost of the running median for the windows allowed by medianFilterWindow (3 to 15), against copying
+// the window and selecting the median with std::nth_element, and the cost of the whole MedianFilterStage per sample.
+//
+// Usage: median_filter_bench [--samples <n>]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "MedianFilterStage.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    double Now() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Keeps the compiler from discarding the results.
+    volatile float g_sink;
+
+    double BenchRunningMedian(const std::vector<float>& values, size_t window) {
+        RunningMedian median(window);
+        float sum = 0.f;
+        const double start = Now();
+        for (float value : values) {
+            sum += median.Update(value);
+        }
+        const double elapsed = Now() - start;
+        g_sink = sum;
+        return elapsed / values.size();
+    }
+
+    double BenchNthElement(const std::vector<float>& values, size_t window) {
+        std::vector<float> ring(window), scratch(window);
+        size_t head = 0, size = 0;
+        float sum = 0.f;
+        const double start = Now();
+        for (float value : values) {
+            ring[head] = value;
+            head = (head + 1) % window;
+            size = std::min(size + 1, window);
+            std::copy(ring.begin(), ring.begin() + size, scratch.begin());
+            std::nth_element(scratch.begin(), scratch.begin() + size / 2, scratch.begin() + size);
+            sum += scratch[size / 2];
+        }
+        const double elapsed = Now() - start;
+        g_sink = sum;
+        return elapsed / values.size();
+    }
+
+    double BenchStage(const std::vector<float>& values, size_t window) {
+        MedianFilterStage stage(window);
+        GazeSample sample;
+        sample.isValid = true;
+        float sum = 0.f;
+        const double start = Now();
+        for (size_t i = 0; i + 1 < values.size(); i += 2) {
+            GazeSample current = sample;
+            current.gazeTan[0] = current.gazeTan[1] = {values[i], values[i + 1]};
+            stage.Process(current);
+            sum += current.yaw;
+        }
+        const double elapsed = Now() - start;
+        g_sink = sum;
+        return elapsed / (values.size() / 2);
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t samples = 10000000;
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+        if (argument == "--samples" && i + 1 < argc) {
+            samples = (size_t)std::max(atoll(argv[++i]), 2ll);
+        } else {
+            fprintf(stderr, "Usage: %s [--samples <n>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    // Gaze-like values: slow drift with noise and occasional spikes.
+    std::mt19937 random(1234);
+    std::normal_distribution<float> noise(0.f, 0.002f);
+    std::uniform_real_distribution<float> uniform(0.f, 1.f);
+    std::vector<float> values(samples);
+    float drift = 0.f;
+    for (float& value : values) {
+        drift += noise(random) * 0.1f;
+        value = drift + noise(random) + (uniform(random) < 0.01f ? 0.2f : 0.f);
+    }
+
+    printf("window  running (ns)  nth_element (ns)  stage (ns/sample)\n");
+    for (size_t window = 3; window <= RunningMedian::k_MaxWindow; window += 2) {
+        printf("%6zu  %12.2f  %16.2f  %17.2f\n",
+               window,
+               BenchRunningMedian(values, window) * 1e9,
+               BenchNthElement(values, window) * 1e9,
+               BenchStage(values, window) * 1e9);
+    }
+    return 0;
+}
@@ -0,0 +1,600 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Compare two recordings of the same session (eg: before and after a firmware update, or a pipeline change):
+// latency shift, per-sample angular differences and dropouts.
+//
+// Usage: recording_diff <a.bin> <b.bin> [--tolerance <ms>] [--max-lag <ms>] [--threads <n>] [--no-align]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "GazeRecording.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    constexpr float k_RadiansToDegrees = 180.f / 3.14159265f;
+
+    struct Options {
+        std::string paths[2];
+        double tolerance = 0.0025;
+        double maxLag = 0.1;
+        unsigned threads = std::max(std::thread::hardware_concurrency(), 1u);
+        bool align = true;
+    };
+
+    struct Recording {
+        const GazeRecordingRecord* records;
+        size_t count;
+    };
+
+    bool IsValid(const GazeRecordingRecord& record) {
+        return record.flags & GazeRecordingFlags_Valid;
+    }
+
+    // Angles of the gaze, combining both eyes like UpdateGazeAngles() does.
+    float GetYaw(const GazeRecordingRecord& record) {
+        return atanf((record.gazeTan[0][0] + record.gazeTan[1][0]) / 2.f);
+    }
+
+    float GetPitch(const GazeRecordingRecord& record) {
+        return atanf((record.gazeTan[0][1] + record.gazeTan[1][1]) / 2.f);
+    }
+
+    // Unit vector of the gaze of one eye (0, 1) or both (2), like UpdateGazeDirection() does, but without the
+    // trigonometry: sin(atan(t)) = t / sqrt(1 + t^2) and cos(atan(t)) = 1 / sqrt(1 + t^2).
+    void GetDirection(const GazeRecordingRecord& record, int eye, float direction[3]) {
+        const float x = eye < 2 ? record.gazeTan[eye][0] : (record.gazeTan[0][0] + record.gazeTan[1][0]) / 2.f;
+        const float y = eye < 2 ? record.gazeTan[eye][1] : (record.gazeTan[0][1] + record.gazeTan[1][1]) / 2.f;
+        const float cosYaw = 1.f / std::sqrt(1.f + x * x);
+        const float cosPitch = 1.f / std::sqrt(1.f + y * y);
+        direction[0] = x * cosYaw * cosPitch;
+        direction[1] = y * cosPitch;
+        direction[2] = -cosYaw * cosPitch;
+    }
+
+    // Degrees, accurate for small angles unlike acos().
+    float GetAngle(const float a[3], const float b[3]) {
+        const float cross[3] = {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+        const float sine = std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+        const float cosine = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+        return atan2f(sine, cosine) * k_RadiansToDegrees;
+    }
+
+    // Distribution of angular differences, in bins of 0.01 degree up to 30 degrees. Partial histograms from each
+    // thread are merged at the end.
+    struct Histogram {
+        static constexpr float k_BinSize = 0.01f;
+        static constexpr size_t k_BinCount = 3000;
+
+        std::vector<uint64_t> bins = std::vector<uint64_t>(k_BinCount + 1);
+        uint64_t count = 0;
+        double sum = 0.0;
+        float max = 0.f;
+
+        void Add(float value) {
+            bins[std::min((size_t)(value / k_BinSize), k_BinCount)]++;
+            count++;
+            sum += value;
+            max = std::max(max, value);
+        }
+
+        void Merge(const Histogram& other) {
+            for (size_t i = 0; i < bins.size(); i++) {
+                bins[i] += other.bins[i];
+            }
+            count += other.count;
+            sum += other.sum;
+            max = std::max(max, other.max);
+        }
+
+        // Upper edge of the bin holding the percentile.
+        float GetPercentile(double percentile) const {
+            const uint64_t rank = (uint64_t)std::ceil(percentile / 100.0 * count);
+            uint64_t seen = 0;
+            for (size_t i = 0; i < k_BinCount; i++) {
+                seen += bins[i];
+                if (seen >= rank) {
+                    return (i + 1) * k_BinSize;
+                }
+            }
+            return max;
+        }
+    };
+
+    struct JoinStatistics {
+        uint64_t matched = 0;
+        uint64_t unmatched = 0;
+        uint64_t bothValid = 0;
+        uint64_t onlyThisValid = 0;
+        uint64_t onlyOtherValid = 0;
+        uint64_t bothInvalid = 0;
+        Histogram angles[3]; // Left, right, combined.
+
+        void Merge(const JoinStatistics& other) {
+            matched += other.matched;
+            unmatched += other.unmatched;
+            bothValid += other.bothValid;
+            onlyThisValid += other.onlyThisValid;
+            onlyOtherValid += other.onlyOtherValid;
+            bothInvalid += other.bothInvalid;
+            for (int eye = 0; eye < 3; eye++) {
+                angles[eye].Merge(other.angles[eye]);
+            }
+        }
+    };
+
+    struct DropoutStatistics {
+        uint64_t invalid = 0;
+        uint64_t episodes = 0;
+        double invalidTime = 0.0;
+
+        void Merge(const DropoutStatistics& other) {
+            invalid += other.invalid;
+            episodes += other.episodes;
+            invalidTime += other.invalidTime;
+        }
+    };
+
+    // Run work(index) for every index in [0, count) over the given number of threads.
+    template <typename Work>
+    void ParallelFor(size_t count, unsigned threads, Work&& work) {
+        std::atomic<size_t> next = 0;
+        std::vector<std::thread> workers;
+        for (unsigned i = 0; i < std::min<size_t>(threads, count); i++) {
+            workers.emplace_back([&] {
+                for (size_t index = next++; index < count; index = next++) {
+                    work(index);
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    // Split [0, count) into ranges of roughly equal size, several per thread so that they balance out.
+    std::vector<std::pair<size_t, size_t>> MakeRanges(size_t count, unsigned threads) {
+        const size_t rangeCount = std::max<size_t>(std::min<size_t>(count / 65536, threads * 4), 1);
+        std::vector<std::pair<size_t, size_t>> ranges;
+        for (size_t i = 0; i < rangeCount; i++) {
+            ranges.emplace_back(count * i / rangeCount, count * (i + 1) / rangeCount);
+        }
+        return ranges;
+    }
+
+    // Merge-join the samples [first, last) of one recording with the other recording, whose timestamps are moved back
+    // by shift, pairing each sample with the nearest sample of the other within the tolerance. Without compare, only
+    // the samples without a match are counted.
+    JoinStatistics Join(const Recording& self,
+                        size_t first,
+                        size_t last,
+                        const Recording& other,
+                        double shift,
+                        double tolerance,
+                        bool compare) {
+        JoinStatistics statistics;
+        if (first >= last || !other.count) {
+            statistics.unmatched = last - first;
+            return statistics;
+        }
+
+        // Position the cursor on the other recording once, then only move forward.
+        const GazeRecordingRecord* const otherEnd = other.records + other.count;
+        const double startTime = self.records[first].timeInSeconds + shift;
+        size_t cursor = std::lower_bound(other.records,
+                                         otherEnd,
+                                         startTime,
+                                         [](const GazeRecordingRecord& record, double time) {
+                                             return record.timeInSeconds < time;
+                                         }) -
+                        other.records;
+        cursor = cursor ? cursor - 1 : 0;
+
+        for (size_t i = first; i < last; i++) {
+            const GazeRecordingRecord& sample = self.records[i];
+            const double time = sample.timeInSeconds + shift;
+            while (cursor + 1 < other.count && other.records[cursor + 1].timeInSeconds <= time) {
+                cursor++;
+            }
+            size_t nearest = cursor;
+            if (cursor + 1 < other.count && std::abs(other.records[cursor + 1].timeInSeconds - time) <
+                                                std::abs(other.records[cursor].timeInSeconds - time)) {
+                nearest = cursor + 1;
+            }
+            const GazeRecordingRecord& match = other.records[nearest];
+            if (std::abs(match.timeInSeconds - time) > tolerance) {
+                statistics.unmatched++;
+                continue;
+            }
+            if (!compare) {
+                continue;
+            }
+
+            statistics.matched++;
+            const bool isValid = IsValid(sample);
+            const bool isMatchValid = IsValid(match);
+            if (isValid && isMatchValid) {
+                statistics.bothValid++;
+                for (int eye = 0; eye < 3; eye++) {
+                    float a[3], b[3];
+                    GetDirection(sample, eye, a);
+                    GetDirection(match, eye, b);
+                    statistics.angles[eye].Add(GetAngle(a, b));
+                }
+            } else if (isValid) {
+                statistics.onlyThisValid++;
+            } else if (isMatchValid) {
+                statistics.onlyOtherValid++;
+            } else {
+                statistics.bothInvalid++;
+            }
+        }
+        return statistics;
+    }
+
+    // Dropouts among the samples [first, last). An invalid sample lasts until the next sample.
+    DropoutStatistics GetDropouts(const Recording& recording, size_t first, size_t last) {
+        DropoutStatistics statistics;
+        for (size_t i = first; i < last; i++) {
+            const GazeRecordingRecord& sample = recording.records[i];
+            if (IsValid(sample)) {
+                continue;
+            }
+            statistics.invalid++;
+            if (!i || IsValid(recording.records[i - 1])) {
+                statistics.episodes++;
+            }
+            if (i + 1 < recording.count) {
+                statistics.invalidTime += recording.records[i + 1].timeInSeconds - sample.timeInSeconds;
+            }
+        }
+        return statistics;
+    }
+
+    // A signal resampled on a regular grid, with holes where the gaze was not tracked.
+    struct GridSignal {
+        static constexpr double k_Step = 0.001;
+
+        // Gaps between valid samples longer than this are left as holes rather than interpolated.
+        static constexpr double k_MaxGap = 0.05;
+
+        double startTime;
+        std::vector<float> values[2]; // Yaw, pitch.
+        std::vector<uint8_t> present;
+    };
+
+    // Resample the gaze angles of the recording over [startTime, endTime), by linear interpolation between valid
+    // samples, then differentiate, since the velocities have a much sharper correlation peak than the positions.
+    GridSignal Resample(const Recording& recording, double startTime, double endTime) {
+        GridSignal signal;
+        signal.startTime = startTime;
+        const size_t size = (size_t)((endTime - startTime) / GridSignal::k_Step);
+        for (auto& values : signal.values) {
+            values.assign(size, 0.f);
+        }
+        signal.present.assign(size, 0);
+
+        const GazeRecordingRecord* const end = recording.records + recording.count;
+        const GazeRecordingRecord* current = std::lower_bound(recording.records,
+                                                              end,
+                                                              startTime - GridSignal::k_MaxGap,
+                                                              [](const GazeRecordingRecord& record, double time) {
+                                                                  return record.timeInSeconds < time;
+                                                              });
+        const GazeRecordingRecord* previous = nullptr;
+        for (; current != end && current->timeInSeconds < endTime + GridSignal::k_MaxGap; current++) {
+            if (!IsValid(*current)) {
+                continue;
+            }
+            if (previous && current->timeInSeconds - previous->timeInSeconds <= GridSignal::k_MaxGap) {
+                const double t0 = previous->timeInSeconds;
+                const double t1 = current->timeInSeconds;
+                const float from[2] = {GetYaw(*previous), GetPitch(*previous)};
+                const float to[2] = {GetYaw(*current), GetPitch(*current)};
+                const size_t firstIndex = (size_t)std::max(std::ceil((t0 - startTime) / GridSignal::k_Step), 0.0);
+                for (size_t index = firstIndex; index < size; index++) {
+                    const double time = startTime + index * GridSignal::k_Step;
+                    if (time > t1) {
+                        break;
+                    }
+                    const float weight = t1 > t0 ? (float)((time - t0) / (t1 - t0)) : 0.f;
+                    for (int channel = 0; channel < 2; channel++) {
+                        signal.values[channel][index] = from[channel] + (to[channel] - from[channel]) * weight;
+                    }
+                    signal.present[index] = 1;
+                }
+            }
+            previous = current;
+        }
+
+        for (size_t index = 0; index + 1 < size; index++) {
+            for (auto& values : signal.values) {
+                values[index] = values[index + 1] - values[index];
+            }
+            signal.present[index] = signal.present[index] && signal.present[index + 1];
+        }
+        if (size) {
+            signal.present[size - 1] = 0;
+        }
+        return signal;
+    }
+
+    struct LagEstimate {
+        double lag = 0.0;
+        double correlation = 0.0;
+    };
+
+    // Lag of b relative to a (b(t + lag) ~ a(t)) maximizing the correlation of the gaze velocities within
+    // [startTime, endTime), searched within +/- maxLag at the resolution of the grid, refined with a parabola.
+    LagEstimate EstimateLag(const Recording& a, const Recording& b, double startTime, double endTime, double maxLag) {
+        const GridSignal signalA = Resample(a, startTime, endTime);
+        const GridSignal signalB = Resample(b, startTime - maxLag, endTime + maxLag);
+        const int maxOffset = (int)std::lround(maxLag / GridSignal::k_Step);
+        const size_t size = signalA.present.size();
+
+        // Pearson correlation over the grid points present in both signals, for both channels at once.
+        const auto correlate = [&](int offset) {
+            const size_t shiftB = maxOffset + offset;
+            double n = 0.0, sumA = 0.0, sumB = 0.0, sumAA = 0.0, sumBB = 0.0, sumAB = 0.0;
+            for (size_t index = 0; index < size; index++) {
+                if (!signalA.present[index] || !signalB.present[index + shiftB]) {
+                    continue;
+                }
+                for (int channel = 0; channel < 2; channel++) {
+                    const double valueA = signalA.values[channel][index];
+                    const double valueB = signalB.values[channel][index + shiftB];
+                    n++;
+                    sumA += valueA;
+                    sumB += valueB;
+                    sumAA += valueA * valueA;
+                    sumBB += valueB * valueB;
+                    sumAB += valueA * valueB;
+                }
+            }
+            const double varianceA = sumAA - sumA * sumA / std::max(n, 1.0);
+            const double varianceB = sumBB - sumB * sumB / std::max(n, 1.0);
+            return n > 100 && varianceA > 0.0 && varianceB > 0.0
+                       ? (sumAB - sumA * sumB / n) / std::sqrt(varianceA * varianceB)
+                       : -1.0;
+        };
+
+        // The peak of the velocities is several grid steps wide (a saccade lasts tens of milliseconds): search on a
+        // coarse grid first, then at full resolution around the best coarse lag.
+        constexpr int k_CoarseStep = 4;
+        std::vector<double> correlations(2 * maxOffset + 1, -1.0);
+        int coarseBest = 0;
+        for (int offset = -maxOffset; offset <= maxOffset; offset += k_CoarseStep) {
+            correlations[offset + maxOffset] = correlate(offset);
+            if (correlations[offset + maxOffset] > correlations[coarseBest + maxOffset]) {
+                coarseBest = offset;
+            }
+        }
+        for (int offset = std::max(coarseBest - k_CoarseStep - 1, -maxOffset);
+             offset <= std::min(coarseBest + k_CoarseStep + 1, maxOffset);
+             offset++) {
+            if ((offset + maxOffset) % k_CoarseStep) {
+                correlations[offset + maxOffset] = correlate(offset);
+            }
+        }
+
+        const size_t best = std::max_element(correlations.begin(), correlations.end()) - correlations.begin();
+        LagEstimate estimate;
+        estimate.correlation = correlations[best];
+        double refinement = 0.0;
+        if (best > 0 && best + 1 < correlations.size()) {
+            const double left = correlations[best - 1], center = correlations[best], right = correlations[best + 1];
+            const double curvature = left - 2.0 * center + right;
+            if (curvature < 0.0) {
+                refinement = 0.5 * (left - right) / curvature;
+            }
+        }
+        estimate.lag = ((double)best - maxOffset + refinement) * GridSignal::k_Step;
+        return estimate;
+    }
+
+    // Estimate the lag over windows spread across the overlap of the recordings, and keep the median of the windows
+    // that correlate well, which is robust to stretches without eye movements.
+    LagEstimate EstimateLatency(const Recording& a, const Recording& b, const Options& options, size_t& windowsUsed) {
+        constexpr double k_WindowSize = 10.0;
+        constexpr size_t k_MaxWindows = 64;
+        constexpr double k_MinCorrelation = 0.5;
+
+        windowsUsed = 0;
+        const double startTime = std::max(a.records[0].timeInSeconds, b.records[0].timeInSeconds);
+        const double endTime =
+            std::min(a.records[a.count - 1].timeInSeconds, b.records[b.count - 1].timeInSeconds);
+        if (endTime - startTime < 1.0) {
+            return {};
+        }
+
+        const size_t windowCount =
+            std::clamp((size_t)((endTime - startTime) / k_WindowSize), (size_t)1, k_MaxWindows);
+        const double windowSize = std::min(k_WindowSize, endTime - startTime);
+        const double spacing = windowCount > 1 ? (endTime - startTime - windowSize) / (windowCount - 1) : 0.0;
+        std::vector<LagEstimate> estimates(windowCount);
+        ParallelFor(windowCount, options.threads, [&](size_t index) {
+            const double windowStart = startTime + index * spacing;
+            estimates[index] = EstimateLag(a, b, windowStart, windowStart + windowSize, options.maxLag);
+        });
+
+        std::vector<LagEstimate> good;
+        std::copy_if(estimates.begin(), estimates.end(), std::back_inserter(good), [&](const LagEstimate& estimate) {
+            return estimate.correlation >= k_MinCorrelation;
+        });
+        if (good.empty()) {
+            return {};
+        }
+        windowsUsed = good.size();
+        const auto byLag = [](const LagEstimate& x, const LagEstimate& y) { return x.lag < y.lag; };
+        std::nth_element(good.begin(), good.begin() + good.size() / 2, good.end(), byLag);
+        return good[good.size() / 2];
+    }
+
+    void PrintDistribution(const char* name, const Histogram& histogram) {
+        if (!histogram.count) {
+            printf("  %-9s n/a\n", name);
+            return;
+        }
+        printf("  %-9s mean %.3f  p50 %.2f  p90 %.2f  p95 %.2f  p99 %.2f  max %.3f\n",
+               name,
+               histogram.sum / histogram.count,
+               histogram.GetPercentile(50),
+               histogram.GetPercentile(90),
+               histogram.GetPercentile(95),
+               histogram.GetPercentile(99),
+               histogram.max);
+    }
+
+    bool ParseOptions(int argc, char** argv, Options& options) {
+        int pathCount = 0;
+        for (int i = 1; i < argc; i++) {
+            const std::string argument = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (argument == "--tolerance" && hasValue) {
+                options.tolerance = atof(argv[++i]) / 1000.0;
+            } else if (argument == "--max-lag" && hasValue) {
+                options.maxLag = atof(argv[++i]) / 1000.0;
+            } else if (argument == "--threads" && hasValue) {
+                options.threads = std::max(atoi(argv[++i]), 1);
+            } else if (argument == "--no-align") {
+                options.align = false;
+            } else if (argument.rfind("--", 0) != 0 && pathCount < 2) {
+                options.paths[pathCount++] = argument;
+            } else {
+                return false;
+            }
+        }
+        return pathCount == 2 && options.tolerance > 0.0 && options.maxLag > 0.0;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        fprintf(stderr,
+                "Usage: %s <a.bin> <b.bin> [--tolerance <ms>] [--max-lag <ms>] [--threads <n>] [--no-align]\n",
+                argv[0]);
+        return 2;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    MappedGazeRecording files[2];
+    Recording recordings[2];
+    for (int i = 0; i < 2; i++) {
+        if (!files[i].Open(options.paths[i]) || !files[i].GetCount()) {
+            fprintf(stderr, "Failed to open recording or empty recording: %s\n", options.paths[i].c_str());
+            return 1;
+        }
+        recordings[i] = {files[i].GetRecords(), files[i].GetCount()};
+    }
+    const Recording& a = recordings[0];
+    const Recording& b = recordings[1];
+
+    size_t windowsUsed = 0;
+    const LagEstimate latency = EstimateLatency(a, b, options, windowsUsed);
+    const double shift = options.align ? latency.lag : 0.0;
+
+    // Join each recording against the other, in parallel over ranges of samples.
+    JoinStatistics joins[2];
+    DropoutStatistics dropouts[2];
+    for (int i = 0; i < 2; i++) {
+        const Recording& self = recordings[i];
+        const Recording& other = recordings[1 - i];
+        const auto ranges = MakeRanges(self.count, options.threads);
+        std::vector<JoinStatistics> partialJoins(ranges.size());
+        std::vector<DropoutStatistics> partialDropouts(ranges.size());
+        ParallelFor(ranges.size(), options.threads, [&](size_t index) {
+            const auto [first, last] = ranges[index];
+            // The pairs are compared from A, the join from B only counts its samples without a match.
+            partialJoins[index] = Join(self, first, last, other, i == 0 ? shift : -shift, options.tolerance, i == 0);
+            partialDropouts[index] = GetDropouts(self, first, last);
+        });
+        for (size_t index = 0; index < ranges.size(); index++) {
+            joins[i].Merge(partialJoins[index]);
+            dropouts[i].Merge(partialDropouts[index]);
+        }
+    }
+
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const double totalBytes = (double)(a.count + b.count) * sizeof(GazeRecordingRecord);
+
+    for (int i = 0; i < 2; i++) {
+        const Recording& recording = recordings[i];
+        const double duration =
+            recording.records[recording.count - 1].timeInSeconds - recording.records[0].timeInSeconds;
+        printf("%c: %s\n   %zu samples over %.1f s, %.2f%% invalid, %llu dropouts totalling %.2f s\n",
+               'A' + i,
+               options.paths[i].c_str(),
+               recording.count,
+               duration,
+               100.0 * dropouts[i].invalid / recording.count,
+               (unsigned long long)dropouts[i].episodes,
+               dropouts[i].invalidTime);
+    }
+
+    if (windowsUsed) {
+        printf("Latency: B lags A by %.2f ms (median of %zu windows, correlation %.3f)%s\n",
+               latency.lag * 1000.0,
+               windowsUsed,
+               latency.correlation,
+               options.align ? ", compensated below" : "");
+    } else {
+        printf("Latency: not enough eye movements in common to estimate\n");
+    }
+
+    const JoinStatistics& join = joins[0];
+    printf("Matched within %.2f ms: %llu pairs, %llu samples of A and %llu of B without a match\n",
+           options.tolerance * 1000.0,
+           (unsigned long long)join.matched,
+           (unsigned long long)join.unmatched,
+           (unsigned long long)joins[1].unmatched);
+    printf("Validity of the pairs: both %llu, only A %llu, only B %llu, neither %llu\n",
+           (unsigned long long)join.bothValid,
+           (unsigned long long)join.onlyThisValid,
+           (unsigned long long)join.onlyOtherValid,
+           (unsigned long long)join.bothInvalid);
+    printf("Angular difference (degrees):\n");
+    PrintDistribution("left", join.angles[0]);
+    PrintDistribution("right", join.angles[1]);
+    PrintDistribution("combined", join.angles[2]);
+    printf("Processed %.1f MB in %.2f s (%.0f MB/s) with %u threads\n",
+           totalBytes / 1e6,
+           elapsed,
+           totalBytes / 1e6 / elapsed,
+           options.threads);
+
+    return 0;
+}
@@ -0,0 +1,234 @@
+// MIT License
+//
+// Copyright(c) 2025 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Measure the build, refit and ray queries of the bounding volume hierarchy over a scene proxy (see GazeSceneProxy.h)
+// against testing every primitive, for 1000 to 1000000 boxes and triangles scattered around the viewer. Both must find
+// the same hits.
+//
+// Usage: scene_bvh_bench [--queries <n>]
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "SceneBvh.h"
+
+namespace {
+
+    using namespace eyetracking_core;
+
+    constexpr float k_MaxDistance = 100.f;
+
+    double Now() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // The more primitives, the smaller they are, so that the scene is about as dense whatever the count.
+    std::vector<GazeScenePrimitive> MakeScene(size_t count, std::mt19937& random) {
+        std::uniform_real_distribution<float> positionDistribution(-20.f, 20.f);
+        const float maxSize = std::clamp(20.f / std::cbrt((float)count), 0.01f, 2.f);
+        std::uniform_real_distribution<float> sizeDistribution(maxSize / 10.f, maxSize);
+        std::uniform_real_distribution<float> offsetDistribution(-maxSize, maxSize);
+        std::vector<GazeScenePrimitive> primitives(count);
+        for (size_t i = 0; i < count; i++) {
+            GazeScenePrimitive& primitive = primitives[i];
+            primitive = {};
+            primitive.id = (uint32_t)i;
+            primitive.type = i % 2 ? GazeScenePrimitive_Triangle : GazeScenePrimitive_Box;
+            float center[3];
+            for (float& value : center) {
+                value = positionDistribution(random);
+            }
+            if (primitive.type == GazeScenePrimitive_Box) {
+                for (int axis = 0; axis < 3; axis++) {
+                    const float halfSize = sizeDistribution(random);
+                    primitive.data[axis] = center[axis] - halfSize;
+                    primitive.data[3 + axis] = center[axis] + halfSize;
+                }
+            } else {
+                for (int j = 0; j < 9; j++) {
+                    primitive.data[j] = center[j % 3] + offsetDistribution(random);
+                }
+            }
+        }
+        return primitives;
+    }
+
+    // Straightforward reference intersections, written independently of the ones in SceneBvh.cpp.
+    float IntersectBox(const float* data, const float origin[3], const float direction[3]) {
+        float tNear = 0.f, tFar = k_MaxDistance;
+        for (int axis = 0; axis < 3; axis++) {
+            if (direction[axis] == 0.f) {
+                if (origin[axis] < data[axis] || origin[axis] > data[3 + axis]) {
+                    return FLT_MAX;
+                }
+                continue;
+            }
+            const float t0 = (data[axis] - origin[axis]) / direction[axis];
+            const float t1 = (data[3 + axis] - origin[axis]) / direction[axis];
+            tNear = std::max(tNear, std::min(t0, t1));
+            tFar = std::min(tFar, std::max(t0, t1));
+        }
+        return tNear <= tFar ? tNear : FLT_MAX;
+    }
+
+    float IntersectTriangle(const float* v, const float origin[3], const float direction[3]) {
+        const auto subtract = [](const float* a, const float* b, float* result) {
+            for (int i = 0; i < 3; i++) {
+                result[i] = a[i] - b[i];
+            }
+        };
+        const auto cross = [](const float* a, const float* b, float* result) {
+            result[0] = a[1] * b[2] - a[2] * b[1];
+            result[1] = a[2] * b[0] - a[0] * b[2];
+            result[2] = a[0] * b[1] - a[1] * b[0];
+        };
+        const auto dot = [](const float* a, const float* b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; };
+
+        float e1[3], e2[3], s[3], p[3], q[3];
+        subtract(v + 3, v, e1);
+        subtract(v + 6, v, e2);
+        subtract(origin, v, s);
+        cross(direction, e2, p);
+        const float determinant = dot(e1, p);
+        if (std::abs(determinant) < 1e-12f) {
+            return FLT_MAX;
+        }
+        cross(s, e1, q);
+        const float u = dot(s, p) / determinant;
+        const float w = dot(direction, q) / determinant;
+        const float t = dot(e2, q) / determinant;
+        return u >= 0.f && w >= 0.f && u + w <= 1.f && t >= 0.f && t <= k_MaxDistance ? t : FLT_MAX;
+    }
+
+    SceneBvh::Hit IntersectAll(const std::vector<GazeScenePrimitive>& primitives,
+                               const float origin[3],
+                               const float direction[3]) {
+        SceneBvh::Hit hit;
+        float closest = FLT_MAX;
+        for (const GazeScenePrimitive& primitive : primitives) {
+            const float distance = primitive.type == GazeScenePrimitive_Box
+                                       ? IntersectBox(primitive.data, origin, direction)
+                                       : IntersectTriangle(primitive.data, origin, direction);
+            if (distance < closest) {
+                closest = distance;
+                hit.objectId = primitive.id;
+                hit.distance = distance;
+            }
+        }
+        return hit;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t queries = 1000000;
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+        if (argument == "--queries" && i + 1 < argc) {
+            queries = (size_t)std::max(atoll(argv[++i]), 1ll);
+        } else {
+            fprintf(stderr, "Usage: %s [--queries <n>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    // Rays from around the head, in every direction.
+    std::mt19937 random(1234);
+    std::normal_distribution<float> directionDistribution;
+    std::uniform_real_distribution<float> originDistribution(-0.5f, 0.5f);
+    std::vector<float> rays(queries * 6);
+    for (size_t i = 0; i < queries; i++) {
+        for (int axis = 0; axis < 3; axis++) {
+            rays[i * 6 + axis] = originDistribution(random);
+            rays[i * 6 + 3 + axis] = directionDistribution(random);
+        }
+    }
+
+    printf("primitives  nodes     build (ms)  refit (ms)  bvh (ns)  linear (ns)  hit rate\n");
+    bool success = true;
+    for (size_t count : {1000, 10000, 100000, 1000000}) {
+        std::vector<GazeScenePrimitive> primitives = MakeScene(count, random);
+
+        double start = Now();
+        SceneBvh bvh(primitives);
+        const double buildTime = Now() - start;
+
+        // Move everything a bit, like an animated scene.
+        for (GazeScenePrimitive& primitive : primitives) {
+            for (float& value : primitive.data) {
+                value += 0.01f;
+            }
+        }
+        start = Now();
+        bvh.Refit(primitives);
+        const double refitTime = Now() - start;
+
+        uint64_t hits = 0;
+        start = Now();
+        for (size_t i = 0; i < queries; i++) {
+            hits += bvh.Intersect(&rays[i * 6], &rays[i * 6 + 3], k_MaxDistance).objectId != k_GazeSceneNoHit;
+        }
+        const double bvhTime = (Now() - start) / queries;
+
+        // The linear scan is slow with many primitives: only run it on enough rays to be measured.
+        const size_t linearQueries = std::min(queries, std::max((size_t)100, (size_t)20000000 / count));
+        size_t mismatches = 0;
+        start = Now();
+        std::vector<SceneBvh::Hit> linearHits(linearQueries);
+        for (size_t i = 0; i < linearQueries; i++) {
+            linearHits[i] = IntersectAll(primitives, &rays[i * 6], &rays[i * 6 + 3]);
+        }
+        const double linearTime = (Now() - start) / linearQueries;
+        for (size_t i = 0; i < linearQueries; i++) {
+            const SceneBvh::Hit hit = bvh.Intersect(&rays[i * 6], &rays[i * 6 + 3], k_MaxDistance);
+            // Primitives at the same distance (eg: the ray enters where two overlap) may be reported either way.
+            if ((hit.objectId == k_GazeSceneNoHit) != (linearHits[i].objectId == k_GazeSceneNoHit) ||
+                std::abs(hit.distance - linearHits[i].distance) > 1e-4f * std::max(hit.distance, 1.f)) {
+                mismatches++;
+            }
+        }
+        if (mismatches) {
+            printf("Mismatch with %zu primitives: %zu of %zu rays hit differently than by testing every primitive\n",
+                   count,
+                   mismatches,
+                   linearQueries);
+            success = false;
+        }
+
+        printf("%10zu  %8zu  %10.2f  %10.2f  %8.1f  %11.1f  %8.2f\n",
+               count,
+               bvh.GetNodeCount(),
+               buildTime * 1e3,
+               refitTime * 1e3,
+               bvhTime * 1e9,
+               linearTime * 1e9,
+               (double)hits / queries);
+    }
+    return success ? 0 : 1;
+}